@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -82,6 +83,9 @@ namespace SKIRNIR_NAMESPACE
     template <typename TDest, typename TSource>
     struct ArcCastAccess;
 
+    template <typename T>
+    class AtomicArc;
+
     template <typename T>
     class Arc
     {
@@ -191,6 +195,9 @@ namespace SKIRNIR_NAMESPACE
         template <typename TDest, typename TSource>
         friend struct ArcCastAccess;
 
+        template <typename>
+        friend class AtomicArc;
+
         T*                       mPtr  = nullptr;
         detail::ArcControlBlock* mCtrl = nullptr;
     };
@@ -366,6 +373,95 @@ namespace SKIRNIR_NAMESPACE
         return ArcCastAccess<TDest, TSource>::cast(source);
     }
 
+    /**
+     * @brief An @c Arc slot that readers can load while another thread
+     *        replaces it.
+     *
+     *  The low bit of the stored control-block pointer is a spin lock,
+     *  held only long enough for a reader to take its strong reference or
+     *  for a writer to swap the pointer. The previous value is released
+     *  after the lock is dropped, so a destructor never runs under it.
+     */
+    template <typename T>
+    class AtomicArc
+    {
+      public:
+        constexpr AtomicArc() noexcept = default;
+
+        explicit AtomicArc(Arc<T> value) noexcept { store(std::move(value)); }
+
+        AtomicArc(const AtomicArc&)            = delete;
+        AtomicArc& operator=(const AtomicArc&) = delete;
+
+        ~AtomicArc()
+        {
+            // Adopts the held reference so it is released with @c owned.
+            Arc<T> owned(mPtr, Unlocked(mWord.load(std::memory_order_acquire)));
+        }
+
+        Arc<T> load() const noexcept
+        {
+            detail::ArcControlBlock* ctrl = Lock();
+            T*                       ptr  = mPtr;
+            if (ctrl)
+                ctrl->increment_strong();
+            Unlock(ctrl);
+            return Arc<T>(ptr, ctrl);
+        }
+
+        void store(Arc<T> value) noexcept { exchange(std::move(value)); }
+
+        Arc<T> exchange(Arc<T> value) noexcept
+        {
+            detail::ArcControlBlock* previous = Lock();
+            T*                       ptr      = mPtr;
+            mPtr                              = value.mPtr;
+            Unlock(value.mCtrl);
+            value.mPtr  = nullptr;
+            value.mCtrl = nullptr;
+            return Arc<T>(ptr, previous);
+        }
+
+      private:
+        static constexpr std::uintptr_t LockBit = 1;
+
+        static detail::ArcControlBlock* Unlocked(std::uintptr_t word) noexcept
+        {
+            return reinterpret_cast<detail::ArcControlBlock*>(word &
+                                                              ~LockBit);
+        }
+
+        detail::ArcControlBlock* Lock() const noexcept
+        {
+            std::uintptr_t word = mWord.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                if (word & LockBit)
+                {
+                    std::this_thread::yield();
+                    word = mWord.load(std::memory_order_relaxed);
+                }
+                else if (mWord.compare_exchange_weak(
+                             word, word | LockBit,
+                             std::memory_order_acquire,
+                             std::memory_order_relaxed))
+                {
+                    return Unlocked(word);
+                }
+            }
+        }
+
+        void Unlock(detail::ArcControlBlock* ctrl) const noexcept
+        {
+            mWord.store(reinterpret_cast<std::uintptr_t>(ctrl),
+                        std::memory_order_release);
+        }
+
+        // Control block of the held value, plus @c LockBit while locked.
+        mutable std::atomic<std::uintptr_t> mWord {0};
+        T*                                  mPtr = nullptr;
+    };
+
     template <typename T>
     class WeakArc
     {
@@ -8,4 +8,6 @@
 #include "Configuration/InMemorySource.hpp"
 #include "Configuration/JsonObjectReader.hpp"
 #include "Configuration/ConfigurationOptions.hpp"
+#include "Configuration/ConfigurationMonitor.hpp"
 #include "Configuration/ConfigurationBuilder.hpp"
+#include "Configuration/Options.hpp"
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <meta>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Skirnir/Configuration/Aliases.hpp"
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    template <typename T>
+    bool BindValue(T& field, simdjson::dom::element el);
+
+    // --- Compile-time perfect hash over member names ------------------------
+
+    constexpr std::uint64_t HashFieldName(std::string_view name)
+    {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : name)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    constexpr std::uint64_t MixFieldHash(std::uint64_t h, std::uint32_t seed)
+    {
+        h += static_cast<std::uint64_t>(seed) * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 31;
+        h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 29;
+        return h;
+    }
+
+    /**
+     * @brief Hash-and-displace table mapping the @p N member names of a
+     *        struct to their index.
+     *
+     *  A key is hashed once; its bucket's displacement picks the slot, and
+     *  a single string compare confirms the hit. Unknown keys return @p N.
+     */
+    template <std::size_t N>
+    struct FieldHash
+    {
+        static constexpr std::size_t Buckets = N > 0 ? N : 1;
+        static constexpr std::size_t Slots   = std::bit_ceil(2 * Buckets);
+
+        std::array<std::uint32_t, Buckets> displacement {};
+        std::array<std::uint32_t, Slots>   field {};
+
+        constexpr std::size_t Find(
+            std::string_view                        key,
+            const std::array<std::string_view, N>& names) const
+        {
+            const std::uint64_t h = HashFieldName(key);
+            const std::size_t   slot =
+                MixFieldHash(h, displacement[h % Buckets]) & (Slots - 1);
+            const std::size_t i = field[slot];
+            return i < N && names[i] == key ? i : N;
+        }
+    };
+
+    template <std::size_t N>
+    consteval FieldHash<N> MakeFieldHash(
+        const std::array<std::string_view, N>& names)
+    {
+        using Table                 = FieldHash<N>;
+        constexpr std::size_t Empty = N;
+        Table                 table;
+        table.field.fill(static_cast<std::uint32_t>(Empty));
+
+        std::vector<std::vector<std::size_t>> buckets(Table::Buckets);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (!names[i].empty())
+                buckets[HashFieldName(names[i]) % Table::Buckets].push_back(i);
+        }
+
+        // Place the most crowded buckets first, while the table is empty.
+        std::vector<std::size_t> order(Table::Buckets);
+        std::iota(order.begin(), order.end(), std::size_t {0});
+        std::sort(order.begin(), order.end(),
+                  [&](std::size_t a, std::size_t b) {
+                      return buckets[a].size() > buckets[b].size();
+                  });
+
+        for (std::size_t b : order)
+        {
+            const auto& members = buckets[b];
+            if (members.empty())
+                break;
+            for (std::uint32_t seed = 0;; ++seed)
+            {
+                // No displacement fits: two names hash identically.
+                if (seed == 0xffff'ffffu)
+                    std::abort();
+
+                std::vector<std::size_t> taken;
+                for (std::size_t i : members)
+                {
+                    const std::size_t slot =
+                        MixFieldHash(HashFieldName(names[i]), seed) &
+                        (Table::Slots - 1);
+                    if (table.field[slot] != Empty ||
+                        std::find(taken.begin(), taken.end(), slot) !=
+                            taken.end())
+                        break;
+                    taken.push_back(slot);
+                }
+                if (taken.size() != members.size())
+                    continue;
+
+                for (std::size_t k = 0; k < members.size(); ++k)
+                    table.field[taken[k]] =
+                        static_cast<std::uint32_t>(members[k]);
+                table.displacement[b] = seed;
+                break;
+            }
+        }
+        return table;
+    }
+
+    // --- Per-type member tables ---------------------------------------------
+
+    template <typename T>
+    inline constexpr auto BindMembers = std::define_static_array(
+        std::meta::nonstatic_data_members_of(
+            ^^T, std::meta::access_context::current()));
+
+    template <typename T>
+    inline constexpr auto BindMemberNames = []() consteval {
+        std::array<std::string_view, BindMembers<T>.size()> names {};
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            if (std::meta::has_identifier(BindMembers<T>[i]))
+                names[i] = std::meta::identifier_of(BindMembers<T>[i]);
+        }
+        return names;
+    }();
+
+    template <typename T>
+    inline constexpr auto BindMemberHash = MakeFieldHash(BindMemberNames<T>);
+
+    template <typename T, std::size_t I>
+    bool BindMember(T& obj, simdjson::dom::element el)
+    {
+        return BindValue(obj.[:BindMembers<T>[I]:], el);
+    }
+
+    template <typename T>
+    inline constexpr auto BindMemberSetters =
+        []<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<bool (*)(T&, simdjson::dom::element),
+                              sizeof...(I)> {&BindMember<T, I>...};
+        }(std::make_index_sequence<BindMembers<T>.size()> {});
+
+    /**
+     * @brief Binds the members of @p obj into the fields of @p out.
+     *
+     *  The object is walked once and each key is dispatched to its field
+     *  through @c BindMemberHash. Unknown keys are ignored; when a key
+     *  repeats, its first occurrence is used. Fields without a matching
+     *  key, or whose value does not convert, are left untouched.
+     */
+    template <typename T>
+    void BindObject(T& out, simdjson::dom::object obj)
+    {
+        constexpr std::size_t N = BindMembers<T>.size();
+        std::bitset<N>        seen;
+        for (auto kv : obj)
+        {
+            const std::size_t i =
+                BindMemberHash<T>.Find(kv.key, BindMemberNames<T>);
+            if (i == N || seen[i])
+                continue;
+            seen[i] = true;
+            BindMemberSetters<T>[i](out, kv.value);
+        }
+    }
+
+    // --- Value conversion ---------------------------------------------------
+
+    template <typename T>
+    struct IsBindVector : std::false_type
+    {
+    };
+
+    template <typename T, typename Alloc>
+    struct IsBindVector<std::vector<T, Alloc>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct IsBindMap : std::false_type
+    {
+    };
+
+    template <typename T, typename Compare, typename Alloc>
+    struct IsBindMap<std::map<std::string, T, Compare, Alloc>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    struct IsBindOptional : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsBindOptional<std::optional<T>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief Converts @p el into @p field. Returns false, leaving @p field
+     *        untouched, if the JSON type does not fit.
+     *
+     *  Containers are built aside and assigned only once every element
+     *  converted. Nested structs are bound in place, so their fields keep
+     *  their current values for keys the object does not mention.
+     */
+    template <typename T>
+    bool BindValue(T& field, simdjson::dom::element el)
+    {
+        using U = std::remove_cvref_t<T>;
+
+        if constexpr (std::is_same_v<U, bool>)
+        {
+            bool v = false;
+            if (!el.is_bool() || el.get_bool().get(v) != simdjson::SUCCESS)
+                return false;
+            field = v;
+            return true;
+        }
+        else if constexpr (std::is_integral_v<U>)
+        {
+            if (el.is_int64())
+            {
+                int64_t v = 0;
+                if (el.get_int64().get(v) != simdjson::SUCCESS)
+                    return false;
+                field = static_cast<U>(v);
+                return true;
+            }
+            if (el.is_uint64())
+            {
+                uint64_t v = 0;
+                if (el.get_uint64().get(v) != simdjson::SUCCESS)
+                    return false;
+                field = static_cast<U>(v);
+                return true;
+            }
+            if (el.is_double())
+            {
+                double v = 0.0;
+                if (el.get_double().get(v) != simdjson::SUCCESS)
+                    return false;
+                field = static_cast<U>(v);
+                return true;
+            }
+            return false;
+        }
+        else if constexpr (std::is_floating_point_v<U>)
+        {
+            double v = 0.0;
+            if (!el.is_number() || el.get_double().get(v) != simdjson::SUCCESS)
+                return false;
+            field = static_cast<U>(v);
+            return true;
+        }
+        else if constexpr (std::is_same_v<U, std::string>)
+        {
+            std::string_view sv;
+            if (!el.is_string() || el.get_string().get(sv) != simdjson::SUCCESS)
+                return false;
+            field.assign(sv.data(), sv.size());
+            return true;
+        }
+        else if constexpr (IsBindOptional<U>::value)
+        {
+            if (el.is_null())
+            {
+                field.reset();
+                return true;
+            }
+            using V = typename U::value_type;
+            V v     = field ? *field : V {};
+            if (!BindValue(v, el))
+                return false;
+            field = std::move(v);
+            return true;
+        }
+        else if constexpr (IsBindVector<U>::value)
+        {
+            simdjson::dom::array arr;
+            if (!el.is_array() || el.get_array().get(arr) != simdjson::SUCCESS)
+                return false;
+            U items;
+            items.reserve(arr.size());
+            for (auto item : arr)
+            {
+                typename U::value_type v {};
+                if (!BindValue(v, item))
+                    return false;
+                items.push_back(std::move(v));
+            }
+            field = std::move(items);
+            return true;
+        }
+        else if constexpr (IsBindMap<U>::value)
+        {
+            simdjson::dom::object obj;
+            if (!el.is_object() ||
+                el.get_object().get(obj) != simdjson::SUCCESS)
+                return false;
+            U entries;
+            for (auto kv : obj)
+            {
+                typename U::mapped_type v {};
+                if (!BindValue(v, kv.value))
+                    return false;
+                std::string_view key = kv.key;
+                entries.try_emplace(std::string(key), std::move(v));
+            }
+            field = std::move(entries);
+            return true;
+        }
+        else if constexpr (std::is_class_v<U>)
+        {
+            simdjson::dom::object obj;
+            if (!el.is_object() ||
+                el.get_object().get(obj) != simdjson::SUCCESS)
+                return false;
+            BindObject(field, obj);
+            return true;
+        }
+        else
+        {
+            static_assert(sizeof(U) == 0,
+                          "Skirnir: unsupported configuration field type");
+            return false;
+        }
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Configuration/ConfigurationMonitor.hpp"
 #include "Skirnir/Configuration/IConfigurationSource.hpp"
+#include "Skirnir/Configuration/JsonFileSource.hpp"
 
 namespace SKIRNIR_NAMESPACE
 {
@@ -26,15 +28,44 @@ namespace SKIRNIR_NAMESPACE
         ConfigurationBuilder() = default;
 
         ConfigurationBuilder& AddJsonFile(const std::filesystem::path& path);
+        ConfigurationBuilder& AddJsonFile(const std::filesystem::path& path,
+                                          JsonFileSourceOptions        options);
         ConfigurationBuilder& AddJsonString(std::string_view json);
         ConfigurationBuilder& AddSource(Arc<IConfigurationSource> source);
         ConfigurationBuilder& AddInMemory(
             std::initializer_list<std::pair<std::string, std::string>> entries);
         ConfigurationBuilder& AddEnvironmentVariables(std::string prefix = {});
 
+        /**
+         * @brief Caches the merged configuration in a binary snapshot at
+         *        @p path, so later builds skip parsing and merging while
+         *        the sources stay the same.
+         *
+         * @c Build fingerprints every source (file size, modification
+         * time and content, JSON strings, in-memory entries, matching
+         * environment variables). If the snapshot was written for the
+         * same fingerprint, it is mapped and used in place: nothing is
+         * parsed or merged. Otherwise the configuration is built as usual
+         * and the snapshot rewritten. Sources that cannot be
+         * fingerprinted disable the cache; a snapshot that cannot be read
+         * or written is ignored.
+         */
+        ConfigurationBuilder& WithSnapshotCache(std::filesystem::path path);
+
         Arc<ConfigurationOptions> Build();
 
+        /**
+         * @brief Builds a @c ConfigurationMonitor over the sources added so
+         *        far, which reloads them as they change.
+         *
+         * The monitor takes over the sources; do not call @c Build on this
+         * builder afterwards.
+         */
+        Arc<ConfigurationMonitor> BuildMonitor(
+            ConfigurationMonitorOptions options = {});
+
       private:
         std::vector<Arc<IConfigurationSource>> mSources;
+        std::filesystem::path                  mSnapshotPath;
     };
 } // namespace SKIRNIR_NAMESPACE
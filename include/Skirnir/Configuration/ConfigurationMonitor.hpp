@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Configuration/IConfigurationSource.hpp"
+
+namespace SKIRNIR_NAMESPACE
+{
+    class ConfigurationOptions;
+
+    struct ConfigurationMonitorOptions
+    {
+        /**
+         * @brief Watch file-backed sources (inotify on Linux, polling
+         *        elsewhere) and reload them when they change.
+         */
+        bool watchFiles = true;
+
+        /**
+         * @brief Quiet period after the last event on a watched file
+         *        before the changed sources are reloaded, so a burst of
+         *        writes results in one reload. Other files in the same
+         *        directory do not extend it.
+         */
+        std::chrono::milliseconds debounce {100};
+
+        /**
+         * @brief Called on the watcher thread when an automatic reload
+         *        fails. The previous snapshot stays current.
+         */
+        std::function<void(const std::exception&)> onError;
+    };
+
+    /**
+     * @brief Keeps the current configuration of a set of sources and
+     *        publishes a new snapshot when they change.
+     *
+     * Each snapshot is an immutable @c ConfigurationOptions, swapped in
+     * atomically, so readers never see a half-applied reload. A reload
+     * re-reads only the sources that changed, merges every source's
+     * current tree and diffs the result against the previous snapshot;
+     * listeners are called only when a key path they subscribed to is
+     * among the changes.
+     *
+     * @code
+     * auto monitor = ConfigurationBuilder()
+     *                    .AddJsonFile("appsettings.json")
+     *                    .BuildMonitor();
+     * monitor->Subscribe("logging.logLevel", [&](const auto& config) {
+     *     loggerOptions->ConfigureFrom(config);
+     * });
+     * @endcode
+     */
+    class ConfigurationMonitor
+    {
+      public:
+        using Listener = std::function<void(const Arc<ConfigurationOptions>&)>;
+
+        /**
+         * @brief Builds the first snapshot from @p sources and, if asked
+         *        to, starts watching the file-backed ones.
+         *
+         * The monitor takes over the sources: it reloads them from its
+         * own thread, so they must not be loaded elsewhere afterwards.
+         *
+         * @throws std::runtime_error if a watched file's directory cannot
+         *         be watched, rather than leave it without reloads.
+         */
+        explicit ConfigurationMonitor(
+            std::vector<Arc<IConfigurationSource>> sources,
+            ConfigurationMonitorOptions            options = {});
+
+        ~ConfigurationMonitor();
+
+        ConfigurationMonitor(const ConfigurationMonitor&)            = delete;
+        ConfigurationMonitor& operator=(const ConfigurationMonitor&) = delete;
+
+        /** @brief The current snapshot. */
+        Arc<ConfigurationOptions> Current() const noexcept
+        {
+            return mCurrent.load();
+        }
+
+        /**
+         * @brief Reloads every source now and publishes the result if any
+         *        value changed.
+         *
+         * @return The dotted paths that changed; empty if nothing did.
+         * @throws std::runtime_error if a source fails to reload. That
+         *         source keeps its previous tree; changes from the other
+         *         sources are still published before the error is
+         *         thrown.
+         */
+        std::vector<std::string> Reload();
+
+        /**
+         * @brief Calls @p listener with each new snapshot in which a value
+         *        at, above or below @p key changed. An empty @p key
+         *        listens to every change.
+         *
+         * Listeners run on the reloading thread, one reload at a time,
+         * and must not call @c Reload themselves.
+         *
+         * @return A token for @c Unsubscribe.
+         */
+        std::size_t Subscribe(std::string key, Listener listener);
+
+        void Unsubscribe(std::size_t token);
+
+      private:
+        struct Watcher;
+
+        struct Subscription
+        {
+            std::size_t token;
+            std::string key;
+            Listener    listener;
+        };
+
+        std::vector<std::string> ReloadSources(
+            std::span<const std::size_t> indices);
+
+        // Merges the sources' current trees, and publishes and notifies
+        // if a value changed. Called with mReloadMutex held.
+        std::vector<std::string> Remerge();
+
+        std::vector<Arc<IConfigurationSource>> mSources;
+        ConfigurationMonitorOptions            mOptions;
+        AtomicArc<ConfigurationOptions>        mCurrent;
+
+        // Serializes reloads and the notifications that follow them.
+        std::mutex mReloadMutex;
+
+        std::mutex                mListenersMutex;
+        std::vector<Subscription> mListeners;
+        std::size_t               mLastToken = 0;
+
+        // Declared last so it is stopped before anything it uses.
+        std::unique_ptr<Watcher> mWatcher;
+    };
+} // namespace SKIRNIR_NAMESPACE
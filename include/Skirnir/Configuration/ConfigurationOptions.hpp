@@ -13,11 +13,18 @@ namespace SKIRNIR_NAMESPACE
 {
     class ConfigurationBuilder;
 
+    namespace detail
+    {
+        struct ConfigurationDocument;
+    }
+
     /**
      * @brief Strongly-typed view over a configuration tree.
      *
-     * Each instance owns the parser that backs its element, so a sub-section
-     * can outlive the configuration it was derived from.
+     * A configuration and the sections taken from it share ownership of one
+     * parsed document, so a sub-section can outlive the configuration it
+     * was derived from. Dotted key paths are resolved through an index
+     * built at construction, so lookups do not walk the tree.
      */
     class ConfigurationOptions
     {
@@ -55,14 +62,23 @@ namespace SKIRNIR_NAMESPACE
 
         /**
          * @brief Returns a sub-section as a new ConfigurationOptions that
-         *        owns its own parser.
+         *        shares this configuration's document.
+         *
+         * Nothing is copied or reparsed; the section keeps the whole
+         * document alive for as long as it exists.
          */
         Arc<ConfigurationOptions> GetSection(std::string_view key) const;
 
         /**
          * @brief Strongly-typed binding of a JSON sub-object into T.
          *
-         * T must be default-constructible
+         * T must be default-constructible. The object is walked once and
+         * each key is dispatched to its field through a perfect hash of
+         * T's member names generated at compile time. Supported field
+         * types are @c bool, integral and floating-point types,
+         * @c std::string, nested structs, @c std::vector and
+         * @c std::optional of any of these, and
+         * @c std::map<std::string, T>.
          */
         template <typename T>
         Arc<T> Bind(std::string_view section = "") const
@@ -70,36 +86,13 @@ namespace SKIRNIR_NAMESPACE
             auto                result = MakeArc<T>();
             ConfigurationObject obj;
 
-            if (section.empty())
-            {
-                if (!mElement.is_object())
-                    return result;
-                if (mElement.get_object().get(obj) != simdjson::SUCCESS)
-                    return result;
-            }
-            else
-            {
-                auto sub = Navigate(section);
-                if (!sub || !sub->is_object())
-                    return result;
-                if (sub->get_object().get(obj) != simdjson::SUCCESS)
-                    return result;
-            }
-
-            JsonObjectReader reader(obj);
-
-            template for (constexpr auto member : std::define_static_array(
-                              std::meta::nonstatic_data_members_of(
-                                  ^^T,
-                                  std::meta::access_context::current())))
-            {
-                constexpr auto name = std::meta::identifier_of(member);
-                if constexpr (name.size() > 0)
-                {
-                    reader.TryGet(name, result->[:member:]);
-                }
-            }
+            auto sub = Navigate(section);
+            if (!sub || !sub->is_object())
+                return result;
+            if (sub->get_object().get(obj) != simdjson::SUCCESS)
+                return result;
 
+            detail::BindObject(*result, obj);
             return result;
         }
 
@@ -132,21 +125,32 @@ namespace SKIRNIR_NAMESPACE
         /// @cond INTERNAL
       public:
         ConfigurationOptions(std::unique_ptr<simdjson::dom::parser> parser,
-                             simdjson::dom::element                 element) :
-            mParser(std::move(parser)), mElement(element)
-        {
-        }
+                             simdjson::dom::element                 element);
+
+        ConfigurationOptions(Arc<detail::ConfigurationDocument> document,
+                             simdjson::dom::element             element,
+                             std::string_view                   path,
+                             bool                               indexed);
         /// @endcond
 
       private:
-        std::unique_ptr<simdjson::dom::parser> mParser;
-        simdjson::dom::element                 mElement;
+        struct Located
+        {
+            simdjson::dom::element element;
+            std::string_view       path;    // valid when indexed
+            bool                   indexed; // path is in the document index
+        };
+
+        Arc<detail::ConfigurationDocument> mDocument;
+        simdjson::dom::element             mElement;
+        std::string_view                   mPath;
+        bool                               mIndexed = false;
+
+        std::optional<Located> Locate(std::string_view key) const;
 
         std::optional<simdjson::dom::element> Navigate(
             std::string_view key) const;
 
-        static std::vector<std::string_view> SplitKey(std::string_view key);
-
         static std::string Stringify(simdjson::dom::element el);
         static std::string StringifyRaw(simdjson::dom::element el);
 
@@ -28,6 +28,9 @@ namespace SKIRNIR_NAMESPACE
 
         simdjson::dom::element Load() override;
 
+        /** @brief Hashes every variable the source would load. */
+        bool Fingerprint(std::uint64_t& hash) const override;
+
       private:
         std::string            mPrefix;
         simdjson::dom::parser  mParser;
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+
 #include "Skirnir/Configuration/Aliases.hpp"
 
 namespace SKIRNIR_NAMESPACE
@@ -20,5 +23,34 @@ namespace SKIRNIR_NAMESPACE
          * more than once; subsequent calls should return the cached result.
          */
         virtual simdjson::dom::element Load() = 0;
+
+        /**
+         * @brief Re-reads the underlying data. Returns true if it changed,
+         *        in which case the next @c Load() returns the new tree.
+         *
+         * On failure the source throws and keeps its previous tree. Sources
+         * whose data cannot change keep the default, which returns false.
+         */
+        virtual bool Reload() { return false; }
+
+        /**
+         * @brief File whose changes should trigger @c Reload(), or an empty
+         *        path if the source is not file-backed.
+         */
+        virtual std::filesystem::path WatchedPath() const { return {}; }
+
+        /**
+         * @brief Mixes a fingerprint of the data @c Load() would return
+         *        into @p hash, for @c ConfigurationBuilder's snapshot
+         *        cache. Must be cheaper than loading.
+         *
+         * Returns false if the source cannot tell whether its data
+         * changed, which disables the cache; that is the default.
+         */
+        virtual bool Fingerprint(std::uint64_t& hash) const
+        {
+            (void)hash;
+            return false;
+        }
     };
 } // namespace SKIRNIR_NAMESPACE
@@ -41,6 +41,8 @@ namespace SKIRNIR_NAMESPACE
 
         simdjson::dom::element Load() override;
 
+        bool Fingerprint(std::uint64_t& hash) const override;
+
       private:
         std::map<std::string, std::string> mFlat;
         simdjson::dom::parser              mParser;
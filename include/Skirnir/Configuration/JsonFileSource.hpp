@@ -1,13 +1,51 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "Skirnir/Configuration/Aliases.hpp"
 #include "Skirnir/Configuration/IConfigurationSource.hpp"
 
 namespace SKIRNIR_NAMESPACE
 {
+    struct JsonFileSourceOptions
+    {
+        static constexpr std::int64_t DefaultMaxSize = 16 * 1024 * 1024;
+
+        /**
+         * @brief Largest accepted file in bytes. A negative value disables
+         *        the cap.
+         */
+        std::int64_t maxSize = DefaultMaxSize;
+
+        /**
+         * @brief Map the file into memory and parse it in place instead of
+         *        reading it into a buffer first (POSIX only; elsewhere the
+         *        file is read).
+         *
+         * The mapping lives only for the duration of the parse. The file
+         * must not be truncated in place while it is parsed, or the
+         * process receives @c SIGBUS; files replaced by renaming a new
+         * one over them, as editors and deployment tools do, are safe.
+         */
+        bool memoryMap = false;
+
+        /**
+         * @brief Dotted key paths to extract, e.g. @c "server.port".
+         *
+         * When set, the file is scanned with simdjson's On-Demand API and
+         * only these values, with everything below them, are
+         * materialized; the rest of the document is skipped rather than
+         * built into a tree. Keys missing from the file are ignored.
+         * Empty loads the whole document.
+         */
+        std::vector<std::string> keys;
+    };
+
     /**
      * @brief Parses configuration from a JSON file.
      *
@@ -18,19 +56,36 @@ namespace SKIRNIR_NAMESPACE
     class JsonFileSource final : public IConfigurationSource
     {
       public:
-        static constexpr std::int64_t DefaultMaxSize = 16 * 1024 * 1024;
+        static constexpr std::int64_t DefaultMaxSize =
+            JsonFileSourceOptions::DefaultMaxSize;
 
         explicit JsonFileSource(std::filesystem::path path,
                                 std::int64_t          maxSize = DefaultMaxSize);
 
+        JsonFileSource(std::filesystem::path path,
+                       JsonFileSourceOptions options);
+
         simdjson::dom::element Load() override;
 
+        /**
+         * @brief Reads the file again and reparses it if its content
+         *        changed. A file that fails to read or parse leaves the
+         *        previous tree in place.
+         */
+        bool Reload() override;
+
+        std::filesystem::path WatchedPath() const override { return mPath; }
+
+        /** @brief Hashes the file's size, modification time and content. */
+        bool Fingerprint(std::uint64_t& hash) const override;
+
       private:
-        std::filesystem::path  mPath;
-        std::int64_t           mMaxSize;
-        std::string            mContent;
-        simdjson::dom::parser  mParser;
-        simdjson::dom::element mElement;
-        bool                   mLoaded = false;
+        std::filesystem::path                  mPath;
+        JsonFileSourceOptions                  mOptions;
+        std::size_t                            mContentSize = 0;
+        std::size_t                            mContentHash = 0;
+        std::unique_ptr<simdjson::dom::parser> mParser;
+        simdjson::dom::element                 mElement;
+        bool                                   mLoaded = false;
     };
 } // namespace SKIRNIR_NAMESPACE
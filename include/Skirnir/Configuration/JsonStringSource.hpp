@@ -17,6 +17,8 @@ namespace SKIRNIR_NAMESPACE
 
         simdjson::dom::element Load() override;
 
+        bool Fingerprint(std::uint64_t& hash) const override;
+
       private:
         std::string            mContent;
         simdjson::dom::parser  mParser;
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Configuration/ConfigurationMonitor.hpp"
+#include "Skirnir/Configuration/ConfigurationOptions.hpp"
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Cached, immutable snapshot of a configuration section bound
+     *        into @p T.
+     *
+     * The section is bound once and every reader shares the result, so
+     * the request path neither walks the configuration nor converts
+     * values. @c Reload binds a new snapshot and publishes it atomically;
+     * readers holding the previous one keep it alive until they drop it.
+     *
+     * Register it with @c ServiceCollection::AddOptions and inject
+     * @c Arc<Options<T>>. When a @c ConfigurationMonitor is registered,
+     * the snapshot follows it: changes under the section are rebound and
+     * published as they are picked up.
+     *
+     * @code
+     * services.AddOptions<DatabaseOptions>("database");
+     * ...
+     * Arc<const DatabaseOptions> db = options->Value();
+     * @endcode
+     */
+    template <typename T>
+    class Options
+    {
+      public:
+        using Listener = std::function<void(const Arc<const T>&)>;
+
+        /** @brief Binds @p section of @p config into the first snapshot. */
+        explicit Options(const ConfigurationOptions& config,
+                         std::string                 section = "") :
+            mSection(std::move(section)),
+            mSnapshot(Arc<const T>(config.Bind<T>(mSection)))
+        {
+        }
+
+        /** @brief Starts from a ready-made @p snapshot, e.g. in tests. */
+        explicit Options(Arc<const T> snapshot) : mSnapshot(std::move(snapshot))
+        {
+        }
+
+        ~Options()
+        {
+            if (mMonitor)
+                mMonitor->Unsubscribe(mMonitorToken);
+        }
+
+        Options(const Options&)            = delete;
+        Options& operator=(const Options&) = delete;
+
+        /**
+         * @brief Creates the options for @p section from what @p provider
+         *        has registered: the current snapshot of a
+         *        @c ConfigurationMonitor, which it then follows, or else
+         *        the @c ConfigurationOptions singleton.
+         */
+        template <typename TProvider>
+        static Arc<Options> Resolve(TProvider& provider, std::string section)
+        {
+            auto monitor =
+                provider.template TryGetService<ConfigurationMonitor>();
+            if (!monitor)
+            {
+                auto config =
+                    provider.template GetService<ConfigurationOptions>();
+                return MakeArc<Options>(*config, std::move(section));
+            }
+
+            const Arc<ConfigurationMonitor>& source  = *monitor;
+            Arc<ConfigurationOptions>        initial = source->Current();
+            auto options = MakeArc<Options>(*initial, std::move(section));
+
+            WeakArc<Options> weak  = options;
+            options->mMonitor      = source;
+            options->mMonitorToken = source->Subscribe(
+                options->mSection,
+                [weak](const Arc<ConfigurationOptions>& config) {
+                    if (auto self = weak.lock())
+                        self->Reload(*config);
+                });
+            // A reload that landed before the subscription was missed.
+            if (auto current = source->Current(); current != initial)
+                options->Reload(*current);
+            return options;
+        }
+
+        /**
+         * @brief The current snapshot. Hold on to it for as long as a
+         *        consistent view is needed; it never changes.
+         */
+        Arc<const T> Value() const noexcept { return mSnapshot.load(); }
+
+        /** @brief Section path the snapshot is bound from. */
+        const std::string& Section() const noexcept { return mSection; }
+
+        /**
+         * @brief Rebinds the section from @p config and publishes the
+         *        result.
+         */
+        void Reload(const ConfigurationOptions& config)
+        {
+            Publish(Arc<const T>(config.Bind<T>(mSection)));
+        }
+
+        /**
+         * @brief Replaces the current snapshot and notifies every
+         *        listener with it.
+         *
+         * Listeners run on the calling thread after the snapshot is
+         * visible to readers, outside any lock, so they may call back
+         * into this object.
+         */
+        void Publish(Arc<const T> snapshot)
+        {
+            std::vector<Listener> listeners;
+            {
+                std::lock_guard<std::mutex> lock(mListenersMutex);
+                mSnapshot.store(snapshot);
+                listeners.reserve(mListeners.size());
+                for (const auto& entry : mListeners)
+                    listeners.push_back(entry.second);
+            }
+            for (const auto& listener : listeners)
+                listener(snapshot);
+        }
+
+        /**
+         * @brief Calls @p listener with every snapshot published after
+         *        this call. Returns a token for @c Unsubscribe.
+         */
+        std::size_t Subscribe(Listener listener)
+        {
+            std::lock_guard<std::mutex> lock(mListenersMutex);
+            mListeners.emplace_back(++mLastToken, std::move(listener));
+            return mLastToken;
+        }
+
+        void Unsubscribe(std::size_t token)
+        {
+            std::lock_guard<std::mutex> lock(mListenersMutex);
+            std::erase_if(mListeners, [token](const auto& entry) {
+                return entry.first == token;
+            });
+        }
+
+      private:
+        std::string        mSection;
+        AtomicArc<const T> mSnapshot;
+
+        Arc<ConfigurationMonitor> mMonitor;
+        std::size_t               mMonitorToken = 0;
+
+        // Guards the listener list. Publish also stores under it, so a
+        // listener subscribed concurrently either is notified or already
+        // sees the new snapshot through Value().
+        std::mutex                                    mListenersMutex;
+        std::vector<std::pair<std::size_t, Listener>> mListeners;
+        std::size_t                                   mLastToken = 0;
+    };
+} // namespace SKIRNIR_NAMESPACE
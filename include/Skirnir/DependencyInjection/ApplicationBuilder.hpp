@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 #include <ranges>
 #include <type_traits>
 
@@ -77,6 +78,22 @@ namespace SKIRNIR_NAMESPACE
             return *this;
         }
 
+        /**
+         * @brief Reloads the configuration as its files change.
+         *
+         * Registers a @c ConfigurationMonitor next to the initial
+         * @c ConfigurationOptions. @c Options<T> registered through
+         * @c AddOptions, and a @c LoggingExtension configured from the
+         * configuration, follow its reloads.
+         */
+        ApplicationBuilder& WithConfigurationReload(
+            ConfigurationMonitorOptions options = {})
+        {
+            mReloadOptions = std::move(options);
+
+            return *this;
+        }
+
         /**
          * @brief Builds and returns an application instance.
          *
@@ -91,7 +108,18 @@ namespace SKIRNIR_NAMESPACE
             requires(std::is_base_of_v<IApplication, T>)
         Arc<T> Build()
         {
-            mServiceCollection->AddSingleton(mConfigurationBuilder->Build());
+            if (mReloadOptions)
+            {
+                auto monitor = mConfigurationBuilder->BuildMonitor(
+                    std::move(*mReloadOptions));
+                mServiceCollection->AddSingleton(monitor->Current());
+                mServiceCollection->AddSingleton(std::move(monitor));
+            }
+            else
+            {
+                mServiceCollection->AddSingleton(
+                    mConfigurationBuilder->Build());
+            }
 
             for (const auto extension : mExtensions | std::views::values)
                 extension->ConfigureServices(*mServiceCollection);
@@ -128,9 +156,10 @@ namespace SKIRNIR_NAMESPACE
             return extension;
         }
 
-        Arc<ServiceCollection>                 mServiceCollection;
-        Arc<ConfigurationBuilder>              mConfigurationBuilder;
-        std::map<ExtensionId, Arc<IExtension>> mExtensions;
+        Arc<ServiceCollection>                     mServiceCollection;
+        Arc<ConfigurationBuilder>                  mConfigurationBuilder;
+        std::optional<ConfigurationMonitorOptions> mReloadOptions;
+        std::map<ExtensionId, Arc<IExtension>>     mExtensions;
     };
 
 } // namespace SKIRNIR_NAMESPACE
@@ -20,6 +20,8 @@
 
 namespace SKIRNIR_NAMESPACE
 {
+    template <typename T>
+    class Options;
 
     class ServiceCollection
     {
@@ -367,6 +369,26 @@ namespace SKIRNIR_NAMESPACE
             return *this;
         }
 
+        // ----- Options ---------------------------------------------------
+
+        /**
+         * @brief Registers @c Options<T> as a singleton bound from
+         *        @p section of the registered @c ConfigurationOptions.
+         *
+         * The section is bound on first resolution and cached; inject
+         * @c Arc<Options<T>> and read it with @c Value(). If a
+         * @c ConfigurationMonitor is registered, the options follow its
+         * reloads. Requires @c Skirnir/Configuration.hpp at the call site.
+         */
+        template <typename T>
+        ServiceCollection& AddOptions(std::string section = "")
+        {
+            return AddSingleton<Options<T>>(
+                [section = std::move(section)](ServiceProvider& sp) {
+                    return Arc<void>(Options<T>::Resolve(sp, section));
+                });
+        }
+
         /**
          * @brief Checks whether a service type is registered.
          *
@@ -1,8 +1,15 @@
 #pragma once
 
+#include "Logging/CompiledLogLevel.hpp"
+#include "Logging/LogField.hpp"
 #include "Logging/LogLevel.hpp"
+#include "Logging/LogMacros.hpp"
+#include "Logging/LogProperties.hpp"
+#include "Logging/LogRateLimit.hpp"
 #include "Logging/LogRecord.hpp"
 #include "Logging/LogScope.hpp"
 #include "Logging/Logger.hpp"
 #include "Logging/LoggingExtension.hpp"
 #include "Logging/LogSinks.hpp"
+#include "Logging/MessageTemplate.hpp"
+#include "Logging/TimestampFormat.hpp"
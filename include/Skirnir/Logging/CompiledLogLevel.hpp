@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Skirnir/Logging/LogLevel.hpp"
+
+#include <meta>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Lowest level compiled into the binary, as a @c LogLevel
+ *        enumerator name (e.g. @c -DSKIRNIR_LOG_MIN_LEVEL=Information).
+ *
+ * @c Log* calls below this level compile to nothing; with the
+ * @c SKIRNIR_LOG_* macros their arguments are not evaluated either.
+ * Defaults to @c Debug, the lowest level, so nothing is elided.
+ */
+#ifndef SKIRNIR_LOG_MIN_LEVEL
+#  define SKIRNIR_LOG_MIN_LEVEL Debug
+#endif
+
+namespace SKIRNIR_NAMESPACE
+{
+    inline constexpr LogLevel CompiledMinLogLevel =
+        LogLevel::SKIRNIR_LOG_MIN_LEVEL;
+
+    /**
+     * @brief Compile-time level floor for a single category.
+     *
+     * Specialize to strip levels from one type's logger only:
+     * @code
+     * template <>
+     * inline constexpr std::optional<skr::LogLevel>
+     *     skr::CompiledCategoryLogLevel<MyApp::Parser> =
+     *         skr::LogLevel::Warning;
+     * @endcode
+     */
+    template <typename T>
+    inline constexpr std::optional<LogLevel> CompiledCategoryLogLevel =
+        std::nullopt;
+
+    /**
+     * @brief Compile-time level floor for every category declared in a
+     *        namespace (or any of its nested namespaces).
+     *
+     * The innermost specialized namespace wins, mirroring the runtime
+     * lookup of @c LoggerOptions::GetLogLevelFor:
+     * @code
+     * template <>
+     * inline constexpr std::optional<skr::LogLevel>
+     *     skr::CompiledNamespaceLogLevel<^^MyApp::Net> =
+     *         skr::LogLevel::Error;
+     * @endcode
+     */
+    template <std::meta::info Ns>
+    inline constexpr std::optional<LogLevel> CompiledNamespaceLogLevel =
+        std::nullopt;
+
+    namespace detail
+    {
+        // Enclosing namespaces of T, innermost first.
+        template <typename T>
+        consteval std::vector<std::meta::info> EnclosingNamespaces()
+        {
+            std::vector<std::meta::info> chain;
+            for (auto scope = std::meta::parent_of(^^T); scope != ^^::;
+                 scope      = std::meta::parent_of(scope))
+            {
+                if (std::meta::is_namespace(scope))
+                    chain.push_back(scope);
+            }
+            return chain;
+        }
+
+        template <typename T>
+        consteval std::optional<LogLevel> CompiledScopeLogLevel()
+        {
+            if constexpr (CompiledCategoryLogLevel<T>.has_value())
+            {
+                return CompiledCategoryLogLevel<T>;
+            }
+            else
+            {
+                template for (constexpr auto ns : std::define_static_array(
+                                  EnclosingNamespaces<T>()))
+                {
+                    if constexpr (CompiledNamespaceLogLevel<ns>.has_value())
+                    {
+                        return CompiledNamespaceLogLevel<ns>;
+                    }
+                }
+                return std::nullopt;
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Effective compile-time floor for @c Logger<T>: the global
+     *        @c SKIRNIR_LOG_MIN_LEVEL, raised by any category or namespace
+     *        specialization. A specialization can only raise the floor.
+     */
+    template <typename T>
+    inline constexpr LogLevel CompiledLogLevelFor = [] consteval {
+        const auto scoped = detail::CompiledScopeLogLevel<T>();
+        if (scoped && *scoped > CompiledMinLogLevel)
+            return *scoped;
+        return CompiledMinLogLevel;
+    }();
+} // namespace SKIRNIR_NAMESPACE
@@ -2,7 +2,9 @@
 
 #include "Skirnir/Common/Namespace.hpp"
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #ifdef SKIRNIR_USE_FMT
@@ -25,6 +27,35 @@ namespace SKIRNIR_NAMESPACE::detail
     {
         return fmt::format(std::move(fmt), std::forward<TArgs>(args)...);
     }
+
+    /** Writes at most @p n chars to @p out; returns the untruncated size. */
+    template <typename... TArgs>
+    inline std::size_t FormatToN(char* out, std::size_t n,
+                                 fmt::format_string<TArgs...> fmt,
+                                 TArgs&&... args)
+    {
+        return fmt::format_to_n(out, n, std::move(fmt),
+                                std::forward<TArgs>(args)...)
+            .size;
+    }
+
+    template <typename... TArgs>
+    inline char* FormatTo(char* out, fmt::format_string<TArgs...> fmt,
+                          TArgs&&... args)
+    {
+        return fmt::format_to(out, std::move(fmt),
+                              std::forward<TArgs>(args)...);
+    }
+
+    /**
+     * Wraps a pattern that was validated elsewhere; it is only parsed
+     * when formatting.
+     */
+    template <typename... TArgs>
+    inline fmt::format_string<TArgs...> RuntimeFormat(std::string_view pattern)
+    {
+        return fmt::runtime(pattern);
+    }
 #else
     template <typename... TArgs>
     using FormatString = std::format_string<TArgs...>;
@@ -35,5 +66,35 @@ namespace SKIRNIR_NAMESPACE::detail
     {
         return std::format(std::move(fmt), std::forward<TArgs>(args)...);
     }
+
+    /** Writes at most @p n chars to @p out; returns the untruncated size. */
+    template <typename... TArgs>
+    inline std::size_t FormatToN(char* out, std::size_t n,
+                                 std::format_string<TArgs...> fmt,
+                                 TArgs&&... args)
+    {
+        const auto result = std::format_to_n(
+            out, static_cast<std::ptrdiff_t>(n), std::move(fmt),
+            std::forward<TArgs>(args)...);
+        return static_cast<std::size_t>(result.size);
+    }
+
+    template <typename... TArgs>
+    inline char* FormatTo(char* out, std::format_string<TArgs...> fmt,
+                          TArgs&&... args)
+    {
+        return std::format_to(out, std::move(fmt),
+                              std::forward<TArgs>(args)...);
+    }
+
+    /**
+     * Wraps a pattern that was validated elsewhere; it is only parsed
+     * when formatting.
+     */
+    template <typename... TArgs>
+    inline std::format_string<TArgs...> RuntimeFormat(std::string_view pattern)
+    {
+        return std::runtime_format(pattern);
+    }
 #endif
 } // namespace SKIRNIR_NAMESPACE::detail
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Skirnir/Common/Namespace.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Value of a structured log field.
+     *
+     * Integers are widened to 64 bits and strings are copied, so a
+     * record stays valid after it has been queued by an @c AsyncSink.
+     */
+    using LogFieldValue = std::variant<std::nullptr_t, bool, std::int64_t,
+                                       std::uint64_t, double, std::string>;
+
+    /**
+     * @brief A key/value pair attached to a @c LogRecord.
+     *
+     * @c JsonSink writes the fields of a record as a @c "fields" object,
+     * after its template properties and skipping any key already
+     * written; the plain-text sinks ignore them.
+     */
+    struct LogField
+    {
+        std::string   key;
+        LogFieldValue value;
+
+        LogField(std::string k, LogFieldValue v) :
+            key(std::move(k)), value(std::move(v))
+        {
+        }
+
+        LogField(std::string k, std::nullptr_t) :
+            key(std::move(k)), value(nullptr)
+        {
+        }
+
+        // A template so that pointers do not silently become bools.
+        template <typename T>
+            requires std::same_as<T, bool>
+        LogField(std::string k, T v) : key(std::move(k)), value(v)
+        {
+        }
+
+        template <std::signed_integral T>
+        LogField(std::string k, T v) :
+            key(std::move(k)), value(static_cast<std::int64_t>(v))
+        {
+        }
+
+        template <std::unsigned_integral T>
+            requires(!std::same_as<T, bool>)
+        LogField(std::string k, T v) :
+            key(std::move(k)), value(static_cast<std::uint64_t>(v))
+        {
+        }
+
+        template <std::floating_point T>
+        LogField(std::string k, T v) :
+            key(std::move(k)), value(static_cast<double>(v))
+        {
+        }
+
+        LogField(std::string k, std::string_view v) :
+            key(std::move(k)), value(std::string(v))
+        {
+        }
+
+        LogField(std::string k, const char* v) :
+            key(std::move(k)), value(std::string(v))
+        {
+        }
+
+        LogField(std::string k, std::string v) :
+            key(std::move(k)), value(std::move(v))
+        {
+        }
+    };
+
+    /**
+     * @brief Structured fields of a record, in the order they were
+     *        given. Empty (and allocation-free) unless fields are used.
+     */
+    using LogFields = std::vector<LogField>;
+} // namespace SKIRNIR_NAMESPACE
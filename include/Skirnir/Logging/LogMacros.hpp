@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Logging/Logger.hpp"
+
+#include <type_traits>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /// @cond INTERNAL
+    template <typename T>
+    inline Logger<T>& LoggerRef(Logger<T>& logger) noexcept
+    {
+        return logger;
+    }
+
+    template <typename T>
+    inline Logger<T>& LoggerRef(Logger<T>* logger) noexcept
+    {
+        return *logger;
+    }
+
+    template <typename T>
+    inline Logger<T>& LoggerRef(const Arc<Logger<T>>& logger) noexcept
+    {
+        return *logger;
+    }
+    /// @endcond
+} // namespace SKIRNIR_NAMESPACE::detail
+
+/**
+ * @brief Logs through @p logger (a @c Logger<T>, pointer, or
+ *        @c Arc<Logger<T>>) at @p level, a @c LogLevel enumerator name,
+ *        using the matching @c Log* member @p method. Prefer the
+ *        per-level shorthands below.
+ *
+ * Unlike calling @c Log* directly, the format arguments are only
+ * evaluated when the record will actually be dispatched. Below the
+ * compile-time floor (@c SKIRNIR_LOG_MIN_LEVEL or a category
+ * specialization) the whole statement compiles to nothing.
+ *
+ * @code
+ * SKIRNIR_LOG_DEBUG(mLogger, "state: {}", DumpState());
+ * @endcode
+ */
+#define SKIRNIR_LOG(logger, level, method, ...)                                \
+    do                                                                         \
+    {                                                                          \
+        auto& skirnirLogger_ = ::SKIRNIR_NAMESPACE::detail::LoggerRef(logger); \
+        if constexpr (std::remove_cvref_t<decltype(skirnirLogger_)>::          \
+                          IsCompiledIn(::SKIRNIR_NAMESPACE::LogLevel::level))  \
+        {                                                                      \
+            if (skirnirLogger_.IsEnabled(                                      \
+                    ::SKIRNIR_NAMESPACE::LogLevel::level))                     \
+                skirnirLogger_.method(__VA_ARGS__);                            \
+        }                                                                      \
+    } while (false)
+
+#define SKIRNIR_LOG_TRACE(logger, ...)                                         \
+    SKIRNIR_LOG(logger, Trace, LogTrace, __VA_ARGS__)
+#define SKIRNIR_LOG_DEBUG(logger, ...)                                         \
+    SKIRNIR_LOG(logger, Debug, LogDebug, __VA_ARGS__)
+#define SKIRNIR_LOG_INFORMATION(logger, ...)                                   \
+    SKIRNIR_LOG(logger, Information, LogInformation, __VA_ARGS__)
+#define SKIRNIR_LOG_WARNING(logger, ...)                                       \
+    SKIRNIR_LOG(logger, Warning, LogWarning, __VA_ARGS__)
+#define SKIRNIR_LOG_ERROR(logger, ...)                                         \
+    SKIRNIR_LOG(logger, Error, LogError, __VA_ARGS__)
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "Skirnir/Logging/Format.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Character buffer with @p N bytes of inline storage that
+     *        spills to the heap only when the content outgrows it.
+     *
+     * Used for the rendered message of a @c LogRecord so the common,
+     * short-message case needs no heap allocation at all. Copies are
+     * deep; moves steal the heap block when there is one.
+     */
+    template <std::size_t N>
+    class BasicLogBuffer
+    {
+      public:
+        static constexpr std::size_t InlineCapacity = N;
+
+        BasicLogBuffer() noexcept = default;
+
+        BasicLogBuffer(std::string_view text)
+        {
+            Assign(text);
+        }
+
+        BasicLogBuffer(const BasicLogBuffer& other)
+        {
+            Assign(other.View());
+        }
+
+        BasicLogBuffer(BasicLogBuffer&& other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        BasicLogBuffer& operator=(const BasicLogBuffer& other)
+        {
+            if (this != &other)
+                Assign(other.View());
+            return *this;
+        }
+
+        BasicLogBuffer& operator=(BasicLogBuffer&& other) noexcept
+        {
+            if (this != &other)
+                MoveFrom(other);
+            return *this;
+        }
+
+        BasicLogBuffer& operator=(std::string_view text)
+        {
+            Assign(text);
+            return *this;
+        }
+
+        void Assign(std::string_view text)
+        {
+            char* out = Prepare(text.size());
+            if (!text.empty())
+                std::memcpy(out, text.data(), text.size());
+            mSize = text.size();
+        }
+
+        void Append(std::string_view text)
+        {
+            if (text.empty())
+                return;
+            Grow(mSize + text.size());
+            std::memcpy(Data() + mSize, text.data(), text.size());
+            mSize += text.size();
+        }
+
+        void Clear() noexcept
+        {
+            mSize = 0;
+        }
+
+        /**
+         * @brief Renders @p fmt into the buffer, replacing its content.
+         *
+         * Formats straight into the inline storage; only when the
+         * result does not fit is a heap block of the exact size
+         * allocated and the message rendered a second time.
+         */
+        template <typename... TArgs>
+        void Format(detail::FormatString<TArgs...> fmt, TArgs&&... args)
+        {
+            // Formatting never moves from its arguments, so forwarding
+            // them a second time on the spill path is safe.
+            const std::size_t total = detail::FormatToN(
+                mInline, N, fmt, std::forward<TArgs>(args)...);
+            if (total <= N)
+            {
+                mHeap.reset();
+                mHeapCapacity = 0;
+                mSize         = total;
+                return;
+            }
+
+            char* out = Prepare(total);
+            detail::FormatTo(out, fmt, std::forward<TArgs>(args)...);
+            mSize = total;
+        }
+
+        const char* data() const noexcept
+        {
+            return mHeap ? mHeap.get() : mInline;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return mSize;
+        }
+
+        bool empty() const noexcept
+        {
+            return mSize == 0;
+        }
+
+        /** @brief True while the content still fits the inline storage. */
+        bool IsInline() const noexcept
+        {
+            return !mHeap;
+        }
+
+        std::string_view View() const noexcept
+        {
+            return {data(), mSize};
+        }
+
+        std::string Str() const
+        {
+            return std::string(View());
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return View();
+        }
+
+        friend bool operator==(const BasicLogBuffer& lhs,
+                               std::string_view      rhs) noexcept
+        {
+            return lhs.View() == rhs;
+        }
+
+        friend bool operator==(const BasicLogBuffer& lhs,
+                               const BasicLogBuffer& rhs) noexcept
+        {
+            return lhs.View() == rhs.View();
+        }
+
+      private:
+        char* Data() noexcept
+        {
+            return mHeap ? mHeap.get() : mInline;
+        }
+
+        // Returns storage for @p size bytes; the previous content is
+        // discarded.
+        char* Prepare(std::size_t size)
+        {
+            if (size <= N)
+            {
+                mHeap.reset();
+                mHeapCapacity = 0;
+                return mInline;
+            }
+            if (!mHeap || mHeapCapacity < size)
+            {
+                mHeap         = std::make_unique<char[]>(size);
+                mHeapCapacity = size;
+            }
+            return mHeap.get();
+        }
+
+        // Ensures room for @p size bytes, keeping the current content.
+        void Grow(std::size_t size)
+        {
+            const std::size_t capacity = mHeap ? mHeapCapacity : N;
+            if (size <= capacity)
+                return;
+
+            const std::size_t newCapacity = std::max(size, capacity * 2);
+            auto              block = std::make_unique<char[]>(newCapacity);
+            if (mSize)
+                std::memcpy(block.get(), data(), mSize);
+            mHeap         = std::move(block);
+            mHeapCapacity = newCapacity;
+        }
+
+        void MoveFrom(BasicLogBuffer& other) noexcept
+        {
+            if (other.mHeap)
+            {
+                mHeap         = std::move(other.mHeap);
+                mHeapCapacity = other.mHeapCapacity;
+            }
+            else
+            {
+                mHeap.reset();
+                mHeapCapacity = 0;
+                if (other.mSize)
+                    std::memcpy(mInline, other.mInline, other.mSize);
+            }
+            mSize              = other.mSize;
+            other.mSize        = 0;
+            other.mHeapCapacity = 0;
+        }
+
+        std::size_t             mSize         = 0;
+        std::size_t             mHeapCapacity = 0;
+        std::unique_ptr<char[]> mHeap;
+        char                    mInline[N];
+    };
+
+    /**
+     * @brief Rendered message of a @c LogRecord.
+     *
+     * Messages up to 256 bytes live inline in the record; longer ones
+     * spill to a single heap block.
+     */
+    using LogMessage = BasicLogBuffer<256>;
+} // namespace SKIRNIR_NAMESPACE
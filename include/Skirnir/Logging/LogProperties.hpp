@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Skirnir/Logging/Format.hpp"
+#include "Skirnir/Logging/LogMessage.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Value of a property captured from a message template.
+     *        Strings view storage owned by the @c LogProperties.
+     *
+     * Unlike @c LogFieldValue, which copies each string so a field can
+     * outlive whatever produced it, properties are captured on every log
+     * call and keep their text in the record's own buffer; viewing it
+     * avoids one allocation per string property.
+     */
+    using LogPropertyValue = std::variant<bool, std::int64_t, std::uint64_t,
+                                          double, std::string_view>;
+
+    struct LogProperty
+    {
+        std::string_view name;
+        LogPropertyValue value;
+    };
+
+    /**
+     * @brief Typed properties of a record, captured from the named
+     *        placeholders of a message template.
+     *
+     * The first @c InlineCapacity properties live inside the record and
+     * string values share one small text buffer, so capturing a few
+     * numbers and short strings does not allocate. Names must have
+     * static lifetime; @c Logger<T> passes views into the template
+     * literal. Copies are deep.
+     */
+    class LogProperties
+    {
+      public:
+        static constexpr std::size_t InlineCapacity = 4;
+
+        void Add(std::string_view name, bool value)
+        {
+            Slot& s = Push(name, Kind::Bool);
+            s.b     = value;
+        }
+
+        void Add(std::string_view name, std::int64_t value)
+        {
+            Slot& s = Push(name, Kind::Int);
+            s.i     = value;
+        }
+
+        void Add(std::string_view name, std::uint64_t value)
+        {
+            Slot& s = Push(name, Kind::UInt);
+            s.u     = value;
+        }
+
+        void Add(std::string_view name, double value)
+        {
+            Slot& s = Push(name, Kind::Double);
+            s.d     = value;
+        }
+
+        void Add(std::string_view name, std::string_view value)
+        {
+            const auto offset = static_cast<std::uint32_t>(mText.size());
+            mText.Append(value);
+            Slot& s    = Push(name, Kind::String);
+            s.s.offset = offset;
+            s.s.size   = static_cast<std::uint32_t>(value.size());
+        }
+
+        /**
+         * @brief Stores @p value under its natural JSON type: booleans,
+         *        integers, floating point and strings keep their type;
+         *        anything else is stored as its @c {} formatted text.
+         */
+        template <typename T>
+        void Capture(std::string_view name, const T& value)
+        {
+            using V = std::remove_cvref_t<T>;
+            if constexpr (std::same_as<V, bool>)
+                Add(name, value);
+            else if constexpr (std::same_as<V, char>)
+                Add(name, std::string_view(&value, 1));
+            else if constexpr (std::signed_integral<V>)
+                Add(name, static_cast<std::int64_t>(value));
+            else if constexpr (std::unsigned_integral<V>)
+                Add(name, static_cast<std::uint64_t>(value));
+            else if constexpr (std::floating_point<V>)
+                Add(name, static_cast<double>(value));
+            else if constexpr (std::convertible_to<const V&, std::string_view>)
+                Add(name, std::string_view(value));
+            else
+            {
+                char              buffer[64];
+                const std::size_t n =
+                    detail::FormatToN(buffer, sizeof(buffer), "{}", value);
+                if (n <= sizeof(buffer))
+                    Add(name, std::string_view(buffer, n));
+                else
+                    Add(name, std::string_view(detail::Format("{}", value)));
+            }
+        }
+
+        std::size_t size() const noexcept
+        {
+            return mCount;
+        }
+
+        bool empty() const noexcept
+        {
+            return mCount == 0;
+        }
+
+        void Clear() noexcept
+        {
+            mCount = 0;
+            mOverflow.clear();
+            mText.Clear();
+        }
+
+        /** @brief Property @p i, in placeholder order. */
+        LogProperty operator[](std::size_t i) const noexcept
+        {
+            const Slot& s = i < InlineCapacity ? mInline[i]
+                                               : mOverflow[i - InlineCapacity];
+            const std::string_view name(s.name, s.nameSize);
+            switch (s.kind)
+            {
+                case Kind::Bool:
+                    return {name, s.b};
+                case Kind::Int:
+                    return {name, s.i};
+                case Kind::UInt:
+                    return {name, s.u};
+                case Kind::Double:
+                    return {name, s.d};
+                case Kind::String:
+                    break;
+            }
+            return {name, mText.View().substr(s.s.offset, s.s.size)};
+        }
+
+        template <typename F>
+        void ForEach(F&& fn) const
+        {
+            for (std::size_t i = 0; i < mCount; ++i)
+                fn((*this)[i]);
+        }
+
+      private:
+        enum class Kind : std::uint8_t
+        {
+            Bool,
+            Int,
+            UInt,
+            Double,
+            String
+        };
+
+        struct Slot
+        {
+            const char*   name     = nullptr;
+            std::uint32_t nameSize = 0;
+            Kind          kind     = Kind::Bool;
+            union
+            {
+                bool          b;
+                std::int64_t  i;
+                std::uint64_t u;
+                double        d;
+                struct
+                {
+                    std::uint32_t offset;
+                    std::uint32_t size;
+                } s;
+            };
+        };
+
+        Slot& Push(std::string_view name, Kind kind)
+        {
+            Slot* s;
+            if (mCount < InlineCapacity)
+                s = &mInline[mCount];
+            else
+                s = &mOverflow.emplace_back();
+            ++mCount;
+            s->name     = name.data();
+            s->nameSize = static_cast<std::uint32_t>(name.size());
+            s->kind     = kind;
+            return *s;
+        }
+
+        std::array<Slot, InlineCapacity> mInline {};
+        std::vector<Slot>                mOverflow;
+        std::size_t                      mCount = 0;
+        BasicLogBuffer<64>               mText;
+    };
+} // namespace SKIRNIR_NAMESPACE
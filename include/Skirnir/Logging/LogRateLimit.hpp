@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Skirnir/Logging/LogLevel.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief How records from a single call site are thinned out.
+     */
+    enum class LogRateLimitMode
+    {
+        /** @brief Every record is dispatched. */
+        Off,
+        /**
+         * @brief Up to @c burst records at once, refilled at
+         *        @c perSecond records per second.
+         */
+        TokenBucket,
+        /** @brief The first of every @c sampleEvery records. */
+        Sample
+    };
+
+    /**
+     * @brief Per-call-site rate limit applied by @c Logger<T> before a
+     *        record is formatted.
+     *
+     * Each call site (file, line and column of the @c Log* call) is
+     * limited on its own. Records above @c maxLevel are never limited,
+     * and neither is @c Fatal. Suppressed records are counted, and
+     * every @c summaryInterval a single @c Warning record lists the
+     * call sites that were throttled.
+     *
+     * Set in code with @c LoggerOptions::SetRateLimit, or through the
+     * @c logging.rateLimit section of the configuration (see
+     * @c LoggerOptions::ConfigureFrom).
+     */
+    struct LogRateLimit
+    {
+        LogRateLimitMode mode = LogRateLimitMode::Off;
+
+        /** @brief Token bucket: records that may pass back to back. */
+        std::uint32_t burst = 10;
+
+        /** @brief Token bucket: sustained records per second. */
+        double perSecond = 1.0;
+
+        /** @brief Sampling: keep one record out of this many. */
+        std::uint32_t sampleEvery = 100;
+
+        /** @brief Most severe level that is limited. */
+        LogLevel maxLevel = LogLevel::Warning;
+
+        /**
+         * @brief How often the suppression summary is dispatched. Zero
+         *        disables the summary.
+         */
+        std::chrono::milliseconds summaryInterval {10'000};
+    };
+} // namespace SKIRNIR_NAMESPACE
@@ -1,23 +1,48 @@
 #pragma once
 
+#include "Skirnir/Logging/LogField.hpp"
 #include "Skirnir/Logging/LogLevel.hpp"
+#include "Skirnir/Logging/LogMessage.hpp"
+#include "Skirnir/Logging/LogProperties.hpp"
+#include "Skirnir/Logging/LogScopeChain.hpp"
 
 #include <chrono>
-#include <string>
+#include <source_location>
 #include <string_view>
-#include <vector>
 
 namespace SKIRNIR_NAMESPACE
 {
     /**
      * @brief A complete log entry, ready to be handed to a sink.
+     *
+     * The layout is chosen so that building a record on the logging
+     * thread performs no heap allocation in the common case:
+     *  - @c category points at static storage (the reflected type name
+     *    for records produced by @c Logger<T>). It does not own its
+     *    text: code that builds records by hand must assign a string that
+     *    outlives the record in every sink it reaches. @c AsyncSink and
+     *    @c BufferedSink keep records after @c Write() returns, so a
+     *    category backed by a local @c std::string dangles there.
+     *  - @c message keeps short messages inline (see @c LogMessage).
+     *  - @c scopes shares the thread's immutable scope chain instead of
+     *    copying the names.
+     *  - @c properties holds the arguments of a message template inline;
+     *    @c fields is an empty vector unless the caller attaches
+     *    structured fields.
+     *  - @c location is the call site of the @c Log* method. Its file
+     *    and function names are compiler-generated static strings, so
+     *    storing it copies two pointers and two integers. Hand-built
+     *    records leave it empty (line 0).
      */
     struct LogRecord
     {
         LogLevel                              level = LogLevel::Information;
         std::chrono::system_clock::time_point timestamp {};
-        std::string                           category {};
-        std::string                           message {};
-        std::vector<std::string>              scopes {};
+        std::string_view                      category {};
+        LogMessage                            message {};
+        LogScopeChain                         scopes {};
+        LogProperties                         properties {};
+        LogFields                             fields {};
+        std::source_location                  location {};
     };
 } // namespace SKIRNIR_NAMESPACE
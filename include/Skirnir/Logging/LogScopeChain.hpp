@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Skirnir/Common/Arc.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief One immutable link of a thread's scope stack.
+     *
+     * Nodes are created once per @c LoggerOptions::PushScope and never
+     * modified afterwards, so any number of records (including ones
+     * queued in an @c AsyncSink) can share them by reference count.
+     */
+    struct LogScopeNode
+    {
+        LogScopeNode(std::string scopeName, Arc<const LogScopeNode> outer) :
+            name(std::move(scopeName)), parent(std::move(outer)),
+            depth(parent ? parent->depth + 1 : 1)
+        {
+        }
+
+        std::string             name;
+        Arc<const LogScopeNode> parent;
+        std::size_t             depth;
+    };
+
+    /**
+     * @brief Read-only view of the scopes active when a record was
+     *        dispatched, outermost first.
+     *
+     * Copying a chain costs a single reference-count increment; the
+     * scope names themselves are never copied.
+     */
+    class LogScopeChain
+    {
+      public:
+        LogScopeChain() noexcept = default;
+
+        explicit LogScopeChain(Arc<const LogScopeNode> tail) noexcept :
+            mTail(std::move(tail))
+        {
+        }
+
+        std::size_t size() const noexcept
+        {
+            return mTail ? mTail->depth : 0;
+        }
+
+        bool empty() const noexcept
+        {
+            return !mTail;
+        }
+
+        /** @brief Scope name at @p index, where 0 is the outermost scope. */
+        const std::string& operator[](std::size_t index) const noexcept
+        {
+            const LogScopeNode* node = mTail.get();
+            while (node->depth > index + 1)
+            {
+                node = node->parent.get();
+            }
+            return node->name;
+        }
+
+        /** @brief Invokes @p fn(name) for every scope, outermost first. */
+        template <typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            Visit(mTail.get(), fn);
+        }
+
+        const Arc<const LogScopeNode>& Tail() const noexcept
+        {
+            return mTail;
+        }
+
+      private:
+        template <typename Fn>
+        static void Visit(const LogScopeNode* node, Fn& fn)
+        {
+            if (!node)
+                return;
+            Visit(node->parent.get(), fn);
+            fn(static_cast<const std::string&>(node->name));
+        }
+
+        Arc<const LogScopeNode> mTail;
+    };
+} // namespace SKIRNIR_NAMESPACE
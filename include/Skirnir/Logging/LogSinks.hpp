@@ -6,3 +6,6 @@
 #include "Skirnir/Logging/LogSinks/FileSink.hpp"
 #include "Skirnir/Logging/LogSinks/JsonSink.hpp"
 #include "Skirnir/Logging/LogSinks/AsyncSink.hpp"
+#include "Skirnir/Logging/LogSinks/BufferedSink.hpp"
+#include "Skirnir/Logging/LogSinks/MmapFileSink.hpp"
+#include "Skirnir/Logging/LogSinks/UringFileSink.hpp"
@@ -43,6 +43,9 @@ namespace SKIRNIR_NAMESPACE
         std::size_t              mCapacity;
         std::jthread             mWorker;
         bool                     mStopping = false;
+        // True while the worker writes a record it already dequeued;
+        // Flush() waits for it as well as for the queue.
+        bool                     mWriting  = false;
         std::atomic<std::uint64_t> mDropped {0};
     };
 } // namespace SKIRNIR_NAMESPACE
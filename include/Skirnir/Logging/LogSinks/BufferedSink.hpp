@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Logging/LogSinks/ILogSink.hpp"
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Decorator that gives every producing thread its own record
+     *        buffer and forwards them to an inner sink in batches.
+     *
+     * @c Write() appends to a single-producer ring owned by the calling
+     *        thread; there is no lock and no shared cache line between
+     *        producers. A background flusher drains all rings every
+     *        @p flushInterval (or sooner once a ring is half full),
+     *        orders the collected records by timestamp and hands them to
+     *        @c ILogSink::WriteBatch of the inner sink.
+     *
+     * When a thread's ring is full the new record is dropped and the
+     *        thread's drop counter is incremented (see @c DroppedCount).
+     *        Records are only ordered within one flush; a record that
+     *        arrives after its flush window is written in the next batch.
+     *
+     * Every slot holds a whole @c LogRecord (about 600 bytes on 64-bit
+     *        builds), allocated when a thread first writes to the sink.
+     *        The default of 256 slots costs about 150 KiB per producing
+     *        thread, plus the heap owned by records still buffered.
+     */
+    class BufferedSink final : public ILogSink
+    {
+      public:
+        explicit BufferedSink(
+            Arc<ILogSink>             inner,
+            std::size_t               perThreadCapacity = 256,
+            std::chrono::milliseconds flushInterval =
+                std::chrono::milliseconds(100));
+        ~BufferedSink() override;
+
+        void Write(const LogRecord& record) override;
+
+        /**
+         * @brief Drains every thread buffer into the inner sink and
+         *        flushes it. Records written concurrently with the call
+         *        may land in the next batch.
+         */
+        void Flush() override;
+
+        std::uint64_t DroppedCount() const noexcept;
+
+        /// @cond INTERNAL
+        struct ThreadBuffer;
+        /// @endcond
+
+      private:
+        ThreadBuffer& LocalBuffer();
+        void          FlusherLoop(std::stop_token st);
+        void          Drain();
+
+        Arc<ILogSink>             mInner;
+        std::size_t               mCapacity;
+        std::chrono::milliseconds mInterval;
+        std::uint64_t             mId;
+
+        // Registry of per-thread buffers; only touched when a thread
+        // writes for the first time and by the flusher.
+        mutable std::mutex             mBuffersMutex;
+        std::vector<Arc<ThreadBuffer>> mBuffers;
+        std::uint64_t                  mRetiredDropped = 0;
+
+        // Serializes consumers (flusher thread and explicit Flush()).
+        // The vectors are reused across drains to avoid reallocating.
+        std::mutex                     mDrainMutex;
+        std::vector<Arc<ThreadBuffer>> mDraining;
+        std::vector<LogRecord>         mBatch;
+
+        std::mutex                  mWakeMutex;
+        std::condition_variable_any mWakeCv;
+        std::atomic<bool>           mWakeRequested {false};
+        std::jthread                mFlusher;
+    };
+} // namespace SKIRNIR_NAMESPACE
@@ -3,21 +3,29 @@
 #include <mutex>
 
 #include "Skirnir/Logging/LogSinks/ILogSink.hpp"
+#include "Skirnir/Logging/TimestampFormat.hpp"
 
 namespace SKIRNIR_NAMESPACE
 {
     /**
      * @brief Writes records to standard output, optionally with ANSI color.
+     *
+     *  With @p includeSource, each line shows the call site as
+     *  ` (file:line)` after the category.
      */
     class ConsoleSink final : public ILogSink
     {
       public:
-        explicit ConsoleSink(bool useColors = true);
+        explicit ConsoleSink(bool            useColors     = true,
+                             TimestampFormat timestamps    = {},
+                             bool            includeSource = false);
 
         void Write(const LogRecord& record) override;
 
       private:
-        bool              mUseColors;
-        std::mutex        mMutex;
+        bool               mUseColors;
+        bool               mIncludeSource;
+        std::mutex         mMutex;
+        TimestampFormatter mTimestamps; // guarded by mMutex
     };
 } // namespace SKIRNIR_NAMESPACE
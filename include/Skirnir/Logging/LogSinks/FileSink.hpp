@@ -1,14 +1,63 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <filesystem>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
 
+#include "Skirnir/Logging/LogLevel.hpp"
 #include "Skirnir/Logging/LogSinks/ILogSink.hpp"
+#include "Skirnir/Logging/TimestampFormat.hpp"
 
 namespace SKIRNIR_NAMESPACE
 {
+    namespace detail
+    {
+        class LogRotator;
+    }
+
+    /**
+     * @brief Time-based rotation period for file sinks. Boundaries are
+     *        whole hours or days in UTC.
+     */
+    enum class RotationInterval
+    {
+        Never,
+        Hourly,
+        Daily
+    };
+
+    /**
+     * @brief Group-commit rule for file sinks: buffered records are
+     *        flushed when any trigger fires, instead of after every
+     *        record.
+     */
+    struct FlushPolicy
+    {
+        /** @brief Flush once this many bytes are unflushed; 0 disables. */
+        std::size_t bytes = 64 * 1024;
+
+        /**
+         * @brief Flush unflushed data at least this often, idle or not;
+         *        0 disables. Driven by a background timer.
+         */
+        std::chrono::milliseconds interval {1000};
+
+        /**
+         * @brief Flush right after a record at or above this level;
+         *        @c LogLevel::None disables.
+         */
+        LogLevel level = LogLevel::Error;
+
+        /** @brief Follow each flush with @c fdatasync. */
+        bool sync = false;
+    };
+
     /**
      * @brief Behavioural options for @c FileSink and the file variant
      *        of @c JsonSink.
@@ -41,6 +90,45 @@ namespace SKIRNIR_NAMESPACE
          *  a fresh file while keeping the previous one as `.1`.
          */
         bool rotateOnOpen = false;
+
+        /**
+         * @brief Also rotate when the record timestamp crosses an hour
+         *        or day boundary. Rotated copies use the same numbered
+         *        names and @c maxFiles limit as size-based rotation.
+         */
+        RotationInterval rotateEvery = RotationInterval::Never;
+
+        /**
+         * @brief Gzip rotated files (`path.1.gz`, ...) in the
+         *        background. Requires a build with SKIRNIR_USE_ZLIB;
+         *        the sink constructor throws otherwise.
+         */
+        bool compressRotated = false;
+
+        /**
+         * @brief Layout and precision of the timestamp on each line.
+         *
+         *  Only used by @c FileSink; the JSON sink always writes the
+         *  record's timestamp in its own format.
+         */
+        TimestampFormat timestampFormat {};
+
+        /**
+         * @brief Print the call site of each record: ` (file:line)`
+         *        after the category in text lines, and a @c "source"
+         *        object with file, line and function in JSON lines.
+         */
+        bool includeSource = false;
+
+        /**
+         * @brief Group-commit flushing. When set, it replaces the
+         *        @c autoFlush flag of @c FileSink and also applies to the
+         *        file variant of @c JsonSink (which otherwise leaves
+         *        flushing to the C runtime). @c UringFileSink applies it
+         *        to its staging buffers on top of
+         *        @c UringFileSinkOptions.
+         */
+        std::optional<FlushPolicy> flushPolicy;
     };
 
     /**
@@ -48,8 +136,11 @@ namespace SKIRNIR_NAMESPACE
      *
      *  The file is opened in append mode with hardening against
      *  symlink/reparse-point substitution and with restrictive
-     *  permissions on POSIX. If @c FileSinkOptions::maxBytes is set,
-     *  the sink rotates the file on size.
+     *  permissions on POSIX. If @c FileSinkOptions::maxBytes or
+     *  @c FileSinkOptions::rotateEvery is set, the sink rotates the
+     *  file. Only one rename and the reopen happen under the sink's
+     *  lock; closing the old file, shifting older copies and
+     *  compression run on a background thread.
      */
     class FileSink final : public ILogSink
     {
@@ -73,12 +164,22 @@ namespace SKIRNIR_NAMESPACE
         FileSink& operator=(const FileSink&) = delete;
 
         void OpenLocked();
+        void FlushLocked();
+        void RotateLocked();
 
         std::filesystem::path mPath;
         FileSinkOptions       mOptions;
         std::FILE*            mFile        = nullptr;
         std::size_t           mCurrentSize = 0;
+        std::size_t           mUnflushed   = 0;
         std::mutex            mMutex;
+        TimestampFormatter    mTimestamps; // guarded by mMutex
         bool                  mAutoFlush;
+        std::jthread          mFlushTimer;
+
+        // Set only when rotation is enabled.
+        std::chrono::system_clock::time_point mRotateAt =
+            std::chrono::system_clock::time_point::max();
+        std::unique_ptr<detail::LogRotator> mRotator;
     };
 } // namespace SKIRNIR_NAMESPACE
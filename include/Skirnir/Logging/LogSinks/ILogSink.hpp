@@ -2,6 +2,8 @@
 
 #include "Skirnir/Logging/LogRecord.hpp"
 
+#include <span>
+
 namespace SKIRNIR_NAMESPACE
 {
     /**
@@ -15,6 +17,20 @@ namespace SKIRNIR_NAMESPACE
       public:
         virtual ~ILogSink() = default;
         virtual void Write(const LogRecord& record) = 0;
+
+        /**
+         * @brief Writes several records at once, oldest first.
+         *
+         * Used by batching decorators such as @c BufferedSink. The
+         * default forwards to @c Write one record at a time; sinks that
+         * can amortize locking or I/O across a batch should override it.
+         */
+        virtual void WriteBatch(std::span<const LogRecord> records)
+        {
+            for (const auto& record : records)
+                Write(record);
+        }
+
         virtual void Flush()
         {
         }
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <ostream>
+#include <span>
+#include <string_view>
+#include <thread>
 
 #include "Skirnir/Logging/LogSinks/FileSink.hpp"
 #include "Skirnir/Logging/LogSinks/ILogSink.hpp"
@@ -15,10 +20,16 @@ namespace SKIRNIR_NAMESPACE
      * @brief Emits records as NDJSON (one JSON object per line) to either
      *        an existing @c std::ostream or a file path.
      *
+     *  Lines are produced by a hand-written encoder with a fixed field
+     *  order (level, timestamp, category, message, scopes, then
+     *  @c fields when the record has any). Encoding happens on the
+     *  calling thread before the sink lock is taken.
+     *
      *  When constructed with a path, the file is opened in **append**
      *  mode (not truncating) and is hardened against symlink/reparse-
      *  point substitution. Optional @c FileSinkOptions (rotation, etc.)
-     *  apply to the file variant.
+     *  apply to the file variant; rotation runs in the background as
+     *  for @c FileSink.
      */
     class JsonSink final : public ILogSink
     {
@@ -28,6 +39,7 @@ namespace SKIRNIR_NAMESPACE
         JsonSink(std::filesystem::path path, FileSinkOptions options);
 
         void Write(const LogRecord& record) override;
+        void WriteBatch(std::span<const LogRecord> records) override;
         void Flush() override;
 
         ~JsonSink() override;
@@ -36,11 +48,23 @@ namespace SKIRNIR_NAMESPACE
         JsonSink(const JsonSink&)            = delete;
         JsonSink& operator=(const JsonSink&) = delete;
 
+        void StartFlushTimer();
+        void WriteLocked(std::string_view line, const LogRecord& record);
+        void FlushLocked();
+        void RotateLocked();
+
         std::FILE*       mFile = nullptr;   // owned when non-null
         std::ostream*    mOs   = nullptr;   // borrowed when non-null
         std::filesystem::path mPath;
         FileSinkOptions  mOptions;
         std::size_t      mCurrentSize = 0;
+        std::size_t      mUnflushed   = 0;
         std::mutex       mMutex;
+        std::jthread     mFlushTimer;
+
+        // Set only when rotation is enabled.
+        std::chrono::system_clock::time_point mRotateAt =
+            std::chrono::system_clock::time_point::max();
+        std::unique_ptr<detail::LogRotator> mRotator;
     };
 } // namespace SKIRNIR_NAMESPACE
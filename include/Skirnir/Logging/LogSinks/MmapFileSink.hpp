@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "Skirnir/Logging/LogSinks/ILogSink.hpp"
+#include "Skirnir/Logging/TimestampFormat.hpp"
+
+namespace SKIRNIR_NAMESPACE
+{
+    namespace detail
+    {
+        class LogRotator;
+        struct MmapSegment;
+    } // namespace detail
+
+    /**
+     * @brief When an @c MmapFileSink forces mapped data to disk.
+     */
+    enum class MmapDurability
+    {
+        /** @brief Leave write-back entirely to the kernel. */
+        None,
+        /** @brief @c msync the active segment every @c syncInterval. */
+        PeriodicSync,
+        /**
+         * @brief @c msync the record and @c fdatasync the file after
+         *        every record at @c LogLevel::Error or above.
+         */
+        SyncOnError
+    };
+
+    /**
+     * @brief Options for @c MmapFileSink.
+     */
+    struct MmapFileSinkOptions
+    {
+        /**
+         * @brief Bytes preallocated and mapped at a time. When a segment
+         *        fills up, the next one starts right after the last
+         *        record.
+         */
+        std::size_t segmentBytes = 16 * 1024 * 1024;
+
+        /**
+         * @brief Soft cap on the file size in bytes; 0 disables
+         *        rotation. Rotation renames the file to `path.1` (older
+         *        copies shift to `.2`, `.3`, ...) like @c FileSink.
+         */
+        std::size_t maxBytes = 0;
+
+        /** @brief Rotated copies to retain; at least 1 when rotating. */
+        std::size_t maxFiles = 0;
+
+        MmapDurability            durability = MmapDurability::None;
+        std::chrono::milliseconds syncInterval {1000};
+
+        TimestampFormat timestampFormat {};
+
+        /** @brief Print ` (file:line)` after the category. */
+        bool includeSource = false;
+    };
+
+    /**
+     * @brief Appends plain-text records into a memory-mapped,
+     *        preallocated log file.
+     *
+     *  Producers load the active segment with one atomic pointer load,
+     *  reserve space with a single atomic @c fetch_add and copy their
+     *  line straight into the mapping; no mutex is taken unless a
+     *  segment is full. A background thread keeps the next segment (or,
+     *  when the next switch rotates, the next file) preallocated and
+     *  mapped, so the producer whose reservation crosses the end of a
+     *  segment only swaps it in while the others wait; on rotation it
+     *  also renames the file aside and hands the shift of older copies
+     *  to a @c LogRotator. Filled segments are synced and unmapped by
+     *  the background thread once their last copy has landed.
+     *
+     *  The file carries preallocated, zero-filled space past the last
+     *  record while the sink is open; it is truncated to the written
+     *  size on rotation and on destruction.
+     *
+     *  The output format matches @c FileSink. Available on POSIX
+     *  systems only; the constructor throws elsewhere.
+     */
+    class MmapFileSink final : public ILogSink
+    {
+      public:
+        explicit MmapFileSink(std::filesystem::path path,
+                              MmapFileSinkOptions   options = {});
+        ~MmapFileSink() override;
+
+        void Write(const LogRecord& record) override;
+
+        /** @brief Synchronously writes the active segment to disk. */
+        void Flush() override;
+
+        const std::filesystem::path& Path() const noexcept
+        {
+            return mPath;
+        }
+
+      private:
+        using SegmentHolder = std::unique_ptr<detail::MmapSegment>;
+
+        MmapFileSink(const MmapFileSink&)            = delete;
+        MmapFileSink& operator=(const MmapFileSink&) = delete;
+
+        void          Advance(detail::MmapSegment* full, std::size_t used,
+                              std::size_t needed);
+        SegmentHolder NextSegment(detail::MmapSegment& full, std::size_t end,
+                                  std::size_t needed);
+        SegmentHolder PrepareSpare(const detail::MmapSegment& active);
+        void          Commit(detail::MmapSegment* seg, std::size_t bytes);
+        void          Retire(detail::MmapSegment* seg);
+        void          Run(std::stop_token st);
+
+        std::filesystem::path mPath;
+        std::filesystem::path mNextPath; // successor file before rotation
+        MmapFileSinkOptions   mOptions;
+
+        // Active segment; replaced by the producer that fills it.
+        // Segments are owned by mSegments and only their mappings are
+        // released early, so a stale pointer a producer still holds
+        // never dangles.
+        std::atomic<detail::MmapSegment*> mSegment {nullptr};
+
+        std::mutex              mSwitchMutex;
+        std::condition_variable mSwitchCv;
+
+        // Guarded by mSwitchMutex.
+        std::vector<SegmentHolder>        mSegments;
+        SegmentHolder                     mSpare;
+        bool                              mWantSpare = false;
+        std::vector<detail::MmapSegment*> mRetired; // to sync and unmap
+
+        std::unique_ptr<detail::LogRotator> mRotator;
+
+        std::condition_variable_any mWorkCv;
+        std::jthread                mWorker;
+    };
+} // namespace SKIRNIR_NAMESPACE
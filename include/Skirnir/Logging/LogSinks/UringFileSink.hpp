@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Skirnir/Logging/LogSinks/FileSink.hpp"
+#include "Skirnir/Logging/LogSinks/ILogSink.hpp"
+#include "Skirnir/Logging/TimestampFormat.hpp"
+
+namespace SKIRNIR_NAMESPACE
+{
+    namespace detail
+    {
+        class IoUring;
+        class LogRotator;
+    } // namespace detail
+
+    /**
+     * @brief I/O tuning for @c UringFileSink.
+     */
+    struct UringFileSinkOptions
+    {
+        /** @brief Size of each staging buffer in bytes. */
+        std::size_t bufferBytes = 64 * 1024;
+
+        /**
+         * @brief Number of staging buffers. One is filled by producers
+         *        while the others are in flight; when none is free,
+         *        @c Write waits for the writer thread.
+         */
+        std::size_t bufferCount = 8;
+
+        /** @brief Maximum time a partly filled buffer is held back. */
+        std::chrono::milliseconds flushInterval {100};
+
+        /**
+         * @brief Minimum time between data syncs; 0 (the default)
+         *        never syncs. With io_uring the @c fdatasync is linked
+         *        behind the batch of writes it covers.
+         */
+        std::chrono::milliseconds syncInterval {0};
+
+        /** @brief Set to false to force the @c pwritev path. */
+        bool useIoUring = true;
+    };
+
+    /**
+     * @brief Plain-text file sink that hands batched writes to a
+     *        dedicated I/O thread.
+     *
+     *  @c Write formats the record into a staging buffer under a short
+     *  lock and returns; it only waits when every buffer is in flight.
+     *  Full buffers (and partly filled ones after @c flushInterval) are
+     *  written by a background thread: on Linux through io_uring, with
+     *  the buffers registered with the kernel, otherwise (or when the
+     *  kernel refuses io_uring) with one @c pwritev per batch.
+     *
+     *  The output format, the file hardening and the rotation options
+     *  are those of @c FileSink. Size and time limits are checked as
+     *  records are staged; the writer thread renames the file aside
+     *  and leaves shifting and compressing older copies to a
+     *  background rotator. A @c FileSinkOptions::flushPolicy hands a
+     *  partly filled buffer to the writer thread when it is due, caps
+     *  @c UringFileSinkOptions::flushInterval with its interval and,
+     *  with @c sync, follows every batch with @c fdatasync. Available
+     *  on POSIX systems only; the constructor throws elsewhere.
+     */
+    class UringFileSink final : public ILogSink
+    {
+      public:
+        explicit UringFileSink(std::filesystem::path path,
+                               FileSinkOptions       options = {},
+                               UringFileSinkOptions  io      = {});
+        ~UringFileSink() override;
+
+        void Write(const LogRecord& record) override;
+
+        /** @brief Blocks until every staged record reached the file. */
+        void Flush() override;
+
+        const std::filesystem::path& Path() const noexcept
+        {
+            return mPath;
+        }
+
+        /** @brief True when writes go through io_uring. */
+        bool UsesIoUring() const noexcept
+        {
+            return mUsesIoUring.load(std::memory_order_acquire);
+        }
+
+      private:
+        UringFileSink(const UringFileSink&)            = delete;
+        UringFileSink& operator=(const UringFileSink&) = delete;
+
+        struct Buffer
+        {
+            char*       data = nullptr;
+            std::size_t size = 0;
+        };
+
+        static constexpr std::size_t kNoBuffer = static_cast<std::size_t>(-1);
+
+        // Unit of work for the writer thread, in file order.
+        struct Job
+        {
+            enum class Kind
+            {
+                Buffer, // a sealed staging buffer
+                Large,  // a line longer than a staging buffer
+                Rotate
+            };
+
+            Kind        kind;
+            std::size_t buffer = kNoBuffer;
+            std::string text;
+        };
+
+        struct Chunk
+        {
+            const char* data;
+            std::size_t size;
+            std::size_t buffer; // registered index, or kNoBuffer
+        };
+
+        void AppendLocked(std::unique_lock<std::mutex>& lock,
+                          const std::string& line);
+        void SealLocked();
+
+        void WriterLoop(std::stop_token st);
+        void WriteJobs(std::span<const Job> jobs);
+        void WriteChunks(std::span<const Chunk> chunks);
+        void RotateFile();
+
+        std::filesystem::path mPath;
+        FileSinkOptions       mOptions;
+        UringFileSinkOptions  mIo;
+
+        // Producer side, guarded by mMutex.
+        std::mutex               mMutex;
+        std::condition_variable  mFreeCv;
+        std::condition_variable  mDoneCv;
+        TimestampFormatter       mTimestamps;
+        std::vector<Buffer>      mBuffers;
+        std::vector<std::size_t> mFree;
+        std::deque<Job>          mReady;
+        std::size_t              mFilling     = kNoBuffer;
+        std::size_t              mCurrentSize = 0;
+        std::uint64_t            mSealed      = 0;
+        std::uint64_t            mWritten     = 0;
+
+        // Set only when rotation is enabled.
+        std::chrono::system_clock::time_point mRotateAt =
+            std::chrono::system_clock::time_point::max();
+
+        std::condition_variable_any mWorkCv;
+
+        // Mirrors mRing for UsesIoUring(); cleared when the writer drops
+        // the ring.
+        std::atomic<bool> mUsesIoUring {false};
+
+        // Writer thread only.
+        std::unique_ptr<char[]>                mStorage;
+        std::unique_ptr<detail::IoUring>       mRing;
+        bool                                   mFixedBuffers = false;
+        int                                    mFd           = -1;
+        std::size_t                            mFileOffset   = 0;
+        std::chrono::steady_clock::time_point  mLastSync {};
+        std::unique_ptr<detail::LogRotator>    mRotator;
+
+        std::jthread mWriter;
+    };
+} // namespace SKIRNIR_NAMESPACE
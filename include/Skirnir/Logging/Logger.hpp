@@ -2,22 +2,30 @@
 
 #include "Skirnir/Common/Arc.hpp"
 #include "Skirnir/Common/Reflection.hpp"
+#include "Skirnir/Logging/CompiledLogLevel.hpp"
+#include "Skirnir/Logging/LogField.hpp"
 #include "Skirnir/Logging/LogLevel.hpp"
+#include "Skirnir/Logging/LogRateLimit.hpp"
 #include "Skirnir/Logging/LogRecord.hpp"
 #include "Skirnir/Logging/LogSinks/ILogSink.hpp"
 #include "Skirnir/Logging/LogSinks/AsyncSink.hpp"
-#include "Skirnir/Logging/Format.hpp"
+#include "Skirnir/Logging/MessageTemplate.hpp"
 
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <source_location>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace SKIRNIR_NAMESPACE
@@ -25,6 +33,11 @@ namespace SKIRNIR_NAMESPACE
     class ConfigurationOptions;
     class LogScope;
 
+    namespace detail
+    {
+        class LogRateLimiter;
+    } // namespace detail
+
     /**
      * @brief Configuration for the logging subsystem.
      *
@@ -71,6 +84,12 @@ namespace SKIRNIR_NAMESPACE
          */
         std::size_t asyncQueueCapacity = 8192;
 
+        /**
+         * @brief Dispatches the rate-limit summary for records suppressed
+         *        since the last one, if summaries are on.
+         */
+        ~LoggerOptions();
+
         /**
          * @brief Configures the default log level from a configuration source.
          * @param config The configuration options
@@ -80,41 +99,79 @@ namespace SKIRNIR_NAMESPACE
         void ConfigureFrom(Arc<ConfigurationOptions> config,
                            std::string_view path = "logging.logLevel.default");
 
+        /**
+         * @brief Section that @c ConfigureFrom reads for @p path: the
+         *        parent of its levels section, which also holds the
+         *        @c async and @c rateLimit options ("logging" for
+         *        "logging.logLevel.default"). Empty, meaning the whole
+         *        configuration, when @p path has fewer than three
+         *        segments.
+         */
+        static std::string ConfigurationSection(std::string_view path);
+
+        /**
+         * @brief Current level for category @p T.
+         *
+         * Equivalent to loading @c LevelSlotFor<T>(); the slot is
+         * created on first use.
+         */
         template <typename T>
         LogLevel GetLogLevelFor()
         {
-            constexpr auto typeName = refl::type_name<T>();
-            constexpr auto typeNs   = refl::type_namespace<T>();
+            return LevelSlotFor<T>().load(std::memory_order_relaxed);
+        }
 
-            std::shared_lock<std::shared_mutex> lock(mLogLevelsMutex);
+        /**
+         * @brief Atomic level slot of category @p T.
+         *
+         * Each category is resolved once against the default level and
+         * the per-namespace overrides; @c ConfigureFrom and
+         * @c SetLogLevel re-resolve every slot in place, so loggers that
+         * keep a pointer to their slot see level changes immediately.
+         * Slots live as long as this @c LoggerOptions.
+         */
+        template <typename T>
+        const std::atomic<LogLevel>& LevelSlotFor()
+        {
+            return AcquireLevelSlot(refl::type_name<T>(),
+                                    refl::type_namespace<T>());
+        }
 
-            auto it = mLogLevels.find(std::string(typeName));
-            if (it != mLogLevels.end())
-            {
-                return it->second;
-            }
+        /**
+         * @brief Sets the default level and updates every live logger
+         *        that has no more specific override.
+         */
+        void SetLogLevel(LogLevel level);
 
-            it = mLogLevels.find(std::string(typeNs));
-            if (it != mLogLevels.end())
-            {
-                return it->second;
-            }
+        /**
+         * @brief Overrides the level of a category, given as a type name
+         *        (e.g. @c "my_app::Repository") or a namespace (e.g.
+         *        @c "my_app::services"), and updates live loggers.
+         */
+        void SetLogLevel(std::string_view category, LogLevel level);
 
-            // Check for partial matches (e.g., if namespaceValue is
-            // "MyApp.Services" check for "MyApp")
-            for (const auto& [key, level] : mLogLevels)
-            {
-                if (typeNs.size() > key.size() &&
-                    typeNs.compare(0, key.size(), key) == 0 &&
-                    typeNs[key.size()] == '.')
-                {
-                    return level;
-                }
-            }
+        // ----- Rate limiting ------------------------------------------
+
+        /**
+         * @brief Limits how many records each call site may dispatch.
+         *        Takes effect immediately for every logger; pass a
+         *        default @c LogRateLimit to turn limiting off.
+         */
+        void SetRateLimit(const LogRateLimit& limit);
+
+        /** @brief The limit last set in code or by @c ConfigureFrom. */
+        LogRateLimit RateLimit() const;
 
-            return logLevel;
+        /// @cond INTERNAL
+        bool RateLimitEnabled() const noexcept
+        {
+            return mRateLimitEnabled.load(std::memory_order_acquire);
         }
 
+        // False when the record from @p site should be dropped.
+        bool AdmitCallSite(LogLevel lvl, const std::source_location& site);
+        /// @endcond
+
         // ----- Sink management ----------------------------------------
 
         /**
@@ -152,16 +209,42 @@ namespace SKIRNIR_NAMESPACE
         Arc<LogScope> BeginScope(std::string name);
 
         /// @cond INTERNAL
-        void                     PushScope(std::string name);
-        void                     PopScope();
-        std::vector<std::string> CurrentScopes() const;
+        void          PushScope(std::string name);
+        void          PopScope();
+        LogScopeChain CurrentScopes() const noexcept;
         /// @endcond
 
       private:
+        struct LevelSlot
+        {
+            LevelSlot(std::string ns, LogLevel initial) :
+                typeNamespace(std::move(ns)), level(initial)
+            {
+            }
+
+            std::string           typeNamespace;
+            std::atomic<LogLevel> level;
+        };
+
         void PublishSinks();
+        void DispatchRateLimitSummary();
+
+        const std::atomic<LogLevel>& AcquireLevelSlot(std::string_view typeName,
+                                                      std::string_view typeNs);
+        LogLevel ResolveLogLevel(std::string_view typeName,
+                                 std::string_view typeNs) const;
+        void     RefreshLevelSlots();
+
+        // Overrides and slots are guarded by mLogLevelsMutex. Map nodes
+        // never move, so the address of a slot is stable for the
+        // lifetime of this object.
+        std::map<std::string, LogLevel, std::less<>>  mLogLevels;
+        std::map<std::string, LevelSlot, std::less<>> mLevelSlots;
+        mutable std::shared_mutex                     mLogLevelsMutex;
+
+        // Value of @c logLevel the slots were last resolved against.
+        LogLevel mResolvedDefault = logLevel;
 
-        std::map<std::string, LogLevel> mLogLevels;
-        mutable std::shared_mutex       mLogLevelsMutex;
         mutable std::mutex              mSinksMutex;
         std::vector<Arc<ILogSink>>      mSinks;
         std::once_flag                  mDefaultSinkFlag;
@@ -172,6 +255,17 @@ namespace SKIRNIR_NAMESPACE
         // contention and a vector copy on every log call.
         std::shared_ptr<const std::vector<Arc<ILogSink>>> mSinkSnapshot;
         std::atomic<bool> mSinkSnapshotDirty {true};
+
+        // Created on the first SetRateLimit; loggers skip it entirely
+        // while mRateLimitEnabled is false.
+        std::shared_ptr<detail::LogRateLimiter> mRateLimiter;
+        std::atomic<bool>                       mRateLimitEnabled {false};
+        mutable std::mutex                      mRateLimitMutex;
+
+        // Dispatches the suppression summary every summaryInterval while
+        // a limit with a summary is set. Declared last so it stops
+        // before anything it uses is destroyed.
+        std::jthread mSummaryTimer;
     };
 
     class ILogger
@@ -182,58 +276,125 @@ namespace SKIRNIR_NAMESPACE
     class Logger : public ILogger
     {
       public:
+        /**
+         * @brief Compile-time floor for this category (see
+         *        @c CompiledLogLevelFor). Calls below it are not compiled in.
+         */
+        static constexpr LogLevel CompiledLevel = CompiledLogLevelFor<T>;
+
         Logger(Arc<LoggerOptions> loggerOptions) :
-            mLoggerOptions(std::move(loggerOptions))
+            mLoggerOptions(std::move(loggerOptions)),
+            mLogLevel(&mLoggerOptions->LevelSlotFor<T>())
         {
-            mLogLevel = mLoggerOptions->GetLogLevelFor<T>();
+        }
+
+        /**
+         * @brief True when calls at @p lvl survive compilation. @c Fatal is
+         *        never elided because @c LogFatal must still throw.
+         */
+        static constexpr bool IsCompiledIn(LogLevel lvl) noexcept
+        {
+            return lvl == LogLevel::Fatal ||
+                   (lvl != LogLevel::None && lvl >= CompiledLevel);
+        }
+
+        /**
+         * @brief True when a record at @p lvl would be dispatched. Use it
+         *        to guard expensive argument computation.
+         */
+        bool IsEnabled(LogLevel lvl) const noexcept
+        {
+            return IsCompiledIn(lvl) &&
+                   mLogLevel->load(std::memory_order_relaxed) <= lvl;
         }
 
         template <typename... TArgs>
-        inline void LogTrace(detail::FormatString<TArgs...> fmt, TArgs&&... args)
+        inline void LogTrace(MessageTemplate<TArgs...> fmt, TArgs&&... args)
         {
-            DispatchImpl(LogLevel::Trace, std::source_location::current(), fmt,
-                         std::forward<TArgs>(args)...);
+            if constexpr (IsCompiledIn(LogLevel::Trace))
+            {
+                DispatchImpl(LogLevel::Trace,
+                             fmt.Location(), {}, fmt,
+                             std::forward<TArgs>(args)...);
+            }
         }
 
         template <typename... TArgs>
-        inline void LogDebug(detail::FormatString<TArgs...> fmt, TArgs&&... args)
+        inline void LogDebug(MessageTemplate<TArgs...> fmt, TArgs&&... args)
         {
-            DispatchImpl(LogLevel::Debug, std::source_location::current(), fmt,
-                         std::forward<TArgs>(args)...);
+            if constexpr (IsCompiledIn(LogLevel::Debug))
+            {
+                DispatchImpl(LogLevel::Debug,
+                             fmt.Location(), {}, fmt,
+                             std::forward<TArgs>(args)...);
+            }
         }
 
         template <typename... TArgs>
-        inline void LogInformation(detail::FormatString<TArgs...> fmt,
+        inline void LogInformation(MessageTemplate<TArgs...> fmt,
                                    TArgs&&... args)
         {
-            DispatchImpl(LogLevel::Information, std::source_location::current(),
-                         fmt, std::forward<TArgs>(args)...);
+            if constexpr (IsCompiledIn(LogLevel::Information))
+            {
+                DispatchImpl(LogLevel::Information,
+                             fmt.Location(), {}, fmt,
+                             std::forward<TArgs>(args)...);
+            }
         }
 
         template <typename... TArgs>
-        inline void LogWarning(detail::FormatString<TArgs...> fmt,
+        inline void LogWarning(MessageTemplate<TArgs...> fmt,
                                TArgs&&... args)
         {
-            DispatchImpl(LogLevel::Warning, std::source_location::current(),
-                         fmt, std::forward<TArgs>(args)...);
+            if constexpr (IsCompiledIn(LogLevel::Warning))
+            {
+                DispatchImpl(LogLevel::Warning,
+                             fmt.Location(), {}, fmt,
+                             std::forward<TArgs>(args)...);
+            }
+        }
+
+        template <typename... TArgs>
+        inline void LogError(MessageTemplate<TArgs...> fmt, TArgs&&... args)
+        {
+            if constexpr (IsCompiledIn(LogLevel::Error))
+            {
+                DispatchImpl(LogLevel::Error,
+                             fmt.Location(), {}, fmt,
+                             std::forward<TArgs>(args)...);
+            }
         }
 
         template <typename... TArgs>
-        inline void LogError(detail::FormatString<TArgs...> fmt, TArgs&&... args)
+        inline void LogFatal(MessageTemplate<TArgs...> fmt, TArgs&&... args)
         {
-            DispatchImpl(LogLevel::Error, std::source_location::current(), fmt,
+            DispatchImpl(LogLevel::Fatal, fmt.Location(), {}, fmt,
                          std::forward<TArgs>(args)...);
         }
 
+        /**
+         * @brief Logs at @p lvl with structured @p fields attached:
+         *
+         *  @code
+         *  logger->Log(LogLevel::Information,
+         *              {{"user_id", 42}, {"ip", "1.2.3.4"}}, "user_login");
+         *  @endcode
+         *
+         *  The level is checked at run time, so calls below the
+         *  compiled floor are dropped but not compiled out.
+         */
         template <typename... TArgs>
-        inline void LogFatal(detail::FormatString<TArgs...> fmt, TArgs&&... args)
+        inline void Log(LogLevel lvl, LogFields fields,
+                        MessageTemplate<TArgs...> fmt, TArgs&&... args)
         {
-            DispatchImpl(LogLevel::Fatal, std::source_location::current(), fmt,
+            if (!IsCompiledIn(lvl))
+                return;
+            DispatchImpl(lvl, fmt.Location(), std::move(fields), fmt,
                          std::forward<TArgs>(args)...);
         }
 
         template <typename... TArgs>
-        inline void Assert(bool assertion, detail::FormatString<TArgs...> fmt,
+        inline void Assert(bool assertion, MessageTemplate<TArgs...> fmt,
                            TArgs&&... args)
         {
 #ifndef NDEBUG
@@ -248,32 +409,43 @@ namespace SKIRNIR_NAMESPACE
         template <typename... TArgs>
         inline void DispatchImpl(LogLevel             lvl,
                                  std::source_location loc,
-                                 detail::FormatString<TArgs...> fmt,
+                                 LogFields            fields,
+                                 MessageTemplate<TArgs...> fmt,
                                  TArgs&&... args)
         {
-            if (mLogLevel > lvl)
+            if (mLogLevel->load(std::memory_order_relaxed) > lvl)
+                return;
+            // Checked before formatting, so a suppressed record costs a
+            // table lookup and a couple of atomics.
+            if (lvl != LogLevel::Fatal && mLoggerOptions->RateLimitEnabled() &&
+                !mLoggerOptions->AdmitCallSite(lvl, loc))
                 return;
-
-            std::string message =
-                detail::Format(fmt, std::forward<TArgs>(args)...);
 
             LogRecord record;
             record.level     = lvl;
             record.timestamp = std::chrono::system_clock::now();
-            record.category.assign(refl::type_name<T>());
-            record.message = std::move(message);
-            record.scopes  = mLoggerOptions->CurrentScopes();
+            record.category  = Category;
+            fmt.Render(record.message, record.properties,
+                       std::forward<TArgs>(args)...);
+            record.scopes = mLoggerOptions->CurrentScopes();
+            record.fields   = std::move(fields);
+            record.location = loc;
 
             mLoggerOptions->Dispatch(record);
 
             if (lvl == LogLevel::Fatal)
             {
-                throw std::runtime_error(record.message);
+                throw std::runtime_error(record.message.Str());
             }
         }
 
-        LogLevel           mLogLevel;
+        // Reflected names live in static storage, so records can refer
+        // to them without copying.
+        static constexpr std::string_view Category = refl::type_name<T>();
+
         Arc<LoggerOptions> mLoggerOptions;
+        // Owned by mLoggerOptions; updated in place on reconfiguration.
+        const std::atomic<LogLevel>* mLogLevel;
     };
 
 } // namespace SKIRNIR_NAMESPACE
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "Skirnir/Configuration/ConfigurationMonitor.hpp"
+#include "Skirnir/Configuration/ConfigurationOptions.hpp"
 #include "Skirnir/DependencyInjection/Extension.hpp"
 #include "Skirnir/Logging/LogRecord.hpp"
 #include "Skirnir/Logging/LogSinks.hpp"
 #include "Skirnir/Logging/Logger.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <filesystem>
 #include <functional>
+#include <optional>
+#include <span>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -52,6 +58,21 @@ namespace SKIRNIR_NAMESPACE
             return *this;
         }
 
+        /**
+         * @brief Adds a @c FileSink with rotation and flush options, e.g.
+         *        a @c FlushPolicy for group-commit flushing.
+         */
+        LoggingExtension& AddFileSink(std::filesystem::path path,
+                                      FileSinkOptions       options)
+        {
+            mSinkBuilders.emplace_back(
+                [path = std::move(path),
+                 options = std::move(options)](Arc<LoggerOptions> o) {
+                    o->AddSink(MakeArc<FileSink>(path, options));
+                });
+            return *this;
+        }
+
         LoggingExtension& AddJsonSink(std::filesystem::path path)
         {
             mSinkBuilders.emplace_back(
@@ -61,12 +82,59 @@ namespace SKIRNIR_NAMESPACE
             return *this;
         }
 
+        LoggingExtension& AddJsonSink(std::filesystem::path path,
+                                      FileSinkOptions       options)
+        {
+            mSinkBuilders.emplace_back(
+                [path = std::move(path),
+                 options = std::move(options)](Arc<LoggerOptions> o) {
+                    o->AddSink(MakeArc<JsonSink>(path, options));
+                });
+            return *this;
+        }
+
         LoggingExtension& WithAsyncQueue(std::size_t capacity = 8192)
         {
             mWrapAsync = capacity;
             return *this;
         }
 
+        /**
+         * @brief Wraps the configured sinks in a @c BufferedSink, so each
+         *        producing thread appends to its own buffer and records
+         *        are written in batches by a background flusher.
+         *
+         * Takes precedence over @c WithAsyncQueue, which would only add
+         * a second hand-off. Each thread's buffer costs about 600 bytes
+         * per slot; see @c BufferedSink.
+         */
+        LoggingExtension& WithThreadBuffers(
+            std::size_t               perThreadCapacity = 256,
+            std::chrono::milliseconds flushInterval =
+                std::chrono::milliseconds(100))
+        {
+            mThreadBuffers = ThreadBufferSettings {perThreadCapacity,
+                                                   flushInterval};
+            return *this;
+        }
+
+        /**
+         * @brief Applies @c LoggerOptions::ConfigureFrom with @p path to
+         *        the registered configuration.
+         *
+         * With @c ApplicationBuilder::WithConfigurationReload, it is
+         * applied again whenever a key under
+         * @c LoggerOptions::ConfigurationSection(path) changes, and only
+         * then; that covers the levels as well as the @c async and
+         * @c rateLimit options.
+         */
+        LoggingExtension& ConfigureFrom(
+            std::string path = "logging.logLevel.default")
+        {
+            mConfigurePath = std::move(path);
+            return *this;
+        }
+
         void ConfigureServices(ServiceCollection& sc) override
         {
             // Ensure LoggerOptions exists.
@@ -79,11 +147,22 @@ namespace SKIRNIR_NAMESPACE
         void UseServices(ServiceProvider& sp) override
         {
             auto options = sp.GetService<LoggerOptions>();
+            if (mConfigurePath)
+                FollowConfiguration(sp, options);
             for (auto& builder : mSinkBuilders)
             {
                 builder(options);
             }
-            if (mWrapAsync)
+            if (mThreadBuffers)
+            {
+                std::vector<Arc<ILogSink>> current = options->Sinks();
+                options->ClearSinks();
+                auto inner = MakeArc<CompositeSink>(std::move(current));
+                options->AddSink(MakeArc<BufferedSink>(
+                    std::move(inner), mThreadBuffers->perThreadCapacity,
+                    mThreadBuffers->flushInterval));
+            }
+            else if (mWrapAsync)
             {
                 std::vector<Arc<ILogSink>> current = options->Sinks();
                 options->ClearSinks();
@@ -94,6 +173,25 @@ namespace SKIRNIR_NAMESPACE
         }
 
       private:
+        void FollowConfiguration(ServiceProvider&          sp,
+                                 const Arc<LoggerOptions>& options)
+        {
+            const std::string path = *mConfigurePath;
+            options->ConfigureFrom(sp.GetService<ConfigurationOptions>(),
+                                   path);
+
+            auto monitor = sp.TryGetService<ConfigurationMonitor>();
+            if (!monitor)
+                return;
+            WeakArc<LoggerOptions> weak = options;
+            (*monitor)->Subscribe(
+                LoggerOptions::ConfigurationSection(path),
+                [weak, path](const Arc<ConfigurationOptions>& config) {
+                    if (auto self = weak.lock())
+                        self->ConfigureFrom(config, path);
+                });
+        }
+
         class CompositeSink final : public ILogSink
         {
           public:
@@ -106,6 +204,11 @@ namespace SKIRNIR_NAMESPACE
                 for (auto& s : mSinks)
                     s->Write(r);
             }
+            void WriteBatch(std::span<const LogRecord> records) override
+            {
+                for (auto& s : mSinks)
+                    s->WriteBatch(records);
+            }
             void Flush() override
             {
                 for (auto& s : mSinks)
@@ -116,7 +219,15 @@ namespace SKIRNIR_NAMESPACE
             std::vector<Arc<ILogSink>> mSinks;
         };
 
+        struct ThreadBufferSettings
+        {
+            std::size_t               perThreadCapacity;
+            std::chrono::milliseconds flushInterval;
+        };
+
         std::vector<std::function<void(Arc<LoggerOptions>)>> mSinkBuilders;
         std::optional<std::size_t>                           mWrapAsync;
+        std::optional<ThreadBufferSettings>                  mThreadBuffers;
+        std::optional<std::string>                           mConfigurePath;
     };
 } // namespace SKIRNIR_NAMESPACE
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "Skirnir/Logging/Format.hpp"
+#include "Skirnir/Logging/LogMessage.hpp"
+#include "Skirnir/Logging/LogProperties.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace SKIRNIR_NAMESPACE
+{
+    namespace detail
+    {
+        // Deliberately not constexpr: reaching it while a template is
+        // checked at compile time turns the message into an error.
+        inline void MessageTemplateError(const char*)
+        {
+        }
+
+        constexpr bool IsTemplateNameStart(char c) noexcept
+        {
+            return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                   c == '_';
+        }
+
+        constexpr bool IsTemplateNameChar(char c) noexcept
+        {
+            return IsTemplateNameStart(c) || (c >= '0' && c <= '9');
+        }
+    } // namespace detail
+
+    /**
+     * @brief Format string of the @c Log* methods, checked at compile
+     *        time. Accepts ordinary format strings and message
+     *        templates with named placeholders.
+     *
+     * A template names every placeholder, optionally followed by a
+     * format spec:
+     *
+     * @code
+     * logger.LogInformation("user {UserId} took {Elapsed:.1f} ms", id, ms);
+     * @endcode
+     *
+     * The message is rendered as if the names were not there
+     * (@c "user {} took {:.1f} ms"), and each argument is also captured
+     * as a typed property of the record under its placeholder name.
+     * Named and positional placeholders cannot be mixed, and the number
+     * of names must match the number of arguments. Format strings
+     * without names behave exactly as before and capture nothing.
+     *
+     * The template also records the source location it was written
+     * at, which identifies the call site of the @c Log* method.
+     */
+    template <typename... TArgs>
+    class BasicMessageTemplate
+    {
+      public:
+        template <typename S>
+            requires std::convertible_to<const S&, std::string_view>
+        consteval BasicMessageTemplate(
+            const S&             text,
+            std::source_location location = std::source_location::current()) :
+            mText(text), mLocation(location), mNamed(Scan(mText, mNames)),
+            mFormat(mNamed ? std::string_view {} : mText)
+        {
+            if (mNamed)
+            {
+                // Checks the specs against the argument types.
+                const std::string pattern = Strip();
+                detail::FormatString<TArgs...> check(
+                    std::string_view {pattern});
+                (void)check;
+            }
+        }
+
+        /** @brief The template as written. */
+        std::string_view Text() const noexcept
+        {
+            return mText;
+        }
+
+        /** @brief Where the template was written (the call site). */
+        const std::source_location& Location() const noexcept
+        {
+            return mLocation;
+        }
+
+        /** @brief True when the placeholders are named. */
+        bool IsNamed() const noexcept
+        {
+            return mNamed;
+        }
+
+        /**
+         * @brief Name of placeholder @p i. The view points into the
+         *        template literal.
+         */
+        std::string_view Name(std::size_t i) const noexcept
+        {
+            return mText.substr(mNames[i].begin,
+                                mNames[i].end - mNames[i].begin);
+        }
+
+        /**
+         * @brief Formats the arguments into @p message and, for a named
+         *        template, captures them into @p properties.
+         */
+        template <std::size_t N>
+        void Render(BasicLogBuffer<N>& message, LogProperties& properties,
+                    TArgs&&... args) const
+        {
+            if (!mNamed)
+            {
+                message.Format(mFormat, std::forward<TArgs>(args)...);
+                return;
+            }
+
+            // Names are removed from the pattern, so it never grows.
+            char        stack[256];
+            std::string heap;
+            char*       out = stack;
+            if (mText.size() > sizeof(stack))
+            {
+                heap.resize(mText.size());
+                out = heap.data();
+            }
+            const std::size_t size = StripTo(out);
+
+            message.Format(detail::RuntimeFormat<TArgs...>(
+                               std::string_view(out, size)),
+                           std::forward<TArgs>(args)...);
+
+            [[maybe_unused]] std::size_t i = 0;
+            (properties.Capture(Name(i++), args), ...);
+        }
+
+      private:
+        struct NameRange
+        {
+            std::uint32_t begin = 0;
+            std::uint32_t end   = 0;
+        };
+
+        using Names = std::array<NameRange, sizeof...(TArgs)>;
+
+        // Records the name of each placeholder and reports whether the
+        // template uses names. Malformed braces are left to the format
+        // string check.
+        static consteval bool Scan(std::string_view text, Names& names)
+        {
+            bool        named      = false;
+            bool        positional = false;
+            bool        nested     = false;
+            std::size_t count      = 0;
+
+            std::size_t i = 0;
+            while (i < text.size())
+            {
+                if (text[i] != '{')
+                {
+                    ++i;
+                    continue;
+                }
+                if (i + 1 < text.size() && text[i + 1] == '{')
+                {
+                    i += 2;
+                    continue;
+                }
+
+                const std::size_t nameBegin = i + 1;
+                std::size_t       nameEnd   = nameBegin;
+                while (nameEnd < text.size() &&
+                       detail::IsTemplateNameChar(text[nameEnd]))
+                    ++nameEnd;
+                const bool isName =
+                    nameEnd > nameBegin &&
+                    detail::IsTemplateNameStart(text[nameBegin]);
+
+                std::size_t end   = nameEnd;
+                int         depth = 1;
+                while (end < text.size() && depth > 0)
+                {
+                    if (text[end] == '{')
+                    {
+                        ++depth;
+                        nested = true;
+                    }
+                    else if (text[end] == '}')
+                        --depth;
+                    ++end;
+                }
+                if (depth != 0)
+                    return false;
+
+                if (isName)
+                {
+                    named = true;
+                    if (count < names.size())
+                    {
+                        names[count] = {static_cast<std::uint32_t>(nameBegin),
+                                        static_cast<std::uint32_t>(nameEnd)};
+                    }
+                }
+                else
+                    positional = true;
+                ++count;
+                i = end;
+            }
+
+            if (!named)
+                return false;
+            if (positional)
+            {
+                detail::MessageTemplateError(
+                    "named and positional placeholders cannot be mixed");
+            }
+            if (nested)
+            {
+                detail::MessageTemplateError(
+                    "named placeholders cannot use nested replacement fields");
+            }
+            if (count != sizeof...(TArgs))
+            {
+                detail::MessageTemplateError(
+                    "the number of named placeholders must match the "
+                    "number of arguments");
+            }
+            return true;
+        }
+
+        // Writes the template without placeholder names to @p out and
+        // returns the length.
+        constexpr std::size_t StripTo(char* out) const
+        {
+            std::size_t written = 0;
+            std::size_t from    = 0;
+            for (const NameRange& name : mNames)
+            {
+                for (std::size_t i = from; i < name.begin; ++i)
+                    out[written++] = mText[i];
+                from = name.end;
+            }
+            for (std::size_t i = from; i < mText.size(); ++i)
+                out[written++] = mText[i];
+            return written;
+        }
+
+        consteval std::string Strip() const
+        {
+            std::string pattern(mText.size(), '\0');
+            pattern.resize(StripTo(pattern.data()));
+            return pattern;
+        }
+
+        std::string_view               mText;
+        std::source_location           mLocation;
+        Names                          mNames {};
+        bool                           mNamed;
+        detail::FormatString<TArgs...> mFormat;
+    };
+
+    /**
+     * @brief Parameter type of the @c Log* methods; like
+     *        @c std::format_string, it does not take part in deducing
+     *        the argument types.
+     */
+    template <typename... TArgs>
+    using MessageTemplate = BasicMessageTemplate<std::type_identity_t<TArgs>...>;
+} // namespace SKIRNIR_NAMESPACE
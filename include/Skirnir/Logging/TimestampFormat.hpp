@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Skirnir/Common/Namespace.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Layout of the timestamp written by text sinks. All styles
+     *        are in UTC.
+     */
+    enum class TimestampStyle
+    {
+        /** @brief @c "2025-03-12 21:55:19.650921540", same as @c {:%F %T}. */
+        Default,
+        /** @brief @c "2025-03-12T21:55:19.650921540Z". */
+        Iso8601,
+        /** @brief Seconds since the Unix epoch: @c "1741816519.650921540". */
+        Epoch
+    };
+
+    /**
+     * @brief Timestamp options for @c ConsoleSink and @c FileSink.
+     */
+    struct TimestampFormat
+    {
+        TimestampStyle style = TimestampStyle::Default;
+
+        /**
+         * @brief Number of fractional-second digits, 0 to 9. Negative
+         *        (the default) uses the clock's native precision, which
+         *        is what @c std::format prints for @c {:%T}.
+         */
+        int fractionalDigits = -1;
+    };
+
+    /**
+     * @brief Formats timestamps without going through chrono formatting.
+     *
+     * The text up to the seconds is cached and only rebuilt when the
+     * second changes (the date only when the day changes), so
+     * consecutive records cost a few integer-to-digit conversions.
+     *
+     * Not thread-safe; sinks keep one per instance and use it under
+     * their own lock.
+     */
+    class TimestampFormatter
+    {
+      public:
+        explicit TimestampFormatter(TimestampFormat format = {}) noexcept;
+
+        /**
+         * @brief Formats @p tp. The view stays valid until the next call.
+         */
+        std::string_view Format(std::chrono::system_clock::time_point tp);
+
+        const TimestampFormat& Options() const noexcept
+        {
+            return mFormat;
+        }
+
+      private:
+        void RebuildSeconds(std::int64_t seconds);
+
+        TimestampFormat mFormat;
+        int             mDigits;
+
+        bool         mHasCache      = false;
+        std::int64_t mCachedSeconds = 0;
+        std::int64_t mCachedDay     = 0;
+        std::size_t  mPrefixSize    = 0;
+        char         mBuffer[64]    = {};
+    };
+} // namespace SKIRNIR_NAMESPACE
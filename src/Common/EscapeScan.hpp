@@ -0,0 +1,290 @@
+#pragma once
+
+#include "Skirnir/Common/Namespace.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                   \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <immintrin.h>
+#  define SKIRNIR_ESCAPE_SCAN_SSE2 1
+#  if defined(__AVX2__)
+#    define SKIRNIR_ESCAPE_SCAN_AVX2 1
+#    define SKIRNIR_ESCAPE_SCAN_AVX2_TARGET
+#  elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// Built without -mavx2: compile the AVX2 loop for that target only and
+// pick it at run time when the CPU supports it.
+#    define SKIRNIR_ESCAPE_SCAN_AVX2 1
+#    define SKIRNIR_ESCAPE_SCAN_AVX2_DISPATCH 1
+#    define SKIRNIR_ESCAPE_SCAN_AVX2_TARGET __attribute__((target("avx2")))
+#  endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define SKIRNIR_ESCAPE_SCAN_NEON 1
+#endif
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /**
+     * @brief Byte classes that need escaping, per output format.
+     *
+     *  - @c LogText:         C0 controls and DEL (plain-text sinks).
+     *  - @c LogTextKeepTabs: as above, but a tab passes through.
+     *  - @c Json:            C0 controls, '"' and '\\'.
+     */
+    enum class EscapeSet
+    {
+        LogText,
+        LogTextKeepTabs,
+        Json
+    };
+
+    template <EscapeSet Set>
+    constexpr bool NeedsEscape(unsigned char c) noexcept
+    {
+        if constexpr (Set == EscapeSet::Json)
+            return c < 0x20 || c == '"' || c == '\\';
+        else if constexpr (Set == EscapeSet::LogTextKeepTabs)
+            return (c < 0x20 && c != '\t') || c == 0x7f;
+        else
+            return c < 0x20 || c == 0x7f;
+    }
+
+    template <EscapeSet Set>
+    inline std::size_t FindFirstEscapeScalar(const char* data,
+                                             std::size_t size) noexcept
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (NeedsEscape<Set>(static_cast<unsigned char>(data[i])))
+                return i;
+        }
+        return size;
+    }
+
+#if defined(SKIRNIR_ESCAPE_SCAN_SSE2)
+    template <EscapeSet Set>
+    inline std::size_t FindFirstEscapeSse2(const char* data,
+                                           std::size_t size) noexcept
+    {
+        std::size_t   i          = 0;
+        const __m128i controlMax = _mm_set1_epi8(0x1f);
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            // Unsigned v <= 0x1f  <=>  max(v, 0x1f) == 0x1f.
+            __m128i hit =
+                _mm_cmpeq_epi8(_mm_max_epu8(v, controlMax), controlMax);
+            if constexpr (Set == EscapeSet::Json)
+            {
+                hit = _mm_or_si128(hit,
+                                   _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+                hit = _mm_or_si128(hit,
+                                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+            }
+            else
+            {
+                if constexpr (Set == EscapeSet::LogTextKeepTabs)
+                {
+                    hit = _mm_andnot_si128(
+                        _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), hit);
+                }
+                hit = _mm_or_si128(hit,
+                                   _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)));
+            }
+            const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+            if (mask)
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+        return i + FindFirstEscapeScalar<Set>(data + i, size - i);
+    }
+#endif
+
+#if defined(SKIRNIR_ESCAPE_SCAN_AVX2)
+    /** @brief 32 bytes per step; a shorter tail goes through SSE2. */
+    template <EscapeSet Set>
+    SKIRNIR_ESCAPE_SCAN_AVX2_TARGET inline std::size_t
+    FindFirstEscapeAvx2(const char* data, std::size_t size) noexcept
+    {
+        std::size_t   i          = 0;
+        const __m256i controlMax = _mm256_set1_epi8(0x1f);
+        for (; i + 32 <= size; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + i));
+            // Unsigned v <= 0x1f  <=>  max(v, 0x1f) == 0x1f.
+            __m256i hit =
+                _mm256_cmpeq_epi8(_mm256_max_epu8(v, controlMax), controlMax);
+            if constexpr (Set == EscapeSet::Json)
+            {
+                hit = _mm256_or_si256(
+                    hit, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+                hit = _mm256_or_si256(
+                    hit, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+            }
+            else
+            {
+                if constexpr (Set == EscapeSet::LogTextKeepTabs)
+                {
+                    hit = _mm256_andnot_si256(
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')), hit);
+                }
+                hit = _mm256_or_si256(
+                    hit, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f)));
+            }
+            const auto mask =
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask)
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+        return i + FindFirstEscapeSse2<Set>(data + i, size - i);
+    }
+#endif
+
+#if defined(SKIRNIR_ESCAPE_SCAN_AVX2_DISPATCH)
+    /** @brief Whether the running CPU supports AVX2; probed once. */
+    inline bool CpuHasAvx2() noexcept
+    {
+        static const bool has = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return has;
+    }
+#endif
+
+#if defined(SKIRNIR_ESCAPE_SCAN_NEON)
+    template <EscapeSet Set>
+    inline std::size_t FindFirstEscapeNeon(const char* data,
+                                           std::size_t size) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            const uint8x16_t v =
+                vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i));
+            uint8x16_t hit = vcltq_u8(v, vdupq_n_u8(0x20));
+            if constexpr (Set == EscapeSet::Json)
+            {
+                hit = vorrq_u8(hit, vceqq_u8(v, vdupq_n_u8('"')));
+                hit = vorrq_u8(hit, vceqq_u8(v, vdupq_n_u8('\\')));
+            }
+            else
+            {
+                if constexpr (Set == EscapeSet::LogTextKeepTabs)
+                    hit = vbicq_u8(hit, vceqq_u8(v, vdupq_n_u8('\t')));
+                hit = vorrq_u8(hit, vceqq_u8(v, vdupq_n_u8(0x7f)));
+            }
+            // Narrow each byte to a nibble: a 64-bit mask, 4 bits per lane.
+            const std::uint64_t mask = vget_lane_u64(
+                vreinterpret_u64_u8(
+                    vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)),
+                0);
+            if (mask)
+                return i + static_cast<std::size_t>(std::countr_zero(mask) / 4);
+        }
+        return i + FindFirstEscapeScalar<Set>(data + i, size - i);
+    }
+#endif
+
+    /**
+     * @brief Index of the first byte of @p data that needs escaping
+     *        under @p Set, or @p size when the input is clean.
+     *
+     *  Scans 32 (AVX2) or 16 (SSE2, NEON) bytes per step; the tail and
+     *  targets without SIMD use the scalar loop. On x86 the AVX2 loop is
+     *  used when the build targets AVX2 (-mavx2, /arch:AVX2). Otherwise
+     *  GCC and Clang builds check the CPU at run time and fall back to
+     *  SSE2. MSVC builds without /arch:AVX2 always use SSE2.
+     */
+    template <EscapeSet Set>
+    inline std::size_t FindFirstEscape(const char* data,
+                                       std::size_t size) noexcept
+    {
+#if defined(SKIRNIR_ESCAPE_SCAN_AVX2_DISPATCH)
+        if (size >= 32 && CpuHasAvx2())
+            return FindFirstEscapeAvx2<Set>(data, size);
+        return FindFirstEscapeSse2<Set>(data, size);
+#elif defined(SKIRNIR_ESCAPE_SCAN_AVX2)
+        return FindFirstEscapeAvx2<Set>(data, size);
+#elif defined(SKIRNIR_ESCAPE_SCAN_SSE2)
+        return FindFirstEscapeSse2<Set>(data, size);
+#elif defined(SKIRNIR_ESCAPE_SCAN_NEON)
+        return FindFirstEscapeNeon<Set>(data, size);
+#else
+        return FindFirstEscapeScalar<Set>(data, size);
+#endif
+    }
+
+    /**
+     * @brief Copies @p s into @p out, escaping the bytes selected by
+     *        @p Set via @p escape(out, byte).
+     *
+     *  Clean runs are appended with a single bulk copy each, so a string
+     *  with nothing to escape costs one scan and one append.
+     */
+    template <EscapeSet Set, typename TOut, typename EscapeFn>
+    inline void AppendEscaped(TOut& out, const char* data, std::size_t size,
+                              EscapeFn&& escape)
+    {
+        std::size_t start = 0;
+        while (start < size)
+        {
+            const std::size_t hit =
+                start + FindFirstEscape<Set>(data + start, size - start);
+            if (hit > start)
+                out.append(data + start, hit - start);
+            if (hit == size)
+                break;
+            escape(out, static_cast<unsigned char>(data[hit]));
+            start = hit + 1;
+        }
+    }
+
+    inline constexpr char HexDigitsLower[] = "0123456789abcdef";
+
+    /**
+     * @brief Appends the JSON escape sequence for @p c, one of the
+     *        bytes selected by @c EscapeSet::Json.
+     */
+    inline void AppendJsonEscape(std::string& out, unsigned char c)
+    {
+        switch (c)
+        {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+            {
+                const char hex[6] = {'\\', 'u', '0', '0',
+                                     HexDigitsLower[c >> 4],
+                                     HexDigitsLower[c & 0xf]};
+                out.append(hex, sizeof(hex));
+                break;
+            }
+        }
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
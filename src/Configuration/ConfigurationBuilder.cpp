@@ -1,12 +1,15 @@
 #include "Skirnir/Common/Arc.hpp"
 #include "Skirnir/Configuration/ConfigurationBuilder.hpp"
 
+#include "Skirnir/Configuration/ConfigurationMonitor.hpp"
 #include "Skirnir/Configuration/ConfigurationOptions.hpp"
 #include "Skirnir/Configuration/EnvironmentVariablesSource.hpp"
 #include "Skirnir/Configuration/InMemorySource.hpp"
 #include "Skirnir/Configuration/JsonFileSource.hpp"
 #include "Skirnir/Configuration/JsonStringSource.hpp"
 
+#include "ConfigurationIndex.hpp"
+#include "ConfigurationSnapshot.hpp"
 #include "Detail.hpp"
 
 namespace SKIRNIR_NAMESPACE
@@ -18,6 +21,13 @@ namespace SKIRNIR_NAMESPACE
         return *this;
     }
 
+    ConfigurationBuilder& ConfigurationBuilder::AddJsonFile(
+        const std::filesystem::path& path, JsonFileSourceOptions options)
+    {
+        mSources.push_back(MakeArc<JsonFileSource>(path, std::move(options)));
+        return *this;
+    }
+
     ConfigurationBuilder& ConfigurationBuilder::AddJsonString(
         std::string_view json)
     {
@@ -49,30 +59,36 @@ namespace SKIRNIR_NAMESPACE
         return *this;
     }
 
+    ConfigurationBuilder& ConfigurationBuilder::WithSnapshotCache(
+        std::filesystem::path path)
+    {
+        mSnapshotPath = std::move(path);
+        return *this;
+    }
+
     Arc<ConfigurationOptions> ConfigurationBuilder::Build()
     {
-        // Merge all sources into a single intermediate object tree. Sources
-        // must stay alive for the duration of this merge so the underlying
-        // parsers do not go out from under us.
-        auto merged = skr::MakeArc<detail::JsonValue>(
-            detail::JsonValue::FromObject());
-        for (auto& source : mSources)
+        std::uint64_t key = 0;
+        if (mSnapshotPath.empty() ||
+            !detail::FingerprintSources(mSources, key))
+            return detail::MergeSources(mSources);
+
+        if (auto document = detail::LoadSnapshot(mSnapshotPath, key))
         {
-            simdjson::dom::element root = source->Load();
-            // Non-object roots are ignored: a configuration source is
-            // expected to provide a top-level object.
-            if (!root.is_object())
-                continue;
-            auto converted = detail::Convert(root);
-            detail::MergeInto(merged, converted);
+            const simdjson::dom::element root = document->root;
+            return MakeArc<ConfigurationOptions>(std::move(document), root,
+                                                 std::string_view {}, true);
         }
 
-        std::string json;
-        detail::Serialize(merged, json, true);
+        auto config = detail::MergeSources(mSources);
+        detail::WriteSnapshot(mSnapshotPath, key,
+                              config->mDocument->parser->doc);
+        return config;
+    }
 
-        auto parser = std::make_unique<simdjson::dom::parser>();
-        auto rootEl = detail::ParseOrThrow(
-            *parser, json, "merged configuration");
-        return MakeArc<ConfigurationOptions>(std::move(parser), rootEl);
+    Arc<ConfigurationMonitor> ConfigurationBuilder::BuildMonitor(
+        ConfigurationMonitorOptions options)
+    {
+        return MakeArc<ConfigurationMonitor>(mSources, std::move(options));
     }
 } // namespace SKIRNIR_NAMESPACE
@@ -0,0 +1,152 @@
+#include "ConfigurationIndex.hpp"
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    namespace
+    {
+        constexpr std::size_t InitialCapacity = 64;
+
+        constexpr std::uint64_t FnvOffset = 0xcbf29ce484222325ull;
+
+        std::uint64_t HashBytes(std::uint64_t h, std::string_view bytes)
+        {
+            for (unsigned char c : bytes)
+            {
+                h ^= c;
+                h *= 0x100000001b3ull;
+            }
+            return h;
+        }
+
+        // FNV-1a over prefix + "." + path, without building that string,
+        // and a final mix so the low bits used for the slot index depend
+        // on the whole key.
+        std::uint64_t HashPath(std::string_view prefix, std::string_view path)
+        {
+            std::uint64_t h = FnvOffset;
+            if (!prefix.empty())
+                h = HashBytes(HashBytes(h, prefix), ".");
+            h = HashBytes(h, path);
+            h ^= h >> 32;
+            h *= 0xbf58476d1ce4e5b9ull;
+            h ^= h >> 29;
+            return h;
+        }
+    } // namespace
+
+    ConfigurationIndex::ConfigurationIndex(simdjson::dom::element root)
+    {
+        mSlots.resize(InitialCapacity);
+        if (!root.is_object())
+            return;
+        std::string path;
+        Index(root, path);
+    }
+
+    bool ConfigurationIndex::Covers(std::string_view path)
+    {
+        if (path.empty() || path.front() == '.' || path.back() == '.')
+            return false;
+        return path.find("..") == std::string_view::npos;
+    }
+
+    const simdjson::dom::element* ConfigurationIndex::Find(
+        std::string_view  prefix,
+        std::string_view  path,
+        std::string_view* fullPath) const
+    {
+        const std::uint64_t hash   = HashPath(prefix, path);
+        const std::size_t   length =
+            prefix.empty() ? path.size() : prefix.size() + 1 + path.size();
+        const std::size_t mask = mSlots.size() - 1;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+        {
+            const Slot& slot = mSlots[i];
+            if (!slot.used)
+                return nullptr;
+            if (slot.hash != hash || slot.length != length)
+                continue;
+            std::string_view candidate = PathOf(slot);
+            if (!prefix.empty())
+            {
+                if (!candidate.starts_with(prefix) ||
+                    candidate[prefix.size()] != '.')
+                    continue;
+                candidate.remove_prefix(prefix.size() + 1);
+            }
+            if (candidate != path)
+                continue;
+            if (fullPath)
+                *fullPath = PathOf(slot);
+            return &slot.value;
+        }
+    }
+
+    void ConfigurationIndex::Index(simdjson::dom::element object,
+                                   std::string&           path)
+    {
+        const std::size_t base = path.size();
+        for (auto kv : object.get_object())
+        {
+            std::string_view key = kv.key;
+            if (key.empty() || key.find('.') != std::string_view::npos)
+                continue;
+
+            path.resize(base);
+            if (base > 0)
+                path.push_back('.');
+            path.append(key);
+
+            // A repeated key is shadowed by its first occurrence, and so
+            // is everything below it.
+            if (!Insert(HashPath({}, path), path, kv.value))
+                continue;
+            if (kv.value.is_object())
+                Index(kv.value, path);
+        }
+        path.resize(base);
+    }
+
+    bool ConfigurationIndex::Insert(std::uint64_t          hash,
+                                    std::string_view       path,
+                                    simdjson::dom::element value)
+    {
+        if ((mSize + 1) * 2 > mSlots.size())
+            Grow();
+
+        const std::size_t mask = mSlots.size() - 1;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+        {
+            Slot& slot = mSlots[i];
+            if (!slot.used)
+            {
+                slot.hash   = hash;
+                slot.offset = static_cast<std::uint32_t>(mPaths.size());
+                slot.length = static_cast<std::uint32_t>(path.size());
+                slot.value  = value;
+                slot.used   = true;
+                mPaths.append(path);
+                ++mSize;
+                return true;
+            }
+            if (slot.hash == hash && PathOf(slot) == path)
+                return false;
+        }
+    }
+
+    void ConfigurationIndex::Grow()
+    {
+        std::vector<Slot> old(mSlots.size() * 2);
+        old.swap(mSlots);
+        const std::size_t mask = mSlots.size() - 1;
+        for (const Slot& slot : old)
+        {
+            if (!slot.used)
+                continue;
+            std::size_t i = slot.hash & mask;
+            while (mSlots[i].used)
+                i = (i + 1) & mask;
+            mSlots[i] = slot;
+        }
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
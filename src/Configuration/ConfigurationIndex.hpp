@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Skirnir/Configuration/Aliases.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /**
+     * @brief Flat hash index from full dotted path to DOM element.
+     *
+     *  Built once over a parsed document so that lookups hash the key and
+     *  probe an open-addressing table instead of splitting it and
+     *  scanning every object level. Every object member reachable through
+     *  a canonical path is indexed; members whose name is empty or
+     *  contains a dot cannot be spelled that way and are left to the
+     *  linear walk in @c ConfigurationOptions::Navigate. Arrays are not
+     *  descended into. When an object repeats a key, the first member
+     *  wins, matching the walk.
+     */
+    class ConfigurationIndex
+    {
+      public:
+        explicit ConfigurationIndex(simdjson::dom::element root);
+
+        /**
+         * @brief True if @p path can be answered by the index: non-empty,
+         *        without leading, trailing or repeated dots.
+         */
+        static bool Covers(std::string_view path);
+
+        /**
+         * @brief The element at @p prefix + "." + @p path, or nullptr if
+         *        there is none.
+         *
+         * An empty @p prefix looks @p path up from the root. On a hit,
+         * @p fullPath (if given) receives the indexed path, which stays
+         * valid as long as the index does.
+         */
+        const simdjson::dom::element* Find(
+            std::string_view  prefix,
+            std::string_view  path,
+            std::string_view* fullPath = nullptr) const;
+
+        std::size_t Size() const { return mSize; }
+
+      private:
+        struct Slot
+        {
+            std::uint64_t          hash   = 0;
+            std::uint32_t          offset = 0;
+            std::uint32_t          length = 0;
+            simdjson::dom::element value;
+            bool                   used   = false;
+        };
+
+        std::string       mPaths; // every indexed path, back to back
+        std::vector<Slot> mSlots;
+        std::size_t       mSize = 0;
+
+        void Index(simdjson::dom::element object, std::string& path);
+        bool Insert(std::uint64_t hash, std::string_view path,
+                    simdjson::dom::element value);
+        void Grow();
+
+        std::string_view PathOf(const Slot& slot) const
+        {
+            return std::string_view(mPaths).substr(slot.offset, slot.length);
+        }
+    };
+
+    /**
+     * @brief Lends a tape and string buffer owned elsewhere, such as a
+     *        mapped snapshot, to a parser's document, and takes them back
+     *        before the parser would free them.
+     */
+    class BorrowedTape
+    {
+      public:
+        BorrowedTape() = default;
+
+        BorrowedTape(simdjson::dom::parser& parser,
+                     const std::uint64_t*   tape,
+                     const std::uint8_t*    strings) noexcept :
+            mParser(&parser)
+        {
+            // simdjson only reads them once parsed, so lending the
+            // read-only memory is safe.
+            parser.doc.tape.reset(const_cast<std::uint64_t*>(tape));
+            parser.doc.string_buf.reset(const_cast<std::uint8_t*>(strings));
+        }
+
+        ~BorrowedTape()
+        {
+            if (mParser)
+            {
+                mParser->doc.tape.release();
+                mParser->doc.string_buf.release();
+            }
+        }
+
+        BorrowedTape(const BorrowedTape&)            = delete;
+        BorrowedTape& operator=(const BorrowedTape&) = delete;
+
+      private:
+        simdjson::dom::parser* mParser = nullptr;
+    };
+
+    /**
+     * @brief A parsed configuration and its path index.
+     *
+     *  Shared by a @c ConfigurationOptions and every section taken from
+     *  it, so sections hold a reference into the same document instead of
+     *  a copy of their sub-tree.
+     */
+    struct ConfigurationDocument
+    {
+        ConfigurationDocument(std::unique_ptr<simdjson::dom::parser> p,
+                              simdjson::dom::element                 r) :
+            parser(std::move(p)), root(r), index(r)
+        {
+        }
+
+        /**
+         * @brief Document over a tape and string buffer that live in
+         *        @p memory, e.g. a mapped snapshot, rather than in a
+         *        parser. Nothing is parsed; only the index is built.
+         */
+        ConfigurationDocument(std::shared_ptr<const void> memory,
+                              const std::uint64_t*        tape,
+                              const std::uint8_t*         strings) :
+            storage(std::move(memory)),
+            parser(std::make_unique<simdjson::dom::parser>()),
+            borrowed(*parser, tape, strings),
+            root(parser->doc.root()),
+            index(root)
+        {
+        }
+
+        // Declared in this order so the borrowed memory is handed back
+        // before the parser is destroyed and unmapped after both.
+        std::shared_ptr<const void>            storage;
+        std::unique_ptr<simdjson::dom::parser> parser;
+        BorrowedTape                           borrowed;
+        simdjson::dom::element                 root;
+        ConfigurationIndex                     index;
+    };
+} // namespace SKIRNIR_NAMESPACE::detail
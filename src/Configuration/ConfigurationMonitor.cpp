@@ -0,0 +1,383 @@
+#include "Skirnir/Configuration/ConfigurationMonitor.hpp"
+
+#include "Detail.hpp"
+
+#include <chrono>
+#include <exception>
+#include <numeric>
+#include <stop_token>
+#include <thread>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <climits>
+    #include <cstring>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#else
+    #include <condition_variable>
+#endif
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * Watches the files behind the monitor's sources and reloads the ones
+     * that changed once they have been quiet for the debounce interval.
+     */
+    struct ConfigurationMonitor::Watcher
+    {
+        struct File
+        {
+            std::filesystem::path path;
+            std::size_t           source;
+        };
+
+        Watcher(ConfigurationMonitor& owner, std::vector<File> files);
+        ~Watcher();
+
+        // Reloads @p dirty sources, reporting failures through onError.
+        void Flush(std::vector<std::size_t>& dirty);
+
+        ConfigurationMonitor& owner;
+        std::vector<File>     files;
+
+#if defined(__linux__)
+        void Run();
+
+        int              inotifyFd = -1;
+        int              wakeFd    = -1;
+        std::vector<int> descriptors; // watch descriptor per file
+        std::thread      thread;
+#else
+        void Run(std::stop_token stop);
+
+        std::vector<std::filesystem::file_time_type> stamps;
+        std::mutex                                   mutex;
+        std::condition_variable_any                  wake;
+        std::jthread                                 thread;
+#endif
+    };
+
+    void ConfigurationMonitor::Watcher::Flush(std::vector<std::size_t>& dirty)
+    {
+        if (dirty.empty())
+            return;
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        try
+        {
+            owner.ReloadSources(dirty);
+        }
+        catch (const std::exception& e)
+        {
+            if (owner.mOptions.onError)
+                owner.mOptions.onError(e);
+        }
+        dirty.clear();
+    }
+
+#if defined(__linux__)
+    ConfigurationMonitor::Watcher::Watcher(ConfigurationMonitor& o,
+                                           std::vector<File>     f) :
+        owner(o), files(std::move(f))
+    {
+        inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        wakeFd    = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (inotifyFd < 0 || wakeFd < 0)
+        {
+            if (inotifyFd >= 0)
+                close(inotifyFd);
+            if (wakeFd >= 0)
+                close(wakeFd);
+            throw std::runtime_error(
+                "Skirnir: failed to set up configuration file watching");
+        }
+
+        // Watch the directory rather than the file: editors and
+        // deployment tools often replace a file by renaming a new one
+        // over it, which a watch on the old inode would miss.
+        // Only completed writes and renames count: IN_MODIFY fires for
+        // every write(), so a busy sibling such as a log file would keep
+        // the watcher awake for nothing.
+        constexpr std::uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+        for (const File& file : files)
+        {
+            std::filesystem::path dir = file.path.parent_path();
+            if (dir.empty())
+                dir = ".";
+            const int wd = inotify_add_watch(inotifyFd, dir.c_str(), mask);
+            if (wd < 0)
+            {
+                // A file that is never watched would silently never be
+                // reloaded.
+                const int error = errno;
+                close(inotifyFd);
+                close(wakeFd);
+                throw std::runtime_error(
+                    "Skirnir: failed to watch '" +
+                    detail::SanitizeForError(dir.string()) +
+                    "' for configuration changes: " + std::strerror(error));
+            }
+            descriptors.push_back(wd);
+        }
+
+        thread = std::thread([this] { Run(); });
+    }
+
+    ConfigurationMonitor::Watcher::~Watcher()
+    {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] auto written = write(wakeFd, &one, sizeof(one));
+        thread.join();
+        close(inotifyFd);
+        close(wakeFd);
+    }
+
+    void ConfigurationMonitor::Watcher::Run()
+    {
+        alignas(inotify_event) char buffer[sizeof(inotify_event) + NAME_MAX +
+                                           1];
+        std::vector<std::size_t> dirty;
+        // Reload once the watched files have been quiet for the debounce
+        // interval. Only events for those files move the deadline, so
+        // unrelated activity in the same directory cannot postpone it.
+        std::chrono::steady_clock::time_point deadline;
+        for (;;)
+        {
+            int timeout = -1;
+            if (!dirty.empty())
+            {
+                const auto left = deadline - std::chrono::steady_clock::now();
+                if (left <= std::chrono::steady_clock::duration::zero())
+                {
+                    Flush(dirty);
+                    continue;
+                }
+                timeout = static_cast<int>(
+                    std::chrono::ceil<std::chrono::milliseconds>(left)
+                        .count());
+            }
+
+            pollfd    fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+            const int ready  = poll(fds, 2, timeout);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            if (fds[1].revents & POLLIN)
+                return;
+            if (ready == 0)
+                continue;
+
+            const std::size_t before = dirty.size();
+            for (;;)
+            {
+                const ssize_t n = read(inotifyFd, buffer, sizeof(buffer));
+                if (n <= 0)
+                    break;
+                for (ssize_t at = 0; at < n;)
+                {
+                    const auto* event =
+                        reinterpret_cast<const inotify_event*>(buffer + at);
+                    at += static_cast<ssize_t>(sizeof(inotify_event) +
+                                               event->len);
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        // The kernel dropped events, so any watched file
+                        // may have changed.
+                        for (const File& file : files)
+                            dirty.push_back(file.source);
+                        continue;
+                    }
+                    if (event->len == 0)
+                        continue;
+                    const std::string_view name(event->name);
+                    for (std::size_t i = 0; i < files.size(); ++i)
+                    {
+                        if (descriptors[i] == event->wd &&
+                            files[i].path.filename() == name)
+                            dirty.push_back(files[i].source);
+                    }
+                }
+            }
+            if (dirty.size() != before)
+                deadline = std::chrono::steady_clock::now() +
+                           owner.mOptions.debounce;
+        }
+    }
+#else
+    ConfigurationMonitor::Watcher::Watcher(ConfigurationMonitor& o,
+                                           std::vector<File>     f) :
+        owner(o), files(std::move(f))
+    {
+        for (const File& file : files)
+        {
+            std::error_code ec;
+            stamps.push_back(std::filesystem::last_write_time(file.path, ec));
+        }
+        thread = std::jthread([this](std::stop_token stop) { Run(stop); });
+    }
+
+    ConfigurationMonitor::Watcher::~Watcher()
+    {
+        thread.request_stop();
+        wake.notify_all();
+    }
+
+    void ConfigurationMonitor::Watcher::Run(std::stop_token stop)
+    {
+        // Without a change-notification API, poll modification times
+        // once per debounce interval and reload a file once its time has
+        // stopped moving.
+        std::vector<std::size_t>     dirty;
+        std::vector<bool>            moving(files.size(), false);
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            wake.wait_for(lock, stop, owner.mOptions.debounce,
+                          [] { return false; });
+            if (stop.stop_requested())
+                return;
+            for (std::size_t i = 0; i < files.size(); ++i)
+            {
+                std::error_code ec;
+                const auto      stamp =
+                    std::filesystem::last_write_time(files[i].path, ec);
+                if (ec)
+                    continue;
+                if (stamp != stamps[i])
+                {
+                    stamps[i] = stamp;
+                    moving[i] = true;
+                }
+                else if (moving[i])
+                {
+                    moving[i] = false;
+                    dirty.push_back(files[i].source);
+                }
+            }
+            Flush(dirty);
+        }
+    }
+#endif
+
+    ConfigurationMonitor::ConfigurationMonitor(
+        std::vector<Arc<IConfigurationSource>> sources,
+        ConfigurationMonitorOptions            options) :
+        mSources(std::move(sources)), mOptions(std::move(options))
+    {
+        mCurrent.store(detail::MergeSources(mSources));
+
+        if (!mOptions.watchFiles)
+            return;
+        std::vector<Watcher::File> files;
+        for (std::size_t i = 0; i < mSources.size(); ++i)
+        {
+            std::filesystem::path path = mSources[i]->WatchedPath();
+            if (!path.empty())
+                files.push_back({std::filesystem::absolute(path), i});
+        }
+        if (!files.empty())
+            mWatcher = std::make_unique<Watcher>(*this, std::move(files));
+    }
+
+    ConfigurationMonitor::~ConfigurationMonitor()
+    {
+        mWatcher.reset();
+    }
+
+    std::vector<std::string> ConfigurationMonitor::Reload()
+    {
+        std::vector<std::size_t> all(mSources.size());
+        std::iota(all.begin(), all.end(), std::size_t {0});
+        return ReloadSources(all);
+    }
+
+    std::vector<std::string> ConfigurationMonitor::ReloadSources(
+        std::span<const std::size_t> indices)
+    {
+        std::lock_guard<std::mutex> reloadLock(mReloadMutex);
+
+        // Every source is tried even after one fails. A source that did
+        // reload has already recorded its new content and would not
+        // report it again, so it is merged and published before the
+        // failure is passed on.
+        bool               reloaded = false;
+        std::exception_ptr failure;
+        for (std::size_t i : indices)
+        {
+            try
+            {
+                reloaded |= mSources[i]->Reload();
+            }
+            catch (...)
+            {
+                if (!failure)
+                    failure = std::current_exception();
+            }
+        }
+
+        std::vector<std::string> changed;
+        if (reloaded)
+            changed = Remerge();
+        if (failure)
+            std::rethrow_exception(failure);
+        return changed;
+    }
+
+    std::vector<std::string> ConfigurationMonitor::Remerge()
+    {
+        // Unchanged sources still hold their parsed trees, so this only
+        // re-merges; nothing but the changed files was read or parsed.
+        Arc<ConfigurationOptions> next     = detail::MergeSources(mSources);
+        Arc<ConfigurationOptions> previous = mCurrent.load();
+
+        std::vector<std::string> changed;
+        std::string              path;
+        detail::CollectChanges(previous->Root(), next->Root(), path, changed);
+        if (changed.empty())
+            return changed;
+
+        mCurrent.store(next);
+
+        std::vector<Listener> listeners;
+        {
+            std::lock_guard<std::mutex> lock(mListenersMutex);
+            for (const Subscription& s : mListeners)
+            {
+                for (const std::string& p : changed)
+                {
+                    if (detail::PathsOverlap(p, s.key))
+                    {
+                        listeners.push_back(s.listener);
+                        break;
+                    }
+                }
+            }
+        }
+        for (const Listener& listener : listeners)
+            listener(next);
+        return changed;
+    }
+
+    std::size_t ConfigurationMonitor::Subscribe(std::string key,
+                                                Listener    listener)
+    {
+        std::lock_guard<std::mutex> lock(mListenersMutex);
+        mListeners.push_back({++mLastToken, std::move(key),
+                              std::move(listener)});
+        return mLastToken;
+    }
+
+    void ConfigurationMonitor::Unsubscribe(std::size_t token)
+    {
+        std::lock_guard<std::mutex> lock(mListenersMutex);
+        std::erase_if(mListeners, [token](const Subscription& s) {
+            return s.token == token;
+        });
+    }
+} // namespace SKIRNIR_NAMESPACE
@@ -7,54 +7,85 @@
 #include <stdexcept>
 #include <variant>
 
+#include "ConfigurationIndex.hpp"
 #include "Detail.hpp"
 
 namespace SKIRNIR_NAMESPACE
 {
     using SKIRNIR_NAMESPACE::MakeArc;
-    std::vector<std::string_view> ConfigurationOptions::SplitKey(
-        std::string_view key)
+    ConfigurationOptions::ConfigurationOptions(
+        std::unique_ptr<simdjson::dom::parser> parser,
+        simdjson::dom::element                 element) :
+        mDocument(MakeArc<detail::ConfigurationDocument>(std::move(parser),
+                                                         element)),
+        mElement(element),
+        mIndexed(true)
     {
-        std::vector<std::string_view> parts;
-        while (!key.empty())
-        {
-            auto dot = key.find('.');
-            if (dot == std::string_view::npos)
-            {
-                parts.push_back(key);
-                break;
-            }
-            parts.push_back(key.substr(0, dot));
-            key = key.substr(dot + 1);
-        }
-        return parts;
     }
 
-    std::optional<simdjson::dom::element> ConfigurationOptions::Navigate(
+    ConfigurationOptions::ConfigurationOptions(
+        Arc<detail::ConfigurationDocument> document,
+        simdjson::dom::element             element,
+        std::string_view                   path,
+        bool                               indexed) :
+        mDocument(std::move(document)),
+        mElement(element),
+        mPath(path),
+        mIndexed(indexed)
+    {
+    }
+
+    std::optional<ConfigurationOptions::Located> ConfigurationOptions::Locate(
         std::string_view key) const
     {
-        auto parts = SplitKey(key);
-        if (parts.empty())
-            return mElement;
+        // An empty configuration (e.g. a missing section) has no document
+        // and its element must not be touched.
+        if (!mDocument)
+            return std::nullopt;
+        if (key.empty())
+            return Located {mElement, mPath, mIndexed};
+        if (mIndexed && detail::ConfigurationIndex::Covers(key))
+        {
+            std::string_view path;
+            if (auto* el = mDocument->index.Find(mPath, key, &path))
+                return Located {*el, path, true};
+            return std::nullopt;
+        }
 
+        // Keys with empty segments, and sections reached through one, are
+        // not covered by the index: walk the tree one segment at a time.
         simdjson::dom::element cursor = mElement;
-        for (auto segment : parts)
+        while (!key.empty())
         {
+            auto             dot     = key.find('.');
+            std::string_view segment = key.substr(0, dot);
+            key = dot == std::string_view::npos ? std::string_view {}
+                                                : key.substr(dot + 1);
             if (!cursor.is_object())
                 return std::nullopt;
-            auto obj = cursor.get_object();
-            for (auto kv : obj)
+            bool found = false;
+            for (auto kv : cursor.get_object())
             {
                 if (kv.key == segment)
                 {
                     cursor = kv.value;
-                    goto next;
+                    found  = true;
+                    break;
                 }
             }
-            return std::nullopt;
-        next:;
+            if (!found)
+                return std::nullopt;
         }
-        return cursor;
+        return Located {cursor, {}, false};
+    }
+
+    std::optional<simdjson::dom::element> ConfigurationOptions::Navigate(
+        std::string_view key) const
+    {
+        auto located = Locate(key);
+        if (!located)
+            return std::nullopt;
+        return located->element;
     }
 
     std::optional<std::string> ConfigurationOptions::GetValue(
@@ -175,19 +206,11 @@ namespace SKIRNIR_NAMESPACE
     Arc<ConfigurationOptions> ConfigurationOptions::GetSection(
         std::string_view key) const
     {
-        auto el = Navigate(key);
-        if (!el)
-            return MakeArc<ConfigurationOptions>();
-        if (!el->is_object())
+        auto located = Locate(key);
+        if (!located || !located->element.is_object())
             return MakeArc<ConfigurationOptions>();
-
-        // Serialize the sub-tree and parse it into a fresh parser so this
-        // child ConfigurationOptions can outlive the parent parser.
-        std::string slice  = detail::SerializeElement(*el);
-        auto        parser = std::make_unique<simdjson::dom::parser>();
-        auto        rootEl = detail::ParseOrThrow(
-            *parser, slice, "section '" + std::string(key) + "'");
-        return MakeArc<ConfigurationOptions>(std::move(parser), rootEl);
+        return MakeArc<ConfigurationOptions>(
+            mDocument, located->element, located->path, located->indexed);
     }
 
     std::string ConfigurationOptions::Stringify(simdjson::dom::element el)
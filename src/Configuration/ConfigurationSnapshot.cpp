@@ -0,0 +1,420 @@
+#include "ConfigurationSnapshot.hpp"
+
+#include "ConfigurationIndex.hpp"
+#include "Detail.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    namespace
+    {
+        /**
+         * Fixed-size header of a snapshot file. It is followed by the
+         * document's tape (@c tapeWords 64-bit words, in host byte order)
+         * and its string buffer (@c stringBytes bytes), both exactly as
+         * simdjson laid them out, so a loaded snapshot is used in place.
+         */
+        struct SnapshotHeader
+        {
+            char          magic[8];
+            std::uint32_t format;
+            std::uint32_t byteOrder;
+            std::uint64_t simdjson; // hash of the simdjson version
+            std::uint64_t key;
+            std::uint64_t tapeWords;
+            std::uint64_t stringBytes;
+            std::uint64_t checksum; // of the tape and string buffer
+        };
+
+        static_assert(sizeof(SnapshotHeader) % alignof(std::uint64_t) == 0);
+
+        constexpr char          Magic[8]  = {'S', 'K', 'R', 'C', 'F', 'G', 0, 0};
+        constexpr std::uint32_t Format    = 1;
+        constexpr std::uint32_t ByteOrder = 0x01020304;
+
+        constexpr std::uint64_t ValueMask = 0x00ffffffffffffffull;
+
+        std::uint64_t SimdjsonVersion()
+        {
+            return HashCombine(0, std::string_view(SIMDJSON_VERSION));
+        }
+
+        std::uint64_t Checksum(const std::uint64_t* tape,
+                               std::uint64_t        tapeWords,
+                               const std::uint8_t*  strings,
+                               std::uint64_t        stringBytes)
+        {
+            const std::string_view tapeBytes(
+                reinterpret_cast<const char*>(tape),
+                static_cast<std::size_t>(tapeWords * sizeof(std::uint64_t)));
+            const std::string_view stringView(
+                reinterpret_cast<const char*>(strings),
+                static_cast<std::size_t>(stringBytes));
+            return HashCombine(HashCombine(0, tapeBytes), stringView);
+        }
+
+        // The used part of the string buffer ends after the last string
+        // the tape refers to: a 32-bit length, the bytes and a NUL.
+        std::uint64_t StringBytesOf(const simdjson::dom::document& doc,
+                                    std::uint64_t                  tapeWords)
+        {
+            std::uint64_t end = 0;
+            for (std::uint64_t i = 0; i < tapeWords; ++i)
+            {
+                const std::uint64_t word = doc.tape[i];
+                switch (static_cast<char>(word >> 56))
+                {
+                    case '"': {
+                        const std::uint64_t offset = word & ValueMask;
+                        std::uint32_t       length = 0;
+                        std::memcpy(&length, doc.string_buf.get() + offset,
+                                    sizeof(length));
+                        end = std::max(end, offset + sizeof(length) + length +
+                                                1);
+                        break;
+                    }
+                    case 'l':
+                    case 'u':
+                    case 'd':
+                        ++i; // the number itself takes the next word
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return end;
+        }
+
+#ifndef _WIN32
+        // Writes all of [data, data + size) to @p fd, retrying short
+        // writes and interrupted calls.
+        bool WriteAll(int fd, const void* data, std::uint64_t size)
+        {
+            const auto* at = static_cast<const char*>(data);
+            while (size > 0)
+            {
+                const ssize_t n = ::write(fd, at, size);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return false;
+                }
+                at += n;
+                size -= static_cast<std::uint64_t>(n);
+            }
+            return true;
+        }
+#endif
+
+        // Walks the tape of a snapshot once and checks everything that
+        // simdjson and the index will later trust without checking: string
+        // offsets and lengths stay inside the string buffer, every
+        // container closes where its jump index says and in nesting order,
+        // object members are string keys followed by one value, and the
+        // element counts match. The checksum only catches accidents, since
+        // anyone who can write the file can recompute it.
+        bool TapeIsWellFormed(const std::uint64_t* tape,
+                              std::uint64_t        tapeWords,
+                              const std::uint8_t*  strings,
+                              std::uint64_t        stringBytes)
+        {
+            struct Scope
+            {
+                std::uint64_t open;
+                char          type;
+                bool          expectKey;
+                std::uint64_t count;
+            };
+
+            const std::uint64_t last = tapeWords - 1;
+            if ((tape[last] & ValueMask) != 0)
+                return false;
+
+            std::vector<Scope> scopes;
+            std::uint64_t      roots = 0;
+            for (std::uint64_t i = 1; i < last; ++i)
+            {
+                const char          type    = static_cast<char>(tape[i] >> 56);
+                const std::uint64_t payload = tape[i] & ValueMask;
+
+                if (type == '}' || type == ']')
+                {
+                    if (scopes.empty())
+                        return false;
+                    const Scope scope = scopes.back();
+                    scopes.pop_back();
+                    if (scope.type != (type == '}' ? '{' : '[') ||
+                        payload != scope.open ||
+                        (tape[scope.open] & 0xffffffffull) != i + 1 ||
+                        (type == '}' && !scope.expectKey))
+                        return false;
+                    const std::uint64_t count =
+                        (tape[scope.open] >> 32) & 0xffffffull;
+                    if (count != std::min<std::uint64_t>(scope.count,
+                                                         0xffffffull))
+                        return false;
+                    continue;
+                }
+
+                // Every other word starts a key or a value.
+                if (scopes.empty())
+                    ++roots;
+                else if (scopes.back().type == '{')
+                {
+                    Scope& scope = scopes.back();
+                    if (scope.expectKey && type != '"')
+                        return false;
+                    if (scope.expectKey)
+                        ++scope.count;
+                    scope.expectKey = !scope.expectKey;
+                }
+                else
+                    ++scopes.back().count;
+
+                switch (type)
+                {
+                    case '"': {
+                        std::uint32_t length = 0;
+                        if (payload > stringBytes ||
+                            stringBytes - payload < sizeof(length) + 1)
+                            return false;
+                        std::memcpy(&length, strings + payload,
+                                    sizeof(length));
+                        if (stringBytes - payload - sizeof(length) <
+                                std::uint64_t {length} + 1 ||
+                            strings[payload + sizeof(length) + length] != 0)
+                            return false;
+                        break;
+                    }
+                    case 'l':
+                    case 'u':
+                    case 'd':
+                        if (last - i < 2)
+                            return false;
+                        ++i; // the number itself takes the next word
+                        break;
+                    case '{':
+                    case '[': {
+                        const std::uint64_t end = payload & 0xffffffffull;
+                        if (end <= i + 1 || end > last)
+                            return false;
+                        scopes.push_back({i, type, true, 0});
+                        break;
+                    }
+                    case 't':
+                    case 'f':
+                    case 'n':
+                        break;
+                    default:
+                        return false;
+                }
+            }
+            return scopes.empty() && roots == 1;
+        }
+
+        // Checks the snapshot in [data, data + size) and builds a document
+        // over it; @p memory keeps it alive.
+        Arc<ConfigurationDocument> Adopt(std::shared_ptr<const void> memory,
+                                         const std::uint8_t*         data,
+                                         std::uint64_t               size,
+                                         std::uint64_t               key)
+        {
+            SnapshotHeader header;
+            if (size < sizeof(header))
+                return nullptr;
+            std::memcpy(&header, data, sizeof(header));
+            if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+                header.format != Format || header.byteOrder != ByteOrder ||
+                header.simdjson != SimdjsonVersion() || header.key != key)
+                return nullptr;
+
+            const std::uint64_t body = size - sizeof(header);
+            if (header.tapeWords < 2 ||
+                header.tapeWords > body / sizeof(std::uint64_t) ||
+                header.stringBytes !=
+                    body - header.tapeWords * sizeof(std::uint64_t))
+                return nullptr;
+
+            const auto* tape = reinterpret_cast<const std::uint64_t*>(
+                data + sizeof(header));
+            const auto* strings = data + sizeof(header) +
+                                  header.tapeWords * sizeof(std::uint64_t);
+            // The tape starts and ends with a root word; the first one
+            // holds the tape length.
+            if (static_cast<char>(tape[0] >> 56) != 'r' ||
+                (tape[0] & ValueMask) != header.tapeWords ||
+                static_cast<char>(tape[header.tapeWords - 1] >> 56) != 'r')
+                return nullptr;
+            if (Checksum(tape, header.tapeWords, strings,
+                         header.stringBytes) != header.checksum ||
+                !TapeIsWellFormed(tape, header.tapeWords, strings,
+                                  header.stringBytes))
+                return nullptr;
+
+            return MakeArc<ConfigurationDocument>(std::move(memory), tape,
+                                                  strings);
+        }
+    } // namespace
+
+    bool FingerprintSources(std::span<const Arc<IConfigurationSource>> sources,
+                            std::uint64_t&                             key)
+    {
+        key = HashCombine(SimdjsonVersion(), sources.size());
+        for (const auto& source : sources)
+        {
+            if (!source->Fingerprint(key))
+                return false;
+        }
+        return true;
+    }
+
+    Arc<ConfigurationDocument> LoadSnapshot(const std::filesystem::path& path,
+                                            std::uint64_t                key)
+    {
+#ifndef _WIN32
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return nullptr;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+            st.st_size < static_cast<off_t>(sizeof(SnapshotHeader)))
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        const auto size = static_cast<std::size_t>(st.st_size);
+        void*      map  = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED)
+            return nullptr;
+
+        std::shared_ptr<const void> memory(map, [size](const void* p) {
+            ::munmap(const_cast<void*>(p), size);
+        });
+        return Adopt(std::move(memory), static_cast<const std::uint8_t*>(map),
+                     size, key);
+#else
+        std::error_code ec;
+        const auto      size = std::filesystem::file_size(path, ec);
+        if (ec || size < sizeof(SnapshotHeader))
+            return nullptr;
+        std::ifstream file(path, std::ios::binary);
+        // Words, so the tape that follows the header is aligned.
+        std::shared_ptr<std::uint64_t[]> buffer(
+            new std::uint64_t[(size + 7) / sizeof(std::uint64_t)]);
+        if (!file.read(reinterpret_cast<char*>(buffer.get()),
+                       static_cast<std::streamsize>(size)))
+            return nullptr;
+        const auto* data = reinterpret_cast<const std::uint8_t*>(buffer.get());
+        return Adopt(std::shared_ptr<const void>(buffer, buffer.get()), data,
+                     size, key);
+#endif
+    }
+
+    bool WriteSnapshot(const std::filesystem::path&   path,
+                       std::uint64_t                  key,
+                       const simdjson::dom::document& document) noexcept
+    {
+        try
+        {
+            if (!document.tape)
+                return false;
+            SnapshotHeader header {};
+            std::memcpy(header.magic, Magic, sizeof(Magic));
+            header.format      = Format;
+            header.byteOrder   = ByteOrder;
+            header.simdjson    = SimdjsonVersion();
+            header.key         = key;
+            header.tapeWords   = document.tape[0] & ValueMask;
+            header.stringBytes = StringBytesOf(document, header.tapeWords);
+            header.checksum =
+                Checksum(document.tape.get(), header.tapeWords,
+                         document.string_buf.get(), header.stringBytes);
+
+            std::error_code ec;
+            if (path.has_parent_path())
+                std::filesystem::create_directories(path.parent_path(), ec);
+
+            // Write next to the target and rename over it, so concurrent
+            // readers see either the old snapshot or the new one.
+            std::filesystem::path tmp = path;
+            tmp += ".tmp" +
+                   std::to_string(HashCombine(
+                       std::hash<std::thread::id> {}(
+                           std::this_thread::get_id()),
+                       static_cast<std::uint64_t>(
+                           std::chrono::steady_clock::now()
+                               .time_since_epoch()
+                               .count())));
+#ifndef _WIN32
+            {
+                // The merged configuration may hold secrets from the
+                // environment, so only the owner may read it. A fresh
+                // name is required and symlinks are refused.
+                int flags = O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC;
+    #ifdef O_NOFOLLOW
+                flags |= O_NOFOLLOW;
+    #endif
+                const int fd = ::open(tmp.c_str(), flags, 0600);
+                if (fd < 0)
+                    return false;
+                const bool written =
+                    WriteAll(fd, &header, sizeof(header)) &&
+                    WriteAll(fd, document.tape.get(),
+                             header.tapeWords * sizeof(std::uint64_t)) &&
+                    WriteAll(fd, document.string_buf.get(),
+                             header.stringBytes);
+                if (::close(fd) != 0 || !written)
+                {
+                    std::filesystem::remove(tmp, ec);
+                    return false;
+                }
+            }
+#else
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(&header),
+                          sizeof(header));
+                out.write(reinterpret_cast<const char*>(document.tape.get()),
+                          static_cast<std::streamsize>(header.tapeWords *
+                                                       sizeof(std::uint64_t)));
+                out.write(
+                    reinterpret_cast<const char*>(document.string_buf.get()),
+                    static_cast<std::streamsize>(header.stringBytes));
+                out.close();
+                if (!out)
+                {
+                    std::filesystem::remove(tmp, ec);
+                    return false;
+                }
+            }
+#endif
+            std::filesystem::rename(tmp, path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tmp, ec);
+                return false;
+            }
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Configuration/Aliases.hpp"
+#include "Skirnir/Configuration/IConfigurationSource.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    struct ConfigurationDocument;
+
+    /**
+     * @brief Fingerprints @p sources in order into @p key.
+     *
+     * @return false if any source cannot be fingerprinted, in which case
+     *         the merged configuration must not be cached.
+     */
+    bool FingerprintSources(std::span<const Arc<IConfigurationSource>> sources,
+                            std::uint64_t&                             key);
+
+    /**
+     * @brief Maps the snapshot at @p path and returns the document it
+     *        holds, or nullptr if there is none, it was written for
+     *        another @p key or by an incompatible build, or it is damaged.
+     *
+     * The document's tape and strings are used in place from the mapping
+     * (read into memory where mapping is unavailable); nothing is parsed.
+     */
+    Arc<ConfigurationDocument> LoadSnapshot(const std::filesystem::path& path,
+                                            std::uint64_t                key);
+
+    /**
+     * @brief Writes @p document as a snapshot for @p key to @p path,
+     *        replacing any previous one atomically.
+     *
+     * @return false if it could not be written; the cache is best effort.
+     */
+    bool WriteSnapshot(const std::filesystem::path&  path,
+                       std::uint64_t                 key,
+                       const simdjson::dom::document& document) noexcept;
+} // namespace SKIRNIR_NAMESPACE::detail
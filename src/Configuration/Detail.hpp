@@ -1,23 +1,29 @@
 #pragma once
 
-#include "Skirnir/Common/Arc.hpp"
 #include "Skirnir/Configuration.hpp"
 
+#include "../Common/EscapeScan.hpp"
+#include "ConfigurationIndex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <functional>
-#include <iomanip>
-#include <locale>
+#include <fstream>
+#include <limits>
 #include <map>
 #include <memory>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <variant>
+#include <unordered_map>
 #include <vector>
 
 #if defined(_WIN32)
@@ -28,385 +34,469 @@ namespace SKIRNIR_NAMESPACE::detail
 {
     extern "C" char** environ;
 
-    // Intermediate merge representation; built from simdjson elements
-    // and serialized back to a JSON string for the final parse.
-    struct JsonValue;
-
-    using JsonObject = std::map<std::string, Arc<JsonValue>>;
-    using JsonArray  = std::vector<Arc<JsonValue>>;
-
-    struct JsonValue
+    inline void AppendString(std::string& out, std::string_view s)
     {
-        std::variant<std::monostate, bool, int64_t, double, std::string,
-                     Arc<JsonObject>,
-                     Arc<JsonArray>>
-            data;
-
-        static JsonValue Null() { return JsonValue { std::monostate {} }; }
-
-        static JsonValue FromBool(bool b) { return JsonValue { b }; }
-
-        static JsonValue FromInt(int64_t i) { return JsonValue { i }; }
-
-        static JsonValue FromDouble(double d) { return JsonValue { d }; }
-
-        static JsonValue FromString(std::string s)
-        {
-            return JsonValue { std::move(s) };
-        }
-
-        static JsonValue FromObject()
-        {
-            return JsonValue { skr::MakeArc<JsonObject>() };
-        }
+        out.push_back('"');
+        AppendEscaped<EscapeSet::Json>(out, s.data(), s.size(),
+                                       AppendJsonEscape);
+        out.push_back('"');
+    }
 
-        static JsonValue FromArray()
-        {
-            return JsonValue { skr::MakeArc<JsonArray>() };
-        }
+    template <typename Int>
+    inline void AppendInteger(std::string& out, Int value)
+    {
+        char buf[24];
+        auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, res.ptr);
+    }
 
-        bool IsObject() const
-        {
-            return std::holds_alternative<Arc<JsonObject>>(
-                data);
-        }
-        bool IsArray() const
-        {
-            return std::holds_alternative<Arc<JsonArray>>(data);
-        }
-        JsonObject& AsObject()
-        {
-            return *std::get<Arc<JsonObject>>(data);
-        }
-        const JsonObject& AsObject() const
-        {
-            return *std::get<Arc<JsonObject>>(data);
-        }
-        JsonArray& AsArray()
-        {
-            return *std::get<Arc<JsonArray>>(data);
-        }
-        const JsonArray& AsArray() const
+    // Non-finite doubles have no JSON spelling and are written as null.
+    // Finite values use %.17g so they round-trip exactly.
+    inline void AppendDouble(std::string& out, double value)
+    {
+        if (std::isnan(value) || std::isinf(value))
         {
-            return *std::get<Arc<JsonArray>>(data);
+            out += "null";
+            return;
         }
-    };
-
-    inline Arc<JsonValue> MakeNull()
-    {
-        return skr::MakeArc<JsonValue>(JsonValue::Null());
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof(buf), value,
+                                 std::chars_format::general, 17);
+        out.append(buf, res.ptr);
     }
 
-    inline Arc<JsonValue> Convert(simdjson::dom::element el)
+    // Append a simdjson DOM element to @p out as compact JSON.
+    inline void AppendElement(std::string& out, simdjson::dom::element e)
     {
-        simdjson::dom::element_type t = el.type();
-        switch (t)
+        switch (e.type())
         {
             case simdjson::dom::element_type::NULL_VALUE:
-                return MakeNull();
+                out += "null";
+                return;
             case simdjson::dom::element_type::BOOL: {
-                bool v;
-                if (el.get_bool().get(v) != simdjson::SUCCESS)
-                    return MakeNull();
-                return skr::MakeArc<JsonValue>(JsonValue::FromBool(v));
+                bool b;
+                if (e.get_bool().get(b) == simdjson::SUCCESS)
+                    out += b ? "true" : "false";
+                else
+                    out += "null";
+                return;
             }
             case simdjson::dom::element_type::INT64: {
-                int64_t v;
-                if (el.get_int64().get(v) != simdjson::SUCCESS)
-                    return MakeNull();
-                return skr::MakeArc<JsonValue>(JsonValue::FromInt(v));
+                int64_t i;
+                if (e.get_int64().get(i) == simdjson::SUCCESS)
+                    AppendInteger(out, i);
+                else
+                    out += "null";
+                return;
             }
             case simdjson::dom::element_type::UINT64: {
-                uint64_t v;
-                if (el.get_uint64().get(v) != simdjson::SUCCESS)
-                    return MakeNull();
-                return skr::MakeArc<JsonValue>(
-                    JsonValue::FromInt(static_cast<int64_t>(v)));
+                uint64_t u;
+                if (e.get_uint64().get(u) == simdjson::SUCCESS)
+                    AppendInteger(out, u);
+                else
+                    out += "null";
+                return;
             }
             case simdjson::dom::element_type::DOUBLE: {
-                double v;
-                if (el.get_double().get(v) != simdjson::SUCCESS)
-                    return MakeNull();
-                return skr::MakeArc<JsonValue>(
-                    JsonValue::FromDouble(v));
+                double d;
+                if (e.get_double().get(d) == simdjson::SUCCESS)
+                    AppendDouble(out, d);
+                else
+                    out += "null";
+                return;
             }
             case simdjson::dom::element_type::STRING: {
                 std::string_view sv;
-                if (el.get_string().get(sv) != simdjson::SUCCESS)
-                    return MakeNull();
-                return skr::MakeArc<JsonValue>(
-                    JsonValue::FromString(std::string(sv)));
+                if (e.get_string().get(sv) == simdjson::SUCCESS)
+                    AppendString(out, sv);
+                else
+                    out += "null";
+                return;
             }
             case simdjson::dom::element_type::ARRAY: {
-                auto arr =
-                    skr::MakeArc<JsonValue>(JsonValue::FromArray());
-                for (auto item : el.get_array())
+                out.push_back('[');
+                bool first = true;
+                for (auto item : e.get_array())
                 {
-                    arr->AsArray().push_back(Convert(item));
+                    if (!first)
+                        out.push_back(',');
+                    first = false;
+                    AppendElement(out, item);
                 }
-                return arr;
+                out.push_back(']');
+                return;
             }
             case simdjson::dom::element_type::OBJECT: {
-                auto obj =
-                    skr::MakeArc<JsonValue>(JsonValue::FromObject());
-                for (auto kv : el.get_object())
+                out.push_back('{');
+                bool first = true;
+                for (auto kv : e.get_object())
                 {
-                    std::string_view k              = kv.key;
-                    obj->AsObject()[std::string(k)] = Convert(kv.value);
+                    if (!first)
+                        out.push_back(',');
+                    first = false;
+                    AppendString(out, kv.key);
+                    out.push_back(':');
+                    AppendElement(out, kv.value);
                 }
-                return obj;
+                out.push_back('}');
+                return;
             }
         }
-        return MakeNull();
+        out += "null";
     }
 
-    // Recursively merge @p src into @p dst, with @p src overriding
-    // @p dst on key conflicts (object keys recurse; everything else
-    // replaces wholesale).
-    inline void MergeInto(
-        Arc<JsonValue> dst, Arc<JsonValue> src)
+    // Serialize a simdjson DOM element to a JSON string. Used by
+    // GetSection() to produce a sub-tree that owns its own parser.
+    inline std::string SerializeElement(simdjson::dom::element el)
     {
-        if (!src || !dst)
-            return;
-        if (!src->IsObject() || !dst->IsObject())
+        std::string out;
+        AppendElement(out, el);
+        return out;
+    }
+
+    /**
+     * @brief Writes a simdjson tape and string buffer directly, in the
+     *        layout the parser produces.
+     *
+     *  Lets a merged configuration become a document without being
+     *  written out as JSON text and parsed again. Values are copied with
+     *  their exact type and bits, so a double stays a double even when
+     *  it has no fractional part.
+     */
+    class TapeWriter
+    {
+      public:
+        TapeWriter() { mTape.push_back(0); } // root word, set by Finish()
+
+        /** @brief Starts an object ('{') or array ('['). */
+        std::size_t Open(char type)
         {
-            *dst = *src;
-            return;
+            const std::size_t at = mTape.size();
+            mTape.push_back(Word(type, 0));
+            return at;
         }
-        for (auto& [k, v] : src->AsObject())
+
+        /**
+         * @brief Closes the container opened at @p open, which holds
+         *        @p count members or items.
+         */
+        void Close(std::size_t open, std::uint64_t count)
         {
-            auto it = dst->AsObject().find(k);
-            if (it == dst->AsObject().end())
+            const std::uint64_t at = mTape.size();
+            // Jump indices are 32 bits wide on the tape.
+            if (at + 1 > 0xffffffffull)
             {
-                dst->AsObject().emplace(k, v);
+                throw std::runtime_error(
+                    "Skirnir: merged configuration is too large");
             }
-            else
+            // The count saturates, as simdjson's does.
+            const char          type    = static_cast<char>(mTape[open] >> 56);
+            const std::uint64_t counted = std::min<std::uint64_t>(count,
+                                                                  0xffffffull);
+            mTape.push_back(Word(type == '{' ? '}' : ']', open));
+            mTape[open] = Word(type, (counted << 32) | (at + 1));
+        }
+
+        void String(std::string_view s)
+        {
+            if (s.size() > 0xffffffffull)
             {
-                MergeInto(it->second, v);
+                throw std::runtime_error(
+                    "Skirnir: merged configuration is too large");
             }
+            const auto    offset = mStrings.size();
+            std::uint32_t length = static_cast<std::uint32_t>(s.size());
+            mStrings.resize(offset + sizeof(length) + s.size() + 1);
+            std::memcpy(mStrings.data() + offset, &length, sizeof(length));
+            std::memcpy(mStrings.data() + offset + sizeof(length), s.data(),
+                        s.size());
+            mStrings.back() = 0;
+            mTape.push_back(Word('"', offset));
         }
-    }
 
-    inline void AppendString(std::string& out, std::string_view s)
-    {
-        out.push_back('"');
-        for (char c : s)
+        /** @brief Copies @p e and everything below it. */
+        void Element(simdjson::dom::element e)
         {
-            switch (c)
+            using simdjson::dom::element_type;
+            switch (e.type())
             {
-                case '"':
-                    out += "\\\"";
-                    break;
-                case '\\':
-                    out += "\\\\";
-                    break;
-                case '\b':
-                    out += "\\b";
-                    break;
-                case '\f':
-                    out += "\\f";
-                    break;
-                case '\n':
-                    out += "\\n";
-                    break;
-                case '\r':
-                    out += "\\r";
-                    break;
-                case '\t':
-                    out += "\\t";
-                    break;
-                default:
-                    if (static_cast<unsigned char>(c) < 0x20)
+                case element_type::ARRAY: {
+                    const std::size_t open  = Open('[');
+                    std::uint64_t     count = 0;
+                    for (auto item : e.get_array())
                     {
-                        char buf[8];
-                        std::snprintf(buf, sizeof(buf), "\\u%04x",
-                                      static_cast<unsigned char>(c));
-                        out += buf;
+                        Element(item);
+                        ++count;
                     }
-                    else
+                    Close(open, count);
+                    return;
+                }
+                case element_type::OBJECT: {
+                    const std::size_t open  = Open('{');
+                    std::uint64_t     count = 0;
+                    for (auto kv : e.get_object())
                     {
-                        out.push_back(c);
+                        String(kv.key);
+                        Element(kv.value);
+                        ++count;
                     }
+                    Close(open, count);
+                    return;
+                }
+                case element_type::INT64:
+                    Number('l', std::bit_cast<std::uint64_t>(
+                                    e.get_int64().value_unsafe()));
+                    return;
+                case element_type::UINT64:
+                    Number('u', e.get_uint64().value_unsafe());
+                    return;
+                case element_type::DOUBLE:
+                    Number('d', std::bit_cast<std::uint64_t>(
+                                    e.get_double().value_unsafe()));
+                    return;
+                case element_type::STRING:
+                    String(e.get_string().value_unsafe());
+                    return;
+                case element_type::BOOL:
+                    mTape.push_back(
+                        Word(e.get_bool().value_unsafe() ? 't' : 'f', 0));
+                    return;
+                case element_type::NULL_VALUE:
                     break;
             }
+            mTape.push_back(Word('n', 0));
+        }
+
+        /**
+         * @brief Seals the tape, which must hold exactly one value, and
+         *        returns a document that owns it.
+         */
+        Arc<ConfigurationDocument> Finish() &&
+        {
+            mTape.push_back(Word('r', 0));
+            mTape[0] = Word('r', mTape.size());
+
+            struct Buffers
+            {
+                std::vector<std::uint64_t> tape;
+                std::vector<std::uint8_t>  strings;
+            };
+            auto buffers = std::make_shared<Buffers>(std::move(mTape),
+                                                     std::move(mStrings));
+            const std::uint64_t* tape    = buffers->tape.data();
+            const std::uint8_t*  strings = buffers->strings.data();
+            return MakeArc<ConfigurationDocument>(std::move(buffers), tape,
+                                                  strings);
         }
-        out.push_back('"');
-    }
 
-    inline void Serialize(const Arc<JsonValue>& v,
-                          std::string&                       out,
-                          bool wrapRootInObject = false)
+      private:
+        std::vector<std::uint64_t> mTape;
+        std::vector<std::uint8_t>  mStrings;
+
+        static std::uint64_t Word(char type, std::uint64_t payload)
+        {
+            return (std::uint64_t {static_cast<std::uint8_t>(type)} << 56) |
+                   payload;
+        }
+
+        void Number(char type, std::uint64_t bits)
+        {
+            mTape.push_back(Word(type, 0));
+            mTape.push_back(bits);
+        }
+    };
+
+    // Write the merge of @p layers to @p out in a single pass over the
+    // source documents. Later layers win: a non-object replaces whatever
+    // came before it wholesale, and objects merge member by member.
+    // Members keep the order in which they first appear. Only objects
+    // present in more than one layer need bookkeeping; everything else
+    // is copied straight from its source document.
+    inline void WriteMerged(TapeWriter&                             out,
+                            std::span<const simdjson::dom::element> layers)
     {
-        if (!v)
+        if (layers.empty())
         {
-            if (wrapRootInObject)
-                out += "{}";
-            else
-                out += "null";
+            out.Close(out.Open('{'), 0);
             return;
         }
 
-        if (v->IsObject())
+        // Everything before the last non-object layer is shadowed by it.
+        std::size_t first = layers.size();
+        while (first > 0 && layers[first - 1].is_object())
+            --first;
+        if (first == layers.size())
         {
-            if (wrapRootInObject && v->AsObject().empty())
-            {
-                out += "{}";
-                return;
-            }
-            out.push_back('{');
-            bool first = true;
-            for (auto& [k, child] : v->AsObject())
-            {
-                if (!first)
-                    out.push_back(',');
-                first = false;
-                AppendString(out, k);
-                out.push_back(':');
-                Serialize(child, out, false);
-            }
-            out.push_back('}');
+            out.Element(layers.back());
+            return;
         }
-        else if (v->IsArray())
+        layers = layers.subspan(first);
+        if (layers.size() == 1)
         {
-            out.push_back('[');
-            bool first = true;
-            for (auto& child : v->AsArray())
+            out.Element(layers.front());
+            return;
+        }
+
+        struct Member
+        {
+            std::string_view                    key;
+            std::vector<simdjson::dom::element> values;
+            std::size_t                         lastLayer;
+        };
+        std::vector<Member>                               members;
+        std::unordered_map<std::string_view, std::size_t> index;
+        for (std::size_t layer = 0; layer < layers.size(); ++layer)
+        {
+            for (auto kv : layers[layer].get_object())
             {
-                if (!first)
-                    out.push_back(',');
-                first = false;
-                Serialize(child, out, false);
+                std::string_view key = kv.key;
+                auto [it, inserted]  = index.try_emplace(key, members.size());
+                if (inserted)
+                {
+                    members.push_back({key, {kv.value}, layer});
+                    continue;
+                }
+                Member& m = members[it->second];
+                // A repeated key inside one object replaces the earlier
+                // occurrence instead of merging with it.
+                if (m.lastLayer == layer)
+                    m.values.back() = kv.value;
+                else
+                    m.values.push_back(kv.value);
+                m.lastLayer = layer;
             }
-            out.push_back(']');
-        }
-        else
-        {
-            std::visit(
-                [&out](auto&& arg) {
-                    using A = std::decay_t<decltype(arg)>;
-                    if constexpr (std::is_same_v<A, std::monostate>)
-                        out += "null";
-                    else if constexpr (std::is_same_v<A, bool>)
-                        out += arg ? "true" : "false";
-                    else if constexpr (std::is_same_v<A, int64_t>)
-                        out += std::to_string(arg);
-                    else if constexpr (std::is_same_v<A, double>)
-                    {
-                        if (std::isnan(arg) || std::isinf(arg))
-                            out += "null";
-                        else
-                        {
-                            std::ostringstream oss;
-                            oss << std::setprecision(17) << arg;
-                            out += oss.str();
-                        }
-                    }
-                    else if constexpr (std::is_same_v<A, std::string>)
-                        AppendString(out, arg);
-                },
-                v->data);
         }
+
+        const std::size_t open = out.Open('{');
+        for (const Member& m : members)
+        {
+            out.String(m.key);
+            WriteMerged(out, m.values);
+        }
+        out.Close(open, members.size());
     }
 
-    // Serialize a simdjson DOM element to a JSON string. Used by
-    // GetSection() to produce a sub-tree that owns its own parser.
-    inline std::string SerializeElement(simdjson::dom::element el)
+    // True if @p a and @p b hold the same JSON value. Objects compare as
+    // unordered maps; arrays compare element by element.
+    inline bool ElementsEqual(simdjson::dom::element a,
+                              simdjson::dom::element b)
     {
-        std::string out;
-        // The single-pass DOM API does not allow walking the same
-        // element twice, so we accumulate the output into a single
-        // string in a single pass. The caller must keep the backing
-        // parser alive until the returned string is no longer needed.
-
-        std::function<void(simdjson::dom::element)> write;
-        write = [&](simdjson::dom::element e) {
-            switch (e.type())
-            {
-                case simdjson::dom::element_type::NULL_VALUE:
-                    out += "null";
-                    break;
-                case simdjson::dom::element_type::BOOL: {
-                    bool b;
-                    if (e.get_bool().get(b) == simdjson::SUCCESS)
-                        out += b ? "true" : "false";
-                    else
-                        out += "null";
-                    break;
-                }
-                case simdjson::dom::element_type::INT64: {
-                    int64_t i;
-                    if (e.get_int64().get(i) == simdjson::SUCCESS)
-                        out += std::to_string(i);
-                    else
-                        out += "null";
-                    break;
-                }
-                case simdjson::dom::element_type::UINT64: {
-                    uint64_t u;
-                    if (e.get_uint64().get(u) == simdjson::SUCCESS)
-                        out += std::to_string(u);
-                    else
-                        out += "null";
-                    break;
-                }
-                case simdjson::dom::element_type::DOUBLE: {
-                    double d;
-                    if (e.get_double().get(d) == simdjson::SUCCESS)
-                    {
-                        if (std::isnan(d) || std::isinf(d))
-                            out += "null";
-                        else
-                        {
-                            std::ostringstream oss;
-                            oss << std::setprecision(17) << d;
-                            out += oss.str();
-                        }
-                    }
-                    else
-                        out += "null";
-                    break;
-                }
-                case simdjson::dom::element_type::STRING: {
-                    std::string_view sv;
-                    if (e.get_string().get(sv) == simdjson::SUCCESS)
-                        AppendString(out, sv);
-                    else
-                        out += "null";
-                    break;
-                }
-                case simdjson::dom::element_type::ARRAY: {
-                    out.push_back('[');
-                    bool first = true;
-                    for (auto item : e.get_array())
-                    {
-                        if (!first)
-                            out.push_back(',');
-                        first = false;
-                        write(item);
-                    }
-                    out.push_back(']');
-                    break;
+        using simdjson::dom::element_type;
+        if (a.type() != b.type())
+            return false;
+        switch (a.type())
+        {
+            case element_type::ARRAY: {
+                auto lhs = a.get_array().value_unsafe();
+                auto rhs = b.get_array().value_unsafe();
+                if (lhs.size() != rhs.size())
+                    return false;
+                auto it = rhs.begin();
+                for (auto item : lhs)
+                {
+                    if (!ElementsEqual(item, *it))
+                        return false;
+                    ++it;
                 }
-                case simdjson::dom::element_type::OBJECT: {
-                    out.push_back('{');
-                    bool first = true;
-                    for (auto kv : e.get_object())
-                    {
-                        if (!first)
-                            out.push_back(',');
-                        first = false;
-                        AppendString(out, kv.key);
-                        out.push_back(':');
-                        write(kv.value);
-                    }
-                    out.push_back('}');
-                    break;
+                return true;
+            }
+            case element_type::OBJECT: {
+                auto lhs = a.get_object().value_unsafe();
+                auto rhs = b.get_object().value_unsafe();
+                if (lhs.size() != rhs.size())
+                    return false;
+                for (auto kv : lhs)
+                {
+                    simdjson::dom::element other;
+                    if (rhs.at_key(kv.key).get(other) != simdjson::SUCCESS ||
+                        !ElementsEqual(kv.value, other))
+                        return false;
                 }
+                return true;
             }
+            case element_type::INT64:
+                return a.get_int64().value_unsafe() ==
+                       b.get_int64().value_unsafe();
+            case element_type::UINT64:
+                return a.get_uint64().value_unsafe() ==
+                       b.get_uint64().value_unsafe();
+            case element_type::DOUBLE:
+                return a.get_double().value_unsafe() ==
+                       b.get_double().value_unsafe();
+            case element_type::STRING:
+                return a.get_string().value_unsafe() ==
+                       b.get_string().value_unsafe();
+            case element_type::BOOL:
+                return a.get_bool().value_unsafe() ==
+                       b.get_bool().value_unsafe();
+            case element_type::NULL_VALUE:
+                return true;
+        }
+        return false;
+    }
+
+    // Append to @p changed the dotted path of every value that differs
+    // between @p before and @p after. Objects present on both sides are
+    // compared member by member, so only the deepest differing paths are
+    // reported; added and removed members are reported at their own
+    // path, and anything else that differs at @p path itself.
+    inline void CollectChanges(simdjson::dom::element    before,
+                               simdjson::dom::element    after,
+                               std::string&              path,
+                               std::vector<std::string>& changed)
+    {
+        if (!before.is_object() || !after.is_object())
+        {
+            if (!ElementsEqual(before, after))
+                changed.push_back(path);
+            return;
+        }
+
+        const std::size_t base = path.size();
+        auto              push = [&](std::string_view key) {
+            path.resize(base);
+            if (base > 0)
+                path.push_back('.');
+            path.append(key);
         };
 
-        write(el);
-        return out;
+        std::unordered_map<std::string_view, simdjson::dom::element> rest;
+        for (auto kv : after.get_object())
+            rest.try_emplace(kv.key, kv.value);
+
+        for (auto kv : before.get_object())
+        {
+            push(kv.key);
+            auto it = rest.find(kv.key);
+            if (it == rest.end())
+            {
+                changed.push_back(path);
+                continue;
+            }
+            CollectChanges(kv.value, it->second, path, changed);
+            rest.erase(it);
+        }
+        // Walk @p after again so additions are reported in its order.
+        for (auto kv : after.get_object())
+        {
+            if (rest.erase(kv.key) == 0)
+                continue;
+            push(kv.key);
+            changed.push_back(path);
+        }
+        path.resize(base);
+    }
+
+    // True if a change at @p changed concerns a listener of @p key: one
+    // is the other or lies below it. An empty @p key matches everything.
+    inline bool PathsOverlap(std::string_view changed, std::string_view key)
+    {
+        auto below = [](std::string_view inner, std::string_view outer) {
+            return inner.size() > outer.size() && inner.starts_with(outer) &&
+                   inner[outer.size()] == '.';
+        };
+        return key.empty() || changed.empty() || changed == key ||
+               below(changed, key) || below(key, changed);
     }
 
     inline std::string SanitizeForError(std::string_view s,
@@ -436,9 +526,12 @@ namespace SKIRNIR_NAMESPACE::detail
         return out;
     }
 
-    inline simdjson::dom::element ParseOrThrow(simdjson::dom::parser& parser,
-                                               const std::string&     src,
-                                               std::string_view       what)
+    // @p src is a std::string or a simdjson::padded_string_view; the
+    // latter is parsed in place.
+    template <typename Json>
+    simdjson::dom::element ParseOrThrow(simdjson::dom::parser& parser,
+                                        const Json&            src,
+                                        std::string_view       what)
     {
         auto result = parser.parse(src);
         if (result.error() != simdjson::SUCCESS)
@@ -508,159 +601,411 @@ namespace SKIRNIR_NAMESPACE::detail
         return buffer;
     }
 
-    // Build a nested object tree from a flat dotted-key map. The leaf
-    // values are coerced: "true"/"false" become bool, fully-parseable
-    // integers and doubles become numbers, everything else stays a
-    // string. Shared by @c InMemorySource and @c
-    // EnvironmentVariablesSource.
-    inline Arc<JsonValue> BuildJsonTreeFromFlat(
-        const std::map<std::string, std::string>& flat)
+    // Mix @p value into @p seed, e.g. to fingerprint a list of sources.
+    inline std::uint64_t HashCombine(std::uint64_t seed,
+                                     std::uint64_t value) noexcept
     {
-        auto makeVal = [](JsonValue v) -> Arc<JsonValue> {
-            return skr::MakeArc<JsonValue>(std::move(v));
-        };
-        auto root = makeVal(JsonValue::FromObject());
-        for (const auto& [k, v] : flat)
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        seed ^= seed >> 31;
+        seed *= 0xbf58476d1ce4e5b9ull;
+        return seed ^ (seed >> 29);
+    }
+
+    inline std::uint64_t HashCombine(std::uint64_t    seed,
+                                     std::string_view bytes) noexcept
+    {
+        seed = HashCombine(seed, bytes.size());
+        return HashCombine(seed, std::hash<std::string_view> {}(bytes));
+    }
+
+    // Merge the current trees of @p sources into a new configuration.
+    // Sources own the parsers behind their roots, so they must stay alive
+    // until the merged tape has been written.
+    inline Arc<ConfigurationOptions> MergeSources(
+        std::span<const Arc<IConfigurationSource>> sources)
+    {
+        std::vector<simdjson::dom::element> layers;
+        layers.reserve(sources.size());
+        for (const auto& source : sources)
+        {
+            simdjson::dom::element root = source->Load();
+            // Non-object roots are ignored: a configuration source is
+            // expected to provide a top-level object.
+            if (root.is_object())
+                layers.push_back(root);
+        }
+
+        // Write the merged tape straight from the source DOMs; nothing is
+        // serialized or parsed in between.
+        TapeWriter tape;
+        WriteMerged(tape, layers);
+        auto document = std::move(tape).Finish();
+
+        const simdjson::dom::element root = document->root;
+        return MakeArc<ConfigurationOptions>(std::move(document), root,
+                                             std::string_view {}, true);
+    }
+
+    inline bool IsCSpace(char c) noexcept
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // Whether an out-of-range decimal literal @p digits (sign already
+    // removed) is too small rather than too large for a double, judged by
+    // the decimal exponent of its leading significant digit.
+    inline bool UnderflowsDouble(std::string_view digits) noexcept
+    {
+        const auto       e        = digits.find_first_of("eE");
+        std::string_view mantissa = digits.substr(0, e);
+        std::int64_t     exponent = 0;
+        if (e != std::string_view::npos)
+        {
+            std::string_view text = digits.substr(e + 1);
+            if (text.starts_with('+'))
+                text.remove_prefix(1);
+            auto res = std::from_chars(text.data(), text.data() + text.size(),
+                                       exponent);
+            if (res.ec == std::errc::result_out_of_range)
+                return text.starts_with('-');
+        }
+
+        // Position of the first significant digit relative to the point.
+        const auto   point    = mantissa.find('.');
+        const auto   integral = mantissa.substr(0, point);
+        const auto   lead     = integral.find_first_not_of('0');
+        std::int64_t scale    = 0;
+        if (lead != std::string_view::npos)
+        {
+            scale = static_cast<std::int64_t>(integral.size() - lead);
+        }
+        else if (point != std::string_view::npos)
+        {
+            const auto zeros = mantissa.find_first_not_of('0', point + 1);
+            scale = -static_cast<std::int64_t>(zeros - point - 1);
+        }
+        return scale + exponent <= 0;
+    }
+
+    // Write a flat-source leaf, coercing "true"/"false" to booleans and
+    // fully-parseable integers and doubles to numbers; everything else
+    // stays a string. Numbers are accepted as strtoll and strtod read them
+    // in the "C" locale, leading whitespace, '+' and hexadecimal floats
+    // included, but parsed with std::from_chars: no allocation, no
+    // exceptions and no locale lookups.
+    inline void AppendCoerced(std::string& out, std::string_view v)
+    {
+        if (v == "true" || v == "false")
+        {
+            out += v;
+            return;
+        }
+
+        std::string_view digits = v;
+        while (!digits.empty() && IsCSpace(digits.front()))
+            digits.remove_prefix(1);
+        const bool negative = !digits.empty() && digits.front() == '-';
+        if (!digits.empty() && (digits.front() == '-' || digits.front() == '+'))
+            digits.remove_prefix(1);
+        // from_chars would take a second '-' that the C functions reject.
+        if (digits.empty() || digits.front() == '-' || digits.front() == '+')
         {
-            Arc<JsonValue> cursor = root;
-            std::string_view           key    = k;
-            while (true)
+            AppendString(out, v);
+            return;
+        }
+        const char* begin = digits.data();
+        const char* end   = digits.data() + digits.size();
+
+        std::uint64_t magnitude = 0;
+        auto          res       = std::from_chars(begin, end, magnitude);
+        if (res.ptr == end && res.ec == std::errc {})
+        {
+            constexpr auto max = static_cast<std::uint64_t>(INT64_MAX);
+            if (!negative && magnitude <= max)
             {
-                auto dot = key.find('.');
-                if (dot == std::string_view::npos)
-                {
-                    std::string leaf(key);
-                    auto&       map = cursor->AsObject();
-                    if (v == "true")
-                        map[leaf] = makeVal(
-                            JsonValue::FromBool(true));
-                    else if (v == "false")
-                        map[leaf] = makeVal(
-                            JsonValue::FromBool(false));
-                    else
-                    {
-                        try
-                        {
-                            size_t  pos = 0;
-                            int64_t i   = std::stoll(v, &pos);
-                            if (pos == v.size())
-                            {
-                                map[leaf] = makeVal(
-                                    JsonValue::FromInt(i));
-                                break;
-                            }
-                        }
-                        catch (...)
-                        {
-                        }
-                        try
-                        {
-                            const char* begin = v.c_str();
-                            char*       end   = nullptr;
-                            double      d     = ::strtod(begin, &end);
-                            if (end != begin && end == begin + v.size())
-                            {
-                                map[leaf] = makeVal(
-                                    JsonValue::FromDouble(d));
-                                break;
-                            }
-                        }
-                        catch (...)
-                        {
-                        }
-                        map[leaf] = makeVal(
-                            JsonValue::FromString(v));
-                    }
-                    break;
-                }
+                AppendInteger(out, static_cast<std::int64_t>(magnitude));
+                return;
+            }
+            if (negative && magnitude <= max + 1)
+            {
+                AppendInteger(out,
+                              -static_cast<std::int64_t>(magnitude - 1) - 1);
+                return;
+            }
+        }
 
-                if (dot == 0)
-                {
-                    key = key.substr(1);
-                    continue;
-                }
+        // Integers that overflow int64 fall through to double, as strtod
+        // would take them after stoll gave up.
+        double     d   = 0.0;
+        const bool hex = digits.size() > 2 && digits[0] == '0' &&
+                         (digits[1] == 'x' || digits[1] == 'X') &&
+                         digits[2] != '-';
+        auto fp = hex ? std::from_chars(begin + 2, end, d,
+                                        std::chars_format::hex)
+                      : std::from_chars(begin, end, d);
+        if (fp.ptr != end)
+        {
+            AppendString(out, v);
+            return;
+        }
+        if (fp.ec == std::errc::result_out_of_range)
+            d = hex || !UnderflowsDouble(digits)
+                    ? std::numeric_limits<double>::infinity()
+                    : 0.0;
+        AppendDouble(out, negative ? -d : d);
+    }
 
-                std::string segment(key.substr(0, dot));
-                auto&       map = cursor->AsObject();
-                auto        it  = map.find(segment);
-                if (it == map.end())
-                {
-                    auto child = makeVal(
-                        JsonValue::FromObject());
-                    map[segment] = child;
-                    cursor       = child;
-                }
-                else
-                {
-                    if (!it->second->IsObject())
-                    {
-                        auto child = makeVal(
-                            JsonValue::FromObject());
-                        it->second = child;
-                    }
-                    cursor = it->second;
-                }
-                key = key.substr(dot + 1);
+    struct FlatEntry
+    {
+        std::size_t      begin; // first segment in the segment pool
+        std::size_t      depth; // number of segments
+        std::string_view value;
+        std::size_t      order; // later entries win at the same path
+    };
+
+    // Write the object holding every entry in [first, last), all of which
+    // share their first @p level segments and are sorted by path. Leaf
+    // values are written by @p appendLeaf.
+    template <typename AppendLeaf>
+    void AppendFlatLevel(std::string&                         out,
+                         const std::vector<std::string_view>& pool,
+                         FlatEntry*                           first,
+                         FlatEntry*                           last,
+                         std::size_t                          level,
+                         const AppendLeaf&                    appendLeaf)
+    {
+        out.push_back('{');
+        bool firstMember = true;
+        while (first != last)
+        {
+            const std::string_view key  = pool[first->begin + level];
+            FlatEntry*             next = first;
+            while (next != last && pool[next->begin + level] == key)
+                ++next;
+
+            // Sorting puts the leaves at this path ahead of the deeper
+            // entries; the latest leaf wins over deeper entries that came
+            // before it in the source map and loses to those after it.
+            const FlatEntry* leaf = nullptr;
+            FlatEntry*       deep = first;
+            while (deep != next && deep->depth == level + 1)
+            {
+                if (!leaf || deep->order > leaf->order)
+                    leaf = deep;
+                ++deep;
+            }
+            FlatEntry* deepEnd = next;
+            if (leaf)
+            {
+                const std::size_t cutoff = leaf->order;
+                deepEnd = std::remove_if(deep, next, [cutoff](const auto& e) {
+                    return e.order < cutoff;
+                });
             }
+
+            if (!firstMember)
+                out.push_back(',');
+            firstMember = false;
+            AppendString(out, key);
+            out.push_back(':');
+            if (deep != deepEnd)
+                AppendFlatLevel(out, pool, deep, deepEnd, level + 1,
+                                appendLeaf);
+            else
+                appendLeaf(out, leaf->value);
+            first = next;
         }
-        return root;
+        out.push_back('}');
     }
 
-    inline std::string BuildJsonFromFlat(
-        const std::map<std::string, std::string>& flat)
+    // Push the segments of the dotted @p key onto @p pool. Empty segments
+    // are skipped except for the last one, so "a..b" nests as "a.b" while
+    // "." stores an empty key at the root. With @p doubleUnderscore, "__"
+    // separates segments as well, read left to right the way a "__" to
+    // "." rewrite would.
+    inline void AppendKeySegments(std::vector<std::string_view>& pool,
+                                  std::string_view              key,
+                                  bool doubleUnderscore = false)
     {
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < key.size(); ++i)
+        {
+            std::size_t separator = 0;
+            if (key[i] == '.')
+                separator = 1;
+            else if (doubleUnderscore && key[i] == '_' &&
+                     i + 1 < key.size() && key[i + 1] == '_')
+                separator = 2;
+            if (separator == 0)
+                continue;
+            if (i > start)
+                pool.push_back(key.substr(start, i - start));
+            i += separator - 1;
+            start = i + 1;
+        }
+        pool.push_back(key.substr(start));
+    }
+
+    // Sort @p entries by path and write the object nesting all of them.
+    template <typename AppendLeaf>
+    std::string WriteFlatEntries(const std::vector<std::string_view>& pool,
+                                 std::vector<FlatEntry>&              entries,
+                                 const AppendLeaf&                    appendLeaf)
+    {
+        std::sort(entries.begin(), entries.end(),
+                  [&pool](const FlatEntry& a, const FlatEntry& b) {
+                      auto pa = pool.begin() + a.begin;
+                      auto pb = pool.begin() + b.begin;
+                      auto c  = std::lexicographical_compare_three_way(
+                          pa, pa + a.depth, pb, pb + b.depth);
+                      if (c != 0)
+                          return c < 0;
+                      return a.order < b.order;
+                  });
+
         std::string out;
-        Serialize(BuildJsonTreeFromFlat(flat), out, true);
+        AppendFlatLevel(out, pool, entries.data(),
+                        entries.data() + entries.size(), 0, appendLeaf);
         return out;
     }
 
-    inline std::vector<std::pair<std::string, std::string>> EnumerateEnv(
-        std::string_view prefix)
+    // Build the JSON object nesting every (dotted key, value) pair of
+    // @p flat in one pass, writing values with @p appendLeaf. Later pairs
+    // win over earlier ones at the same path.
+    template <typename Flat, typename AppendLeaf>
+    std::string BuildNestedJson(const Flat& flat, const AppendLeaf& appendLeaf)
     {
-        std::vector<std::pair<std::string, std::string>> result;
-        auto prependPrefixMatch = [&](std::string_view name) -> bool {
-            if (prefix.empty())
-                return true;
-            return name.size() >= prefix.size() &&
-                   name.compare(0, prefix.size(), prefix) == 0;
-        };
-#if defined(_WIN32)
-        char* block = ::GetEnvironmentStringsA();
-        if (!block)
-            return result;
-        for (char* p = block; *p; /* advance inside loop */)
+        std::vector<std::string_view> pool;
+        std::vector<FlatEntry>        entries;
+        entries.reserve(flat.size());
+        for (const auto& [k, v] : flat)
         {
-            std::string_view entry(p);
-            auto             eq = entry.find('=');
+            FlatEntry entry {pool.size(), 0, v, entries.size()};
+            AppendKeySegments(pool, k);
+            entry.depth = pool.size() - entry.begin;
+            entries.push_back(entry);
+        }
+        return WriteFlatEntries(pool, entries, appendLeaf);
+    }
+
+    // Build the JSON text for a flat dotted-key map, coercing each value
+    // from its string form. Shared by @c InMemorySource and
+    // @c EnvironmentVariablesSource.
+    inline std::string BuildJsonFromFlat(
+        const std::map<std::string, std::string>& flat)
+    {
+        return BuildNestedJson(flat, [](std::string& out, std::string_view v) {
+            AppendCoerced(out, v);
+        });
+    }
 
-            if (eq != std::string_view::npos && eq > 0 &&
-                prependPrefixMatch(entry.substr(0, eq)))
+    struct EnvVar
+    {
+        std::string_view name; // prefix stripped
+        std::string_view value;
+    };
+
+    // Compare two variable names as if every "__" were already a ".",
+    // i.e. in the order a map keyed by the rewritten names would keep.
+    inline int CompareEnvNames(std::string_view a, std::string_view b) noexcept
+    {
+        const auto next = [](std::string_view s, std::size_t& i) {
+            if (s[i] == '_' && i + 1 < s.size() && s[i + 1] == '_')
             {
-                std::string_view name = entry.substr(0, eq);
-                if (!prefix.empty())
-                    name.remove_prefix(prefix.size());
-                result.emplace_back(std::string(name),
-                                    std::string(entry.substr(eq + 1)));
+                i += 2;
+                return static_cast<unsigned char>('.');
             }
-            p += entry.size() + 1; // skip NUL terminator
+            return static_cast<unsigned char>(s[i++]);
+        };
+        std::size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            const unsigned char ca = next(a, i);
+            const unsigned char cb = next(b, j);
+            if (ca != cb)
+                return ca < cb ? -1 : 1;
         }
-        ::FreeEnvironmentStringsA(block);
-#else
-        for (char** p = environ; p && *p; ++p)
+        return int(i < a.size()) - int(j < b.size());
+    }
+
+    // Build the JSON text for environment variables straight from views
+    // into the environment: "__" separates sections like "." does, and
+    // conflicting names resolve exactly as they would after rewriting
+    // them into a std::map for @c BuildJsonFromFlat.
+    inline std::string BuildJsonFromEnvVars(std::vector<EnvVar>& vars)
+    {
+        // Rank by rewritten name; the stable sort keeps duplicates in
+        // environment order so the last one wins, as an assignment would.
+        std::stable_sort(vars.begin(), vars.end(),
+                         [](const EnvVar& a, const EnvVar& b) {
+                             return CompareEnvNames(a.name, b.name) < 0;
+                         });
+
+        std::vector<std::string_view> pool;
+        std::vector<FlatEntry>        entries;
+        pool.reserve(vars.size() * 2);
+        entries.reserve(vars.size());
+        for (const EnvVar& var : vars)
         {
-            std::string_view entry(*p);
-            auto             eq = entry.find('=');
+            FlatEntry entry {pool.size(), 0, var.value, entries.size()};
+            AppendKeySegments(pool, var.name, true);
+            entry.depth = pool.size() - entry.begin;
+            entries.push_back(entry);
+        }
+        return WriteFlatEntries(pool, entries,
+                                [](std::string& out, std::string_view v) {
+                                    AppendCoerced(out, v);
+                                });
+    }
+
+    // Call @p fn with the environment variables starting with @p prefix,
+    // prefix stripped, as views into the environment that stay valid for
+    // the duration of the call; returns what @p fn returns. The
+    // environment must not be modified concurrently, as for any getenv
+    // caller.
+    template <typename Fn>
+    decltype(auto) WithEnvVars(std::string_view prefix, Fn&& fn)
+    {
+        std::vector<EnvVar> vars;
+        const auto          add = [&](std::string_view entry) {
+            const auto eq = entry.find('=');
             if (eq == std::string_view::npos)
-                continue;
-            if (!prependPrefixMatch(entry.substr(0, eq)))
-                continue;
+                return;
             std::string_view name = entry.substr(0, eq);
-            if (!prefix.empty())
-                name.remove_prefix(prefix.size());
-            result.emplace_back(std::string(name),
-                                std::string(entry.substr(eq + 1)));
+            if (!name.starts_with(prefix))
+                return;
+            name.remove_prefix(prefix.size());
+            vars.push_back({name, entry.substr(eq + 1)});
+        };
+#if defined(_WIN32)
+        struct Block
+        {
+            char* p = ::GetEnvironmentStringsA();
+            ~Block()
+            {
+                if (p)
+                    ::FreeEnvironmentStringsA(p);
+            }
+        } block;
+        for (char* p = block.p; p && *p; p += std::strlen(p) + 1)
+        {
+            // Skip the hidden per-drive "=C:=C:\\..." entries.
+            if (*p != '=')
+                add(p);
         }
+#else
+        for (char** p = environ; p && *p; ++p)
+            add(*p);
 #endif
-        return result;
+        return fn(vars);
+    }
+
+    // Build the JSON text for the environment variables starting with
+    // @p prefix, without copying any name or value.
+    inline std::string BuildJsonFromEnv(std::string_view prefix)
+    {
+        return WithEnvVars(prefix, [](std::vector<EnvVar>& vars) {
+            return BuildJsonFromEnvVars(vars);
+        });
     }
 } // namespace SKIRNIR_NAMESPACE::detail
@@ -1,6 +1,5 @@
 #include "Skirnir/Configuration/EnvironmentVariablesSource.hpp"
 
-#include <map>
 #include <utility>
 
 #include "Detail.hpp"
@@ -15,28 +14,9 @@ namespace SKIRNIR_NAMESPACE
 
     std::string EnvironmentVariablesSource::BuildJson() const
     {
-        std::map<std::string, std::string> flat;
-        for (auto& [name, value] : detail::EnumerateEnv(mPrefix))
-        {
-            // "__" -> "." so that "DB__HOST" becomes "DB.HOST".
-            std::string key;
-            key.reserve(name.size());
-            for (size_t i = 0; i < name.size(); ++i)
-            {
-                if (i + 1 < name.size() && name[i] == '_' &&
-                    name[i + 1] == '_')
-                {
-                    key.push_back('.');
-                    ++i;
-                }
-                else
-                {
-                    key.push_back(name[i]);
-                }
-            }
-            flat[std::move(key)] = std::move(value);
-        }
-        return detail::BuildJsonFromFlat(flat);
+        // "__" -> "." so that "DB__HOST" becomes "DB.HOST"; names and
+        // values are read in place from the environment.
+        return detail::BuildJsonFromEnv(mPrefix);
     }
 
     simdjson::dom::element EnvironmentVariablesSource::Load()
@@ -51,4 +31,19 @@ namespace SKIRNIR_NAMESPACE
         }
         return mElement;
     }
+
+    bool EnvironmentVariablesSource::Fingerprint(std::uint64_t& hash) const
+    {
+        hash = detail::WithEnvVars(
+            mPrefix, [hash](const std::vector<detail::EnvVar>& vars) {
+                std::uint64_t h = detail::HashCombine(hash, vars.size());
+                for (const detail::EnvVar& var : vars)
+                {
+                    h = detail::HashCombine(detail::HashCombine(h, var.name),
+                                            var.value);
+                }
+                return h;
+            });
+        return true;
+    }
 } // namespace SKIRNIR_NAMESPACE
@@ -21,4 +21,12 @@ namespace SKIRNIR_NAMESPACE
         }
         return mElement;
     }
+
+    bool InMemorySource::Fingerprint(std::uint64_t& hash) const
+    {
+        for (const auto& [key, value] : mFlat)
+            hash = detail::HashCombine(detail::HashCombine(hash, key), value);
+        hash = detail::HashCombine(hash, mFlat.size());
+        return true;
+    }
 } // namespace SKIRNIR_NAMESPACE
@@ -2,25 +2,296 @@
 
 #include "Detail.hpp"
 
+#include <functional>
+#include <optional>
+#include <utility>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace SKIRNIR_NAMESPACE
 {
+    namespace
+    {
+#ifndef _WIN32
+        /**
+         * Read-only mapping of a whole file followed by at least
+         * SIMDJSON_PADDING readable bytes, so simdjson can parse it where it
+         * lies.
+         */
+        class MappedFile
+        {
+          public:
+            MappedFile(const std::filesystem::path& path, std::int64_t maxSize)
+            {
+                const std::string safePath =
+                    detail::SanitizeForError(path.string());
+                const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                {
+                    throw std::runtime_error(
+                        "Skirnir: failed to open config file '" + safePath +
+                        "'");
+                }
+                struct stat st {};
+                if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+                {
+                    ::close(fd);
+                    throw std::runtime_error("Skirnir: config file '" +
+                                             safePath +
+                                             "' is not a regular file");
+                }
+                mSize = static_cast<std::size_t>(st.st_size);
+                if (maxSize >= 0 && st.st_size > maxSize)
+                {
+                    ::close(fd);
+                    throw std::runtime_error(
+                        "Skirnir: config file '" + safePath +
+                        "' exceeds maximum allowed size");
+                }
+                if (mSize == 0)
+                {
+                    // Nothing to map; the parser reports the empty input.
+                    static const char empty[simdjson::SIMDJSON_PADDING] = {};
+                    ::close(fd);
+                    mData     = empty;
+                    mCapacity = sizeof(empty);
+                    return;
+                }
+
+                const std::size_t page =
+                    static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                const auto roundUp = [page](std::size_t n) {
+                    return (n + page - 1) / page * page;
+                };
+                void* map = MAP_FAILED;
+                if (roundUp(mSize) - mSize >= simdjson::SIMDJSON_PADDING)
+                {
+                    // The rest of the last page reads as zeros, which is
+                    // all the padding simdjson needs.
+                    mBytes = roundUp(mSize);
+                    map    = ::mmap(nullptr, mBytes, PROT_READ, MAP_PRIVATE,
+                                    fd, 0);
+                }
+                else
+                {
+                    // The file ends too close to a page boundary. Reserve
+                    // zeroed anonymous pages for the file plus padding and
+                    // map the file over their start, so only the padding
+                    // comes from the anonymous tail and nothing is copied.
+                    mBytes = roundUp(mSize + simdjson::SIMDJSON_PADDING);
+                    map    = ::mmap(nullptr, mBytes, PROT_READ,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                    if (map != MAP_FAILED &&
+                        ::mmap(map, mSize, PROT_READ, MAP_PRIVATE | MAP_FIXED,
+                               fd, 0) == MAP_FAILED)
+                    {
+                        ::munmap(map, mBytes);
+                        map = MAP_FAILED;
+                    }
+                }
+                ::close(fd);
+                if (map == MAP_FAILED)
+                {
+                    throw std::runtime_error("Skirnir: failed to map config "
+                                             "file '" +
+                                             safePath + "'");
+                }
+                mMap      = map;
+                mData     = static_cast<const char*>(map);
+                mCapacity = mBytes;
+            }
+
+            ~MappedFile()
+            {
+                if (mMap)
+                    ::munmap(mMap, mBytes);
+            }
+
+            MappedFile(const MappedFile&)            = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            simdjson::padded_string_view View() const noexcept
+            {
+                return simdjson::padded_string_view(mData, mSize, mCapacity);
+            }
+
+          private:
+            void*       mMap      = nullptr;
+            std::size_t mBytes    = 0;
+            const char* mData     = nullptr;
+            std::size_t mSize     = 0;
+            std::size_t mCapacity = 0;
+        };
+#endif
+
+        // JSON pointer for a dotted key, skipping empty segments but the
+        // last one the way the flat sources nest their keys.
+        std::string ToJsonPointer(std::string_view key)
+        {
+            std::string pointer;
+            for (;;)
+            {
+                const auto dot     = key.find('.');
+                const auto segment = key.substr(0, dot);
+                if (!segment.empty() || dot == std::string_view::npos)
+                {
+                    pointer.push_back('/');
+                    for (char c : segment)
+                    {
+                        if (c == '~')
+                            pointer += "~0";
+                        else if (c == '/')
+                            pointer += "~1";
+                        else
+                            pointer.push_back(c);
+                    }
+                }
+                if (dot == std::string_view::npos)
+                    return pointer;
+                key.remove_prefix(dot + 1);
+            }
+        }
+
+        // Scan @p content with the On-Demand API, copy out the raw JSON of
+        // each of @p keys and DOM-parse just those values, nested under
+        // their paths.
+        simdjson::dom::element ParseSelected(
+            simdjson::dom::parser&          parser,
+            simdjson::padded_string_view    content,
+            const std::vector<std::string>& keys,
+            std::string_view                what)
+        {
+            const auto fail = [what](simdjson::error_code error) {
+                return std::runtime_error(
+                    "Skirnir: failed to parse " +
+                    detail::SanitizeForError(what) + " as JSON (" +
+                    simdjson::error_message(error) + ")");
+            };
+
+            simdjson::ondemand::parser   scanner;
+            simdjson::ondemand::document document;
+            if (auto error = scanner.iterate(content).get(document))
+                throw fail(error);
+
+            std::vector<std::pair<std::string, std::string>> found;
+            found.reserve(keys.size());
+            for (const std::string& key : keys)
+            {
+                std::string_view raw;
+                auto error = document.at_pointer(ToJsonPointer(key))
+                                 .raw_json()
+                                 .get(raw);
+                switch (error)
+                {
+                    case simdjson::SUCCESS:
+                        found.emplace_back(key, std::string(raw));
+                        break;
+                    case simdjson::NO_SUCH_FIELD:
+                    case simdjson::INDEX_OUT_OF_BOUNDS:
+                    case simdjson::INCORRECT_TYPE:
+                    case simdjson::INVALID_JSON_POINTER: // through a scalar
+                        break;
+                    default:
+                        throw fail(error);
+                }
+            }
+
+            const std::string json = detail::BuildNestedJson(
+                found, [](std::string& out, std::string_view raw) {
+                    out += raw;
+                });
+            return detail::ParseOrThrow(parser, json, what);
+        }
+    } // namespace
+
     JsonFileSource::JsonFileSource(std::filesystem::path path,
                                    std::int64_t          maxSize) :
-        mPath(std::move(path)), mMaxSize(maxSize)
+        mPath(std::move(path))
+    {
+        mOptions.maxSize = maxSize;
+    }
+
+    JsonFileSource::JsonFileSource(std::filesystem::path path,
+                                   JsonFileSourceOptions options) :
+        mPath(std::move(path)), mOptions(std::move(options))
     {
     }
 
+    bool JsonFileSource::Fingerprint(std::uint64_t& hash) const
+    {
+        // Reading the file is far cheaper than parsing and merging it,
+        // and unlike the modification time alone cannot miss an edit.
+        const std::string content =
+            detail::ReadFileOrThrow(mPath, mOptions.maxSize);
+        std::error_code ec;
+        const auto      stamp = std::filesystem::last_write_time(mPath, ec);
+        hash = detail::HashCombine(hash, mPath.string());
+        hash = detail::HashCombine(
+            hash, static_cast<std::uint64_t>(stamp.time_since_epoch().count()));
+        hash = detail::HashCombine(hash, content);
+        for (const std::string& key : mOptions.keys)
+            hash = detail::HashCombine(hash, key);
+        hash = detail::HashCombine(hash, mOptions.keys.size());
+        return true;
+    }
+
     simdjson::dom::element JsonFileSource::Load()
     {
         if (!mLoaded)
+            Reload();
+        return mElement;
+    }
+
+    bool JsonFileSource::Reload()
+    {
+        std::string                  buffer;
+        simdjson::padded_string_view content;
+#ifndef _WIN32
+        std::optional<MappedFile> mapping;
+        if (mOptions.memoryMap)
         {
-            mContent = detail::ReadFileOrThrow(mPath, mMaxSize);
-            mElement = detail::ParseOrThrow(
-                mParser,
-                mContent,
-                "config file '" + mPath.string() + "'");
-            mLoaded = true;
+            mapping.emplace(mPath, mOptions.maxSize);
+            content = mapping->View();
         }
-        return mElement;
+        else
+#endif
+        {
+            buffer = detail::ReadFileOrThrow(mPath, mOptions.maxSize);
+            buffer.reserve(buffer.size() + simdjson::SIMDJSON_PADDING);
+            content = simdjson::padded_string_view(buffer.data(),
+                                                   buffer.size(),
+                                                   buffer.capacity());
+        }
+
+        // Neither the file nor a copy of it is kept after parsing, so a
+        // digest of the content stands in for it when checking for
+        // changes.
+        const std::string_view text(content.data(), content.size());
+        const std::size_t      hash = std::hash<std::string_view> {}(text);
+        if (mLoaded && text.size() == mContentSize && hash == mContentHash)
+            return false;
+
+        // Parse into a fresh parser so a bad file leaves the current tree
+        // untouched; the parser lives on the heap because elements point
+        // into it. The DOM copies every string it keeps, so the content
+        // can go once this returns.
+        auto              parser = std::make_unique<simdjson::dom::parser>();
+        const std::string what   = "config file '" + mPath.string() + "'";
+        auto element = mOptions.keys.empty()
+                           ? detail::ParseOrThrow(*parser, content, what)
+                           : ParseSelected(*parser, content, mOptions.keys,
+                                           what);
+
+        mContentSize = text.size();
+        mContentHash = hash;
+        mParser      = std::move(parser);
+        mElement     = element;
+        mLoaded      = true;
+        return true;
     }
 } // namespace SKIRNIR_NAMESPACE
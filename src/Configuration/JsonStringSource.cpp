@@ -18,4 +18,10 @@ namespace SKIRNIR_NAMESPACE
         }
         return mElement;
     }
+
+    bool JsonStringSource::Fingerprint(std::uint64_t& hash) const
+    {
+        hash = detail::HashCombine(hash, mContent);
+        return true;
+    }
 } // namespace SKIRNIR_NAMESPACE
@@ -0,0 +1,142 @@
+#include "LogRateLimiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    namespace
+    {
+        std::uint64_t HashLocation(const std::source_location& loc)
+        {
+            // file_name() points at a string literal, so its address
+            // identifies the file.
+            std::uint64_t h =
+                static_cast<std::uint64_t>(
+                    reinterpret_cast<std::uintptr_t>(loc.file_name())) *
+                0x9e3779b97f4a7c15ull;
+            h ^= (static_cast<std::uint64_t>(loc.line()) << 20) ^
+                 loc.column();
+            h *= 0xbf58476d1ce4e5b9ull;
+            h ^= h >> 31;
+            return h ? h : 1; // 0 marks an empty slot
+        }
+    } // namespace
+
+    void LogRateLimiter::SetPolicy(const LogRateLimit& policy)
+    {
+        std::lock_guard<std::mutex> lock(mPolicyMutex);
+        mPolicy = policy;
+
+        const double perSecond = policy.perSecond > 0 ? policy.perSecond : 1.0;
+        const auto   interval  = static_cast<std::int64_t>(
+            std::llround(1'000'000'000.0 / perSecond));
+        const std::uint32_t burst = std::max<std::uint32_t>(policy.burst, 1);
+
+        mIntervalNs.store(std::max<std::int64_t>(interval, 1),
+                          std::memory_order_relaxed);
+        mToleranceNs.store(interval * (burst - 1), std::memory_order_relaxed);
+        mSampleEvery.store(std::max<std::uint32_t>(policy.sampleEvery, 1),
+                           std::memory_order_relaxed);
+        mMaxLevel.store(policy.maxLevel, std::memory_order_relaxed);
+        mMode.store(policy.mode, std::memory_order_release);
+    }
+
+    LogRateLimit LogRateLimiter::Policy() const
+    {
+        std::lock_guard<std::mutex> lock(mPolicyMutex);
+        return mPolicy;
+    }
+
+    LogRateLimiter::Slot* LogRateLimiter::Find(const std::source_location& loc)
+    {
+        const std::uint64_t key = HashLocation(loc);
+        for (std::size_t probe = 0; probe < MaxProbe; ++probe)
+        {
+            Slot& slot = mSlots[(key + probe) % Capacity];
+            std::uint64_t seen = slot.key.load(std::memory_order_acquire);
+            if (seen == key)
+                return &slot;
+            if (seen == 0)
+            {
+                if (slot.key.compare_exchange_strong(
+                        seen, key, std::memory_order_acq_rel))
+                {
+                    slot.file = loc.file_name();
+                    slot.line = loc.line();
+                    slot.ready.store(true, std::memory_order_release);
+                    return &slot;
+                }
+                if (seen == key)
+                    return &slot; // another thread claimed it for us
+            }
+        }
+        return nullptr;
+    }
+
+    bool LogRateLimiter::Admit(LogLevel lvl, const std::source_location& loc,
+                               std::int64_t nowNs)
+    {
+        const auto mode = mMode.load(std::memory_order_acquire);
+        if (mode == LogRateLimitMode::Off || lvl == LogLevel::Fatal ||
+            lvl > mMaxLevel.load(std::memory_order_relaxed))
+            return true;
+
+        Slot* slot = Find(loc);
+        if (!slot)
+            return true;
+
+        bool admitted;
+        if (mode == LogRateLimitMode::Sample)
+        {
+            const auto every = mSampleEvery.load(std::memory_order_relaxed);
+            admitted =
+                slot->seen.fetch_add(1, std::memory_order_relaxed) % every == 0;
+        }
+        else
+        {
+            // GCRA: the record conforms if the theoretical arrival time
+            // is at most `tolerance` ahead of now.
+            const auto interval = mIntervalNs.load(std::memory_order_relaxed);
+            const auto tolerance =
+                mToleranceNs.load(std::memory_order_relaxed);
+            std::int64_t tat = slot->tat.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const std::int64_t start = std::max(tat, nowNs);
+                if (start - nowNs > tolerance)
+                {
+                    admitted = false;
+                    break;
+                }
+                if (slot->tat.compare_exchange_weak(
+                        tat, start + interval, std::memory_order_relaxed))
+                {
+                    admitted = true;
+                    break;
+                }
+            }
+        }
+
+        if (!admitted)
+            slot->suppressed.fetch_add(1, std::memory_order_relaxed);
+        return admitted;
+    }
+
+    std::vector<LogRateLimiter::Suppressed> LogRateLimiter::TakeSuppressed()
+    {
+        std::vector<Suppressed> out;
+        for (Slot& slot : mSlots)
+        {
+            if (!slot.ready.load(std::memory_order_acquire))
+                continue;
+            const auto count =
+                slot.suppressed.exchange(0, std::memory_order_relaxed);
+            if (count > 0)
+                out.push_back({slot.file, slot.line, count});
+        }
+        return out;
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
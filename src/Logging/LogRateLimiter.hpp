@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Skirnir/Logging/LogLevel.hpp"
+#include "Skirnir/Logging/LogRateLimit.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <source_location>
+#include <vector>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /**
+     * @brief Lock-free per-call-site limiter behind
+     *        @c LoggerOptions::SetRateLimit.
+     *
+     *  Call sites are found in a fixed open-addressing table keyed by a
+     *  hash of the source location; a new site claims its slot with one
+     *  CAS. The token bucket is kept as a single "theoretical arrival
+     *  time" (GCRA), so a rejected record costs the slot lookup, one
+     *  load and one counter increment. Sites that do not fit in the
+     *  table are never limited.
+     */
+    class LogRateLimiter
+    {
+      public:
+        struct Suppressed
+        {
+            const char*   file;
+            std::uint32_t line;
+            std::uint64_t count;
+        };
+
+        void          SetPolicy(const LogRateLimit& policy);
+        LogRateLimit  Policy() const;
+
+        /** @brief False when the record should be dropped. */
+        bool Admit(LogLevel lvl, const std::source_location& loc,
+                   std::int64_t nowNs);
+
+        /** @brief Per-site counts since the last call; resets them. */
+        std::vector<Suppressed> TakeSuppressed();
+
+      private:
+        static constexpr std::size_t Capacity = 1024;
+        static constexpr std::size_t MaxProbe = 16;
+
+        struct alignas(64) Slot
+        {
+            std::atomic<std::uint64_t> key {0};
+            std::atomic<bool>          ready {false};
+            const char*                file = nullptr; // set before ready
+            std::uint32_t              line = 0;
+            std::atomic<std::int64_t>  tat {0}; // token bucket
+            std::atomic<std::uint64_t> seen {0}; // sampling
+            std::atomic<std::uint64_t> suppressed {0};
+        };
+
+        Slot* Find(const std::source_location& loc);
+
+        std::array<Slot, Capacity> mSlots;
+
+        // Policy, published field by field. A record racing with
+        // SetPolicy may see a mix of old and new values, which only
+        // affects that one decision.
+        std::atomic<LogRateLimitMode> mMode {LogRateLimitMode::Off};
+        std::atomic<LogLevel>         mMaxLevel {LogLevel::Warning};
+        std::atomic<std::int64_t>     mIntervalNs {1'000'000'000};
+        std::atomic<std::int64_t>     mToleranceNs {9'000'000'000};
+        std::atomic<std::uint64_t>    mSampleEvery {100};
+
+        mutable std::mutex mPolicyMutex; // writers and Policy() only
+        LogRateLimit       mPolicy;
+    };
+} // namespace SKIRNIR_NAMESPACE::detail
@@ -54,7 +54,7 @@ namespace SKIRNIR_NAMESPACE
     void AsyncSink::Flush()
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        mCv.wait(lock, [this] { return mQueue.empty(); });
+        mCv.wait(lock, [this] { return mQueue.empty() && !mWriting; });
         if (mInner)
             mInner->Flush();
     }
@@ -83,9 +83,8 @@ namespace SKIRNIR_NAMESPACE
                 }
                 record = std::move(mQueue.front());
                 mQueue.pop_front();
+                mWriting = true;
             }
-            // Notify Flush() waiters that the queue shrank.
-            mCv.notify_all();
             try
             {
                 mInner->Write(record);
@@ -94,6 +93,12 @@ namespace SKIRNIR_NAMESPACE
             {
                 // Sinks must not throw; swallow defensively.
             }
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mWriting = false;
+            }
+            // Notify Flush() waiters that the record was written.
+            mCv.notify_all();
         }
     }
 } // namespace SKIRNIR_NAMESPACE
@@ -0,0 +1,240 @@
+#include "Skirnir/Common/Arc.hpp"
+#include "Skirnir/Logging/LogRecord.hpp"
+#include "Skirnir/Logging/LogSinks/BufferedSink.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace SKIRNIR_NAMESPACE
+{
+    /**
+     * @brief Single-producer/single-consumer ring owned by one thread.
+     *
+     * The producing thread only advances @c tail, the consumer (under
+     * @c BufferedSink::mDrainMutex) only advances @c head. The two
+     * indices live on separate cache lines so producers never share a
+     * written line with the flusher.
+     */
+    struct BufferedSink::ThreadBuffer
+    {
+        explicit ThreadBuffer(std::size_t capacity) :
+            slots(std::make_unique<LogRecord[]>(capacity)), mask(capacity - 1)
+        {
+        }
+
+        std::unique_ptr<LogRecord[]> slots;
+        std::size_t                  mask;
+
+        alignas(64) std::atomic<std::size_t> head {0};
+        alignas(64) std::atomic<std::size_t> tail {0};
+        std::atomic<std::uint64_t> dropped {0};
+        std::atomic<bool>          orphaned {false};
+    };
+
+    namespace
+    {
+        struct CachedBuffer
+        {
+            std::uint64_t                   sinkId;
+            Arc<BufferedSink::ThreadBuffer> buffer;
+        };
+
+        // Buffers of the calling thread, one per BufferedSink it has
+        // written to. Sinks are identified by a process-unique id rather
+        // than their address so a new sink reusing the storage of a
+        // destroyed one never picks up a stale buffer.
+        std::vector<CachedBuffer>& LocalCache()
+        {
+            thread_local std::vector<CachedBuffer> cache;
+            return cache;
+        }
+
+        std::uint64_t NextSinkId() noexcept
+        {
+            static std::atomic<std::uint64_t> next {1};
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // namespace
+
+    BufferedSink::BufferedSink(Arc<ILogSink>             inner,
+                               std::size_t               perThreadCapacity,
+                               std::chrono::milliseconds flushInterval) :
+        mInner(std::move(inner)),
+        mCapacity(std::bit_ceil(std::max<std::size_t>(perThreadCapacity, 2))),
+        mInterval(flushInterval.count() > 0 ? flushInterval
+                                            : std::chrono::milliseconds(1)),
+        mId(NextSinkId())
+    {
+        if (!mInner)
+        {
+            throw std::runtime_error(
+                "Skirnir: BufferedSink requires a non-null inner sink");
+        }
+        mFlusher =
+            std::jthread([this](std::stop_token st) { FlusherLoop(st); });
+    }
+
+    BufferedSink::~BufferedSink()
+    {
+        mFlusher.request_stop();
+        mWakeCv.notify_all();
+        if (mFlusher.joinable())
+            mFlusher.join();
+
+        {
+            std::lock_guard<std::mutex> lock(mDrainMutex);
+            Drain();
+        }
+        {
+            // Let producer threads discard their cached buffers lazily.
+            std::lock_guard<std::mutex> lock(mBuffersMutex);
+            for (auto& buffer : mBuffers)
+                buffer->orphaned.store(true, std::memory_order_relaxed);
+        }
+        mInner->Flush();
+    }
+
+    BufferedSink::ThreadBuffer& BufferedSink::LocalBuffer()
+    {
+        auto& cache = LocalCache();
+        for (auto& entry : cache)
+        {
+            if (entry.sinkId == mId)
+                return *entry.buffer;
+        }
+
+        // First write from this thread: drop entries of destroyed sinks
+        // and register a fresh buffer. This is the only time a producer
+        // takes a lock.
+        std::erase_if(cache, [](const CachedBuffer& entry) {
+            return entry.buffer->orphaned.load(std::memory_order_relaxed);
+        });
+
+        auto buffer = MakeArc<ThreadBuffer>(mCapacity);
+        {
+            std::lock_guard<std::mutex> lock(mBuffersMutex);
+            mBuffers.push_back(buffer);
+        }
+        cache.push_back({mId, buffer});
+        return *buffer;
+    }
+
+    void BufferedSink::Write(const LogRecord& r)
+    {
+        ThreadBuffer&     buffer = LocalBuffer();
+        const std::size_t tail   = buffer.tail.load(std::memory_order_relaxed);
+        const std::size_t head   = buffer.head.load(std::memory_order_acquire);
+        const std::size_t used   = tail - head;
+
+        if (used > buffer.mask)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.slots[tail & buffer.mask] = r;
+        buffer.tail.store(tail + 1, std::memory_order_release);
+
+        // Wake the flusher early once, when the ring reaches half full,
+        // instead of waiting for the next interval.
+        if (used + 1 == (buffer.mask + 1) / 2)
+        {
+            mWakeRequested.store(true, std::memory_order_relaxed);
+            mWakeCv.notify_one();
+        }
+    }
+
+    void BufferedSink::Flush()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mDrainMutex);
+            Drain();
+        }
+        mInner->Flush();
+    }
+
+    std::uint64_t BufferedSink::DroppedCount() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        std::uint64_t               total = mRetiredDropped;
+        for (const auto& buffer : mBuffers)
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    void BufferedSink::FlusherLoop(std::stop_token st)
+    {
+        while (!st.stop_requested())
+        {
+            {
+                std::unique_lock<std::mutex> lock(mWakeMutex);
+                mWakeCv.wait_for(lock, st, mInterval, [this] {
+                    return mWakeRequested.exchange(false,
+                                                   std::memory_order_relaxed);
+                });
+            }
+            if (st.stop_requested())
+                return;
+
+            std::lock_guard<std::mutex> lock(mDrainMutex);
+            Drain();
+        }
+    }
+
+    void BufferedSink::Drain()
+    {
+        // Called with mDrainMutex held.
+        {
+            std::lock_guard<std::mutex> lock(mBuffersMutex);
+            // A buffer only referenced by the registry belongs to a thread
+            // that has exited; retire it once it has been drained.
+            std::erase_if(mBuffers, [this](const Arc<ThreadBuffer>& buffer) {
+                if (buffer.use_count() != 1 ||
+                    buffer->head.load(std::memory_order_relaxed) !=
+                        buffer->tail.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                mRetiredDropped +=
+                    buffer->dropped.load(std::memory_order_relaxed);
+                return true;
+            });
+            mDraining.assign(mBuffers.begin(), mBuffers.end());
+        }
+
+        for (auto& buffer : mDraining)
+        {
+            const std::size_t head =
+                buffer->head.load(std::memory_order_relaxed);
+            const std::size_t tail =
+                buffer->tail.load(std::memory_order_acquire);
+            for (std::size_t i = head; i != tail; ++i)
+                mBatch.push_back(std::move(buffer->slots[i & buffer->mask]));
+            buffer->head.store(tail, std::memory_order_release);
+        }
+        mDraining.clear();
+
+        if (mBatch.empty())
+            return;
+
+        // Each ring is already in order; merge the threads by timestamp.
+        std::stable_sort(mBatch.begin(), mBatch.end(),
+                         [](const LogRecord& a, const LogRecord& b) {
+                             return a.timestamp < b.timestamp;
+                         });
+        try
+        {
+            mInner->WriteBatch(std::span<const LogRecord>(mBatch));
+        }
+        catch (...)
+        {
+            // Sinks must not throw; swallow defensively.
+        }
+        mBatch.clear();
+    }
+} // namespace SKIRNIR_NAMESPACE
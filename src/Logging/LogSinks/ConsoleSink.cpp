@@ -5,44 +5,57 @@
 
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 namespace SKIRNIR_NAMESPACE
 {
-    ConsoleSink::ConsoleSink(bool useColors) : mUseColors(useColors)
+    ConsoleSink::ConsoleSink(bool            useColors,
+                             TimestampFormat timestamps,
+                             bool            includeSource) :
+        mUseColors(useColors), mIncludeSource(includeSource),
+        mTimestamps(timestamps)
     {
     }
 
     void ConsoleSink::Write(const LogRecord& r)
     {
-        const std::string prefix =
-            detail::Format("[{}] {} '{}': ",
-                        detail::LevelName(r.level),
-                        detail::FormatTimestamp(r.timestamp),
-                        detail::SanitizeForLog(r.category, true));
+        const std::string category = detail::SanitizeForLog(r.category, true);
+
+        std::string source;
+        if (mIncludeSource && r.location.line() != 0)
+        {
+            source.append(" (");
+            detail::AppendSourceLocation(source, r);
+            source.push_back(')');
+        }
 
         std::string scopesStr;
         if (!r.scopes.empty())
         {
             scopesStr.push_back('[');
-            for (std::size_t i = 0; i < r.scopes.size(); ++i)
-            {
-                if (i)
+            bool first = true;
+            r.scopes.ForEach([&](const std::string& scope) {
+                if (!first)
                     scopesStr.push_back('/');
-                scopesStr.append(detail::SanitizeForLog(r.scopes[i], true));
-            }
+                first = false;
+                scopesStr.append(detail::SanitizeForLog(scope, true));
+            });
             scopesStr += "] ";
         }
 
+        const std::string message = detail::SanitizeForLog(r.message, true);
+
         std::lock_guard<std::mutex> lock(mMutex);
         (void) mUseColors; // color toggle reserved for future fmt branch
+        const std::string_view timestamp = mTimestamps.Format(r.timestamp);
 #ifdef SKIRNIR_USE_FMT
-        fmt::print("{}{}{}\n", prefix, scopesStr,
-                   detail::SanitizeForLog(r.message, true));
+        fmt::print("[{}] {} '{}'{}: {}{}\n", detail::LevelName(r.level),
+                   timestamp, category, source, scopesStr, message);
 #else
-        std::print("{}{}{}\n", prefix, scopesStr,
-                   detail::SanitizeForLog(r.message, true));
+        std::print("[{}] {} '{}'{}: {}{}\n", detail::LevelName(r.level),
+                   timestamp, category, source, scopesStr, message);
 #endif
     }
 } // namespace SKIRNIR_NAMESPACE
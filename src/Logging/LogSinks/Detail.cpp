@@ -1,10 +1,17 @@
 #include "Detail.hpp"
+#include "../../Common/EscapeScan.hpp"
 
 #include "Skirnir/Logging/LogLevel.hpp"
+#include "Skirnir/Logging/LogRecord.hpp"
+#include "Skirnir/Logging/LogSinks/FileSink.hpp"
 #include "Skirnir/Logging/Format.hpp"
+#include "Skirnir/Logging/TimestampFormat.hpp"
 
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <stdexcept>
 #include <system_error>
 
@@ -46,16 +53,14 @@ namespace SKIRNIR_NAMESPACE::detail
 
     std::string FormatTimestamp(std::chrono::system_clock::time_point tp)
     {
-        // Explicit chrono-specs: empty "{}" / ostream<< on sys_time is fragile
-        // on some libstdc++ / MinGW setups (throws in the format scanner).
-        return detail::Format("{:%F %T}", tp);
+        // Same text as "{:%F %T}", without chrono formatting per call.
+        thread_local TimestampFormatter formatter;
+        return std::string(formatter.Format(tp));
     }
 
-    std::string SanitizeForLog(std::string_view s, bool preserveTabs)
+    namespace
     {
-        std::string out;
-        out.reserve(s.size());
-        for (char c : s)
+        void AppendLogEscape(std::string& out, unsigned char c)
         {
             switch (c)
             {
@@ -66,10 +71,7 @@ namespace SKIRNIR_NAMESPACE::detail
                     out.append("\\n");
                     break;
                 case '\t':
-                    if (preserveTabs)
-                        out.push_back('\t');
-                    else
-                        out.append("\\t");
+                    out.append("\\t");
                     break;
                 case '\0':
                     out.append("\\0");
@@ -83,27 +85,114 @@ namespace SKIRNIR_NAMESPACE::detail
                 case '\v':
                     out.append("\\v");
                     break;
-                case '\x1b':
-                    out.append("\\x1b");
-                    break;
                 default:
                 {
-                    const auto u = static_cast<unsigned char>(c);
-                    if (u < 0x20 || u == 0x7f)
-                    {
-                        out.append(detail::Format("\\x{:02x}", u));
-                    }
-                    else
-                    {
-                        out.push_back(c);
-                    }
+                    // Remaining C0 controls (including ESC) and DEL.
+                    const char hex[4] = {'\\', 'x', HexDigitsLower[c >> 4],
+                                         HexDigitsLower[c & 0xf]};
+                    out.append(hex, sizeof(hex));
                     break;
                 }
             }
         }
+    } // namespace
+
+    std::string SanitizeForLog(std::string_view s, bool preserveTabs)
+    {
+        std::string out;
+        out.reserve(s.size());
+        if (preserveTabs)
+        {
+            AppendEscaped<EscapeSet::LogTextKeepTabs>(out, s.data(), s.size(),
+                                                      AppendLogEscape);
+        }
+        else
+        {
+            AppendEscaped<EscapeSet::LogText>(out, s.data(), s.size(),
+                                              AppendLogEscape);
+        }
         return out;
     }
 
+    void AppendSourceLocation(std::string& out, const LogRecord& r)
+    {
+        if (r.location.line() == 0)
+            return;
+        out.append(SanitizeForLog(r.location.file_name()));
+        out.push_back(':');
+        char       digits[16];
+        const auto res = std::to_chars(digits, digits + sizeof(digits),
+                                       r.location.line());
+        out.append(digits, res.ptr);
+    }
+
+    void AppendTextRecordTail(std::string& out, const LogRecord& r,
+                              bool includeSource)
+    {
+        out.append(" '");
+        out.append(SanitizeForLog(r.category));
+        out.push_back('\'');
+        if (includeSource && r.location.line() != 0)
+        {
+            out.append(" (");
+            AppendSourceLocation(out, r);
+            out.push_back(')');
+        }
+        out.append(": ");
+        if (!r.scopes.empty())
+        {
+            out.push_back('[');
+            bool first = true;
+            r.scopes.ForEach([&](const std::string& scope) {
+                if (!first)
+                    out.push_back('/');
+                first = false;
+                out.append(SanitizeForLog(scope));
+            });
+            out.append("] ");
+        }
+        out.append(SanitizeForLog(r.message));
+        out.push_back('\n');
+    }
+
+#ifndef _WIN32
+    namespace
+    {
+        // Shared by the stdio and raw-descriptor openers: creates with
+        // mode 0640, refuses symlinks and anything but a regular file.
+        LogFdOpenResult OpenCheckedFd(const std::filesystem::path& path,
+                                      int                          access)
+        {
+            int flags = access | O_CREAT | O_CLOEXEC;
+#  ifdef O_NOFOLLOW
+            flags |= O_NOFOLLOW;
+#  endif
+            const int fd = ::open(path.c_str(), flags, 0640);
+            if (fd < 0)
+            {
+                throw std::runtime_error(
+                    "Skirnir: failed to open log file '" + path.string() +
+                    "': " + std::strerror(errno));
+            }
+            struct stat st {};
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error(
+                    "Skirnir: cannot stat log file '" + path.string() + "'");
+            }
+            if (!S_ISREG(st.st_mode))
+            {
+                ::close(fd);
+                throw std::runtime_error(
+                    "Skirnir: log path is not a regular file: '" +
+                    path.string() + "'");
+            }
+            return {fd, static_cast<std::size_t>(st.st_size)};
+        }
+    } // namespace
+#endif
+
     LogFileOpenResult OpenSecureLogFile(const std::filesystem::path& path)
     {
         LogFileOpenResult r;
@@ -174,31 +263,8 @@ namespace SKIRNIR_NAMESPACE::detail
             r.currentSize = static_cast<std::size_t>(size.QuadPart);
         }
 #else
-        int flags = O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC;
-#  ifdef O_NOFOLLOW
-        flags |= O_NOFOLLOW;
-#  endif
-        const int fd = ::open(path.c_str(), flags, 0640);
-        if (fd < 0)
-        {
-            throw std::runtime_error(
-                "Skirnir: failed to open log file '" + path.string() +
-                "': " + std::strerror(errno));
-        }
-        struct stat st {};
-        if (::fstat(fd, &st) != 0)
-        {
-            ::close(fd);
-            throw std::runtime_error(
-                "Skirnir: cannot stat log file '" + path.string() + "'");
-        }
-        if (!S_ISREG(st.st_mode))
-        {
-            ::close(fd);
-            throw std::runtime_error(
-                "Skirnir: log path is not a regular file: '" + path.string() +
-                "'");
-        }
+        const auto opened = OpenCheckedFd(path, O_WRONLY | O_APPEND);
+        const int  fd     = opened.fd;
         r.file = ::fdopen(fd, "a");
         if (!r.file)
         {
@@ -206,13 +272,20 @@ namespace SKIRNIR_NAMESPACE::detail
             throw std::runtime_error(
                 "Skirnir: fdopen failed for '" + path.string() + "'");
         }
-        r.currentSize = static_cast<std::size_t>(st.st_size);
+        r.currentSize = opened.currentSize;
 #endif
         return r;
     }
 
-    void RotateLogFile(const std::filesystem::path& path,
-                       std::size_t                  maxFiles)
+#ifndef _WIN32
+    LogFdOpenResult OpenSecureLogFd(const std::filesystem::path& path)
+    {
+        return OpenCheckedFd(path, O_RDWR);
+    }
+#endif
+
+    void ShiftRotatedLogs(const std::filesystem::path& path,
+                          std::size_t                  maxFiles)
     {
         if (maxFiles == 0)
             return;
@@ -220,33 +293,105 @@ namespace SKIRNIR_NAMESPACE::detail
         namespace fs = std::filesystem;
         std::error_code ec;
 
-        // Drop the oldest slot, if any.
-        fs::path oldest = path;
-        oldest += ".";
-        oldest += std::to_string(maxFiles);
-        fs::remove(oldest, ec);
-        ec.clear();
-
-        // Shift older rotations up by one slot: path.(i-1) -> path.i
-        for (std::size_t i = maxFiles; i > 1; --i)
-        {
-            fs::path from = path;
-            from += ".";
-            from += std::to_string(i - 1);
-            fs::path to = path;
-            to += ".";
-            to += std::to_string(i);
-            if (fs::exists(from, ec))
+        // Rotated copies may be plain or gzipped; both move together.
+        const auto slot = [&](std::size_t i, bool gz) {
+            fs::path p = path;
+            p += "." + std::to_string(i);
+            if (gz)
+                p += ".gz";
+            return p;
+        };
+
+        for (bool gz : {false, true})
+        {
+            // Drop the oldest slot, if any.
+            fs::remove(slot(maxFiles, gz), ec);
+            ec.clear();
+
+            // Shift older rotations up by one slot: path.(i-1) -> path.i
+            for (std::size_t i = maxFiles; i > 1; --i)
             {
+                const fs::path from = slot(i - 1, gz);
+                if (fs::exists(from, ec))
+                {
+                    ec.clear();
+                    fs::rename(from, slot(i, gz), ec);
+                }
                 ec.clear();
-                fs::rename(from, to, ec);
             }
-            ec.clear();
         }
+    }
+
+    std::chrono::system_clock::time_point NextRotationTime(
+        RotationInterval interval, std::chrono::system_clock::time_point tp)
+    {
+        using namespace std::chrono;
+        switch (interval)
+        {
+            case RotationInterval::Hourly:
+                return floor<hours>(tp) + hours(1);
+            case RotationInterval::Daily:
+                return floor<days>(tp) + days(1);
+            case RotationInterval::Never:
+                break;
+        }
+        return system_clock::time_point::max();
+    }
+
+    std::chrono::system_clock::time_point FirstRotationTime(
+        RotationInterval interval, const std::filesystem::path& path,
+        std::size_t currentSize)
+    {
+        auto from = std::chrono::system_clock::now();
+        if (interval != RotationInterval::Never && currentSize > 0)
+        {
+            std::error_code ec;
+            const auto      written = std::filesystem::last_write_time(path, ec);
+            if (!ec)
+            {
+                from = std::chrono::time_point_cast<
+                    std::chrono::system_clock::duration>(
+                    std::chrono::file_clock::to_sys(written));
+            }
+        }
+        return NextRotationTime(interval, from);
+    }
+
+    bool FlushDue(const FlushPolicy& policy, LogLevel level,
+                  std::size_t unflushed) noexcept
+    {
+        if (unflushed == 0)
+            return false;
+        if (policy.level != LogLevel::None && level >= policy.level)
+            return true;
+        return policy.bytes > 0 && unflushed >= policy.bytes;
+    }
+
+    void FlushLogFile(std::FILE* file, bool sync) noexcept
+    {
+        std::fflush(file);
+        if (!sync)
+            return;
+#ifdef _WIN32
+        ::_commit(::_fileno(file));
+#else
+        ::fdatasync(::fileno(file));
+#endif
+    }
 
-        // Move current log to .1.
-        fs::path first = path;
-        first += ".1";
-        fs::rename(path, first, ec);
+    void RunEvery(std::stop_token st, std::chrono::milliseconds interval,
+                  const std::function<void()>& tick)
+    {
+        std::mutex                   mutex;
+        std::condition_variable_any  cv;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!st.stop_requested())
+        {
+            // Only a stop request wakes the wait early.
+            if (cv.wait_for(lock, st, interval, [] { return false; }) ||
+                st.stop_requested())
+                break;
+            tick();
+        }
     }
 } // namespace SKIRNIR_NAMESPACE::detail
@@ -6,16 +6,43 @@
 #include <cstddef>
 #include <cstdio>
 #include <filesystem>
+#include <functional>
+#include <stop_token>
 #include <string>
 #include <string_view>
 
+namespace SKIRNIR_NAMESPACE
+{
+    struct LogRecord;
+    struct FlushPolicy;
+    enum class RotationInterval;
+}
+
 namespace SKIRNIR_NAMESPACE::detail
 {
     const char* LevelName(LogLevel lvl);
 
     std::string SanitizeForLog(std::string_view s, bool preserveTabs = false);
 
-    /** Formats a log timestamp without empty chrono-specs / locale streaming. */
+    /**
+     * @brief Appends the part of a plain-text log line that follows the
+     *        timestamp: ` 'category': [scope/scope] message\n`, with
+     *        every field sanitized. With @p includeSource, records that
+     *        carry a call site get ` (file:line)` after the category.
+     */
+    void AppendTextRecordTail(std::string& out, const LogRecord& r,
+                              bool includeSource = false);
+
+    /**
+     * @brief Appends `file:line` of the record's call site, sanitized;
+     *        nothing for records without one.
+     */
+    void AppendSourceLocation(std::string& out, const LogRecord& r);
+
+    /**
+     * Formats a log timestamp like "{:%F %T}" using a thread-local
+     * cached @c TimestampFormatter.
+     */
     std::string FormatTimestamp(std::chrono::system_clock::time_point tp);
 
     struct LogFileOpenResult
@@ -36,14 +63,62 @@ namespace SKIRNIR_NAMESPACE::detail
      */
     LogFileOpenResult OpenSecureLogFile(const std::filesystem::path& path);
 
+#ifndef _WIN32
+    struct LogFdOpenResult
+    {
+        int         fd          = -1;
+        std::size_t currentSize = 0;
+    };
+
     /**
-     * @brief Rotates a log file by renaming `path` -> `path.1`,
-     *        `path.1` -> `path.2`, ... up to `path.maxFiles`.
-     *
-     *  The caller must close the file associated with `path` before
-     *  calling. `maxFiles` is the total number of rotated copies to
-     *  keep; if 0, the function does nothing.
+     * @brief Opens a log file read-write (not append) as a raw
+     *        descriptor, with the same hardening as
+     *        @c OpenSecureLogFile. Used where the file is mapped.
+     */
+    LogFdOpenResult OpenSecureLogFd(const std::filesystem::path& path);
+#endif
+
+    /**
+     * @brief Makes room for a new `path.1`: drops `path.maxFiles` and
+     *        moves `path.i` to `path.(i+1)`. Gzipped copies
+     *        (`path.i.gz`) are shifted alongside.
+     */
+    void ShiftRotatedLogs(const std::filesystem::path& path,
+                          std::size_t                  maxFiles);
+
+    /**
+     * @brief First instant at or after which a file opened at @p tp
+     *        must be rotated under @p interval; the maximum time point
+     *        when time-based rotation is off.
+     */
+    std::chrono::system_clock::time_point NextRotationTime(
+        RotationInterval interval, std::chrono::system_clock::time_point tp);
+
+    /**
+     * @brief @c NextRotationTime for a file just opened with
+     *        @p currentSize bytes: a non-empty file counts from its last
+     *        write, so a log left over from an earlier period is
+     *        rotated on the first record.
+     */
+    std::chrono::system_clock::time_point FirstRotationTime(
+        RotationInterval interval, const std::filesystem::path& path,
+        std::size_t currentSize);
+
+    /**
+     * @brief True when @p policy asks for a flush right after a record
+     *        at @p level, with @p unflushed bytes now pending. The
+     *        interval trigger is handled by @c RunEvery.
+     */
+    bool FlushDue(const FlushPolicy& policy, LogLevel level,
+                  std::size_t unflushed) noexcept;
+
+    /** @brief @c fflush, then optionally @c fdatasync (@c _commit). */
+    void FlushLogFile(std::FILE* file, bool sync) noexcept;
+
+    /**
+     * @brief Calls @p tick every @p interval until @p st is stopped.
+     *        Meant to be the body of a sink's timer @c std::jthread.
      */
-    void RotateLogFile(const std::filesystem::path& path,
-                       std::size_t                  maxFiles);
+    void RunEvery(std::stop_token st, std::chrono::milliseconds interval,
+                  const std::function<void()>& tick);
 }
@@ -1,11 +1,12 @@
 #include "Detail.hpp"
+#include "LogRotator.hpp"
 #include "Skirnir/Logging/LogRecord.hpp"
 #include "Skirnir/Logging/LogSinks/FileSink.hpp"
 
 #include <mutex>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
 
@@ -23,11 +24,12 @@ namespace SKIRNIR_NAMESPACE
         mPath(std::move(path)),
         mOptions([&] {
             FileSinkOptions o = options;
-            if (o.maxBytes > 0 && o.maxFiles == 0)
+            if ((o.maxBytes > 0 || o.rotateEvery != RotationInterval::Never) &&
+                o.maxFiles == 0)
                 o.maxFiles = 1; // sane default
             return o;
         }()),
-        mAutoFlush(autoFlush)
+        mTimestamps(mOptions.timestampFormat), mAutoFlush(autoFlush)
     {
         if (mOptions.rotateOnOpen && mOptions.maxBytes > 0)
         {
@@ -36,15 +38,38 @@ namespace SKIRNIR_NAMESPACE
             // Best-effort: any pre-existing rotated copies are kept.
         }
         OpenLocked();
+
+        if (mOptions.maxBytes > 0 ||
+            mOptions.rotateEvery != RotationInterval::Never)
+        {
+            mRotator = std::make_unique<detail::LogRotator>(
+                mPath, mOptions.maxFiles, mOptions.compressRotated);
+            mRotateAt = detail::FirstRotationTime(mOptions.rotateEvery, mPath,
+                                                  mCurrentSize);
+        }
+
+        if (mOptions.flushPolicy && mOptions.flushPolicy->interval.count() > 0)
+        {
+            mFlushTimer = std::jthread([this](std::stop_token st) {
+                detail::RunEvery(st, mOptions.flushPolicy->interval, [this] {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    FlushLocked();
+                });
+            });
+        }
     }
 
     FileSink::~FileSink()
     {
+        // The timer touches mFile; stop it before closing.
+        mFlushTimer = {};
         if (mFile)
         {
             std::fclose(mFile);
             mFile = nullptr;
         }
+        // Finishes any rotation still in progress.
+        mRotator.reset();
     }
 
     void FileSink::OpenLocked()
@@ -59,60 +84,90 @@ namespace SKIRNIR_NAMESPACE
 
     void FileSink::Write(const LogRecord& r)
     {
-        std::ostringstream oss;
-        oss << '[' << detail::LevelName(r.level) << "] "
-            << detail::FormatTimestamp(r.timestamp) << " '"
-            << detail::SanitizeForLog(r.category) << "': ";
-        if (!r.scopes.empty())
-        {
-            oss << '[';
-            for (std::size_t i = 0; i < r.scopes.size(); ++i)
-            {
-                if (i)
-                    oss << '/';
-                oss << detail::SanitizeForLog(r.scopes[i]);
-            }
-            oss << "] ";
-        }
-        oss << detail::SanitizeForLog(r.message) << '\n';
-        std::string line = oss.str();
+        // Everything after the timestamp is built outside the lock; the
+        // timestamp uses the sink's cached formatter under mMutex.
+        std::string tail;
+        detail::AppendTextRecordTail(tail, r, mOptions.includeSource);
 
         std::lock_guard<std::mutex> lock(mMutex);
         if (!mFile)
             return;
 
-        if (mOptions.maxBytes > 0 &&
-            mCurrentSize + line.size() > mOptions.maxBytes)
+        std::string line;
+        line.reserve(48 + tail.size());
+        line.push_back('[');
+        line.append(detail::LevelName(r.level));
+        line.append("] ");
+        line.append(mTimestamps.Format(r.timestamp));
+        line.append(tail);
+
+        if (r.timestamp >= mRotateAt)
         {
-            std::fclose(mFile);
-            mFile = nullptr;
-            detail::RotateLogFile(mPath, mOptions.maxFiles);
-            try
+            // A period with no records leaves nothing to rotate.
+            if (mCurrentSize > 0)
+                RotateLocked();
+            mRotateAt = detail::NextRotationTime(mOptions.rotateEvery,
+                                                 r.timestamp);
+        }
+        else if (mOptions.maxBytes > 0 &&
+                 mCurrentSize + line.size() > mOptions.maxBytes)
+        {
+            RotateLocked();
+        }
+
+        if (mFile)
+        {
+            std::fwrite(line.data(), 1, line.size(), mFile);
+            mCurrentSize += line.size();
+            mUnflushed += line.size();
+            if (mOptions.flushPolicy)
             {
-                auto reopened = detail::OpenSecureLogFile(mPath);
-                mFile        = reopened.file;
-                mCurrentSize = reopened.currentSize;
+                if (detail::FlushDue(*mOptions.flushPolicy, r.level,
+                                     mUnflushed))
+                    FlushLocked();
             }
-            catch (...)
+            else if (mAutoFlush)
             {
-                // Stay closed; subsequent Write() calls will be a no-op
-                // until the sink is replaced.
+                FlushLocked();
             }
         }
+    }
 
-        if (mFile)
+    void FileSink::RotateLocked()
+    {
+        // One rename under the lock; the rotator closes the old stream
+        // and shifts older copies in the background.
+        std::FILE* old = mFile;
+        mFile          = nullptr;
+        mUnflushed     = 0;
+        mRotator->Rotate(old);
+        try
         {
-            std::fwrite(line.data(), 1, line.size(), mFile);
-            mCurrentSize += line.size();
-            if (mAutoFlush)
-                std::fflush(mFile);
+            auto reopened = detail::OpenSecureLogFile(mPath);
+            mFile        = reopened.file;
+            mCurrentSize = reopened.currentSize;
+        }
+        catch (...)
+        {
+            // Stay closed; subsequent Write() calls will be a no-op
+            // until the sink is replaced.
         }
     }
 
+    void FileSink::FlushLocked()
+    {
+        if (!mFile || mUnflushed == 0)
+            return;
+        detail::FlushLogFile(mFile, mOptions.flushPolicy &&
+                                        mOptions.flushPolicy->sync);
+        mUnflushed = 0;
+    }
+
     void FileSink::Flush()
     {
+        // Same path as a policy flush: honours flushPolicy->sync and
+        // restarts the byte count.
         std::lock_guard<std::mutex> lock(mMutex);
-        if (mFile)
-            std::fflush(mFile);
+        FlushLocked();
     }
 } // namespace SKIRNIR_NAMESPACE
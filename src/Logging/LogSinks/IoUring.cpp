@@ -0,0 +1,159 @@
+#include "IoUring.hpp"
+
+#ifdef SKIRNIR_HAS_IO_URING
+#  include <algorithm>
+#  include <cerrno>
+#  include <cstring>
+
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    namespace
+    {
+        template <typename T>
+        T* At(void* base, std::uint32_t offset) noexcept
+        {
+            return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+        }
+    } // namespace
+
+    std::unique_ptr<IoUring> IoUring::TryCreate(unsigned entries) noexcept
+    {
+        io_uring_params params {};
+        const int fd = static_cast<int>(
+            ::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0)
+            return nullptr;
+
+        std::unique_ptr<IoUring> ring(new (std::nothrow) IoUring());
+        if (!ring)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        ring->mFd = fd;
+
+        ring->mSqRingBytes =
+            params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+        ring->mCqRingBytes =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+        {
+            ring->mSqRingBytes = ring->mCqRingBytes =
+                std::max(ring->mSqRingBytes, ring->mCqRingBytes);
+        }
+
+        void* sq = ::mmap(nullptr, ring->mSqRingBytes, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq == MAP_FAILED)
+            return nullptr;
+        ring->mSqRing = sq;
+
+        void* cq = sq;
+        if (!single)
+        {
+            cq = ::mmap(nullptr, ring->mCqRingBytes, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cq == MAP_FAILED)
+                return nullptr;
+        }
+        ring->mCqRing = cq;
+
+        ring->mSqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, ring->mSqesBytes, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+            return nullptr;
+        ring->mSqes = static_cast<io_uring_sqe*>(sqes);
+
+        ring->mSqHead  = At<std::uint32_t>(sq, params.sq_off.head);
+        ring->mSqTail  = At<std::uint32_t>(sq, params.sq_off.tail);
+        ring->mSqMask  = At<std::uint32_t>(sq, params.sq_off.ring_mask);
+        ring->mSqCount = params.sq_entries;
+        ring->mCqHead  = At<std::uint32_t>(cq, params.cq_off.head);
+        ring->mCqTail  = At<std::uint32_t>(cq, params.cq_off.tail);
+        ring->mCqMask  = At<std::uint32_t>(cq, params.cq_off.ring_mask);
+        ring->mCqes    = At<io_uring_cqe>(cq, params.cq_off.cqes);
+
+        // Slot i of the indirection array always points at SQE i.
+        auto* array = At<std::uint32_t>(sq, params.sq_off.array);
+        for (std::uint32_t i = 0; i < params.sq_entries; ++i)
+            array[i] = i;
+        ring->mLocalTail = *ring->mSqTail;
+
+        return ring;
+    }
+
+    IoUring::~IoUring()
+    {
+        if (mSqes)
+            ::munmap(mSqes, mSqesBytes);
+        if (mCqRing && mCqRing != mSqRing)
+            ::munmap(mCqRing, mCqRingBytes);
+        if (mSqRing)
+            ::munmap(mSqRing, mSqRingBytes);
+        if (mFd >= 0)
+            ::close(mFd);
+    }
+
+    bool IoUring::RegisterBuffers(std::span<const iovec> buffers) noexcept
+    {
+        return ::syscall(__NR_io_uring_register, mFd, IORING_REGISTER_BUFFERS,
+                         buffers.data(),
+                         static_cast<unsigned>(buffers.size())) == 0;
+    }
+
+    io_uring_sqe* IoUring::NextSqe() noexcept
+    {
+        const std::uint32_t head = std::atomic_ref<std::uint32_t>(*mSqHead)
+                                       .load(std::memory_order_acquire);
+        if (mLocalTail - head >= mSqCount)
+            return nullptr;
+
+        io_uring_sqe* sqe = &mSqes[mLocalTail & *mSqMask];
+        std::memset(sqe, 0, sizeof(*sqe));
+        ++mLocalTail;
+        return sqe;
+    }
+
+    int IoUring::SubmitAndWait(unsigned waitFor) noexcept
+    {
+        std::atomic_ref<std::uint32_t> tailRef(*mSqTail);
+        unsigned pending = mLocalTail - tailRef.load(std::memory_order_relaxed);
+        tailRef.store(mLocalTail, std::memory_order_release);
+
+        // Calls that take none of the pending entries, or fail with
+        // EAGAIN, in a row before giving up; the caller then falls back
+        // to plain writes instead of spinning on a ring that makes no
+        // progress.
+        constexpr int MaxStalls = 64;
+        int           stalls    = 0;
+        for (;;)
+        {
+            const int rc = static_cast<int>(
+                ::syscall(__NR_io_uring_enter, mFd, pending, waitFor,
+                          waitFor > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr,
+                          0));
+            if (rc > 0 || (rc == 0 && pending == 0))
+            {
+                pending -= std::min<unsigned>(pending,
+                                              static_cast<unsigned>(rc));
+                if (pending == 0)
+                    return 0;
+                stalls = 0;
+                continue;
+            }
+            if (rc < 0 && errno == EINTR)
+                continue;
+            if (rc < 0 && errno != EAGAIN)
+                return -errno;
+            if (++stalls >= MaxStalls)
+                return -EAGAIN;
+        }
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
+#endif
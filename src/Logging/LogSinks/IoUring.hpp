@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Skirnir/Common/Namespace.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#  define SKIRNIR_HAS_IO_URING 1
+#  include <linux/io_uring.h>
+#  include <sys/uio.h>
+#endif
+
+#ifdef SKIRNIR_HAS_IO_URING
+#  include <atomic>
+#  include <cstddef>
+#  include <cstdint>
+#  include <memory>
+#  include <span>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /**
+     * @brief Minimal io_uring instance driven through the raw system
+     *        calls, so no liburing is needed at build or run time.
+     *
+     *  Covers what the log writer needs: queueing SQEs, registering
+     *  buffers, submitting with a wait, and draining completions. Not
+     *  thread-safe; one thread owns the ring.
+     */
+    class IoUring
+    {
+      public:
+        /**
+         * @brief Sets up a ring with at least @p entries submission
+         *        slots. Returns null when the kernel refuses (no
+         *        io_uring support, seccomp, io_uring_disabled, ...).
+         */
+        static std::unique_ptr<IoUring> TryCreate(unsigned entries) noexcept;
+
+        ~IoUring();
+
+        IoUring(const IoUring&)            = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        /** @brief IORING_REGISTER_BUFFERS; false if the kernel refused. */
+        bool RegisterBuffers(std::span<const iovec> buffers) noexcept;
+
+        /**
+         * @brief Next free submission entry, zeroed, or null when the
+         *        queue is full. Queued entries are published by
+         *        @c SubmitAndWait.
+         */
+        io_uring_sqe* NextSqe() noexcept;
+
+        /**
+         * @brief Submits every queued entry and blocks until at least
+         *        @p waitFor completions are available.
+         *
+         * @return 0 on success, or a negative errno; @c -EAGAIN when
+         *         the kernel repeatedly accepts none of the entries.
+         */
+        int SubmitAndWait(unsigned waitFor) noexcept;
+
+        /** @brief Number of submission slots. */
+        unsigned Capacity() const noexcept
+        {
+            return mSqCount;
+        }
+
+        /** @brief Calls @p fn(user_data, res) for each completion. */
+        template <typename Fn>
+        unsigned DrainCompletions(Fn&& fn) noexcept
+        {
+            std::atomic_ref<std::uint32_t> headRef(*mCqHead);
+            std::atomic_ref<std::uint32_t> tailRef(*mCqTail);
+
+            std::uint32_t       head = headRef.load(std::memory_order_relaxed);
+            const std::uint32_t tail = tailRef.load(std::memory_order_acquire);
+            unsigned            seen = 0;
+            for (; head != tail; ++head, ++seen)
+            {
+                const io_uring_cqe& cqe = mCqes[head & *mCqMask];
+                fn(cqe.user_data, cqe.res);
+            }
+            headRef.store(head, std::memory_order_release);
+            return seen;
+        }
+
+      private:
+        IoUring() = default;
+
+        int mFd = -1;
+
+        void*       mSqRing      = nullptr;
+        std::size_t mSqRingBytes = 0;
+        void*       mCqRing      = nullptr; // aliases mSqRing if shared
+        std::size_t mCqRingBytes = 0;
+        io_uring_sqe* mSqes      = nullptr;
+        std::size_t   mSqesBytes = 0;
+
+        std::uint32_t* mSqHead  = nullptr;
+        std::uint32_t* mSqTail  = nullptr;
+        std::uint32_t* mSqMask  = nullptr;
+        std::uint32_t  mSqCount = 0;
+
+        std::uint32_t* mCqHead = nullptr;
+        std::uint32_t* mCqTail = nullptr;
+        std::uint32_t* mCqMask = nullptr;
+        io_uring_cqe*  mCqes   = nullptr;
+
+        // Entries handed out by NextSqe() but not yet published.
+        std::uint32_t mLocalTail = 0;
+    };
+} // namespace SKIRNIR_NAMESPACE::detail
+#else
+namespace SKIRNIR_NAMESPACE::detail
+{
+    // Keeps std::unique_ptr<IoUring> members complete on other targets.
+    class IoUring
+    {
+    };
+} // namespace SKIRNIR_NAMESPACE::detail
+#endif
@@ -1,17 +1,39 @@
 #include "Detail.hpp"
+#include "LogRotator.hpp"
+#include "NdjsonEncoder.hpp"
 #include "Skirnir/Logging/LogRecord.hpp"
 #include "Skirnir/Logging/LogSinks/JsonSink.hpp"
 
-#define SIMDJSON_STATIC_REFLECTION 1
-#include <simdjson.h>
-
-#include <cstring>
+#include <chrono>
+#include <cstddef>
 #include <mutex>
-#include <stdexcept>
+#include <span>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace SKIRNIR_NAMESPACE
 {
+    namespace
+    {
+        // Lines are encoded outside the sink lock into buffers that
+        // each thread reuses, so steady-state writes do not allocate.
+        struct ThreadEncoder
+        {
+            detail::NdjsonEncoder    encoder;
+            std::string              buffer;
+            std::vector<std::size_t> lineEnds; // for WriteBatch
+        };
+
+        ThreadEncoder& LocalEncoder()
+        {
+            thread_local ThreadEncoder state;
+            state.buffer.clear();
+            state.lineEnds.clear();
+            return state;
+        }
+    } // namespace
+
     JsonSink::JsonSink(std::ostream& os) : mOs(&os)
     {
     }
@@ -28,7 +50,8 @@ namespace SKIRNIR_NAMESPACE
         mPath(std::move(path)),
         mOptions([&] {
             FileSinkOptions o = options;
-            if (o.maxBytes > 0 && o.maxFiles == 0)
+            if ((o.maxBytes > 0 || o.rotateEvery != RotationInterval::Never) &&
+                o.maxFiles == 0)
                 o.maxFiles = 1;
             return o;
         }())
@@ -41,69 +64,144 @@ namespace SKIRNIR_NAMESPACE
         auto opened = detail::OpenSecureLogFile(mPath);
         mFile        = opened.file;
         mCurrentSize = opened.currentSize;
+
+        if (mOptions.maxBytes > 0 ||
+            mOptions.rotateEvery != RotationInterval::Never)
+        {
+            mRotator = std::make_unique<detail::LogRotator>(
+                mPath, mOptions.maxFiles, mOptions.compressRotated);
+            mRotateAt = detail::FirstRotationTime(mOptions.rotateEvery, mPath,
+                                                  mCurrentSize);
+        }
+        StartFlushTimer();
+    }
+
+    void JsonSink::StartFlushTimer()
+    {
+        if (!mOptions.flushPolicy ||
+            mOptions.flushPolicy->interval.count() <= 0)
+            return;
+        mFlushTimer = std::jthread([this](std::stop_token st) {
+            detail::RunEvery(st, mOptions.flushPolicy->interval, [this] {
+                std::lock_guard<std::mutex> lock(mMutex);
+                FlushLocked();
+            });
+        });
     }
 
     JsonSink::~JsonSink()
     {
+        // The timer touches mFile; stop it before closing.
+        mFlushTimer = {};
         if (mFile)
         {
             std::fclose(mFile);
             mFile = nullptr;
         }
+        // Finishes any rotation still in progress.
+        mRotator.reset();
     }
 
     void JsonSink::Write(const LogRecord& r)
     {
-        auto json = simdjson::to_json(r);
+        ThreadEncoder& local = LocalEncoder();
+        local.encoder.Append(local.buffer, r, mOptions.timestampFormat,
+                             mOptions.includeSource);
 
-        if (!json.has_value())
-            return;
+        std::lock_guard<std::mutex> lock(mMutex);
+        WriteLocked(local.buffer, r);
+    }
 
-        const std::string_view line = json.value();
-        // simdjson::to_json does not include the trailing newline that
-        // NDJSON expects; append it here.
-        const std::size_t      totalSize = line.size() + 1;
+    void JsonSink::WriteBatch(std::span<const LogRecord> records)
+    {
+        ThreadEncoder& local = LocalEncoder();
+        for (const auto& r : records)
+        {
+            local.encoder.Append(local.buffer, r, mOptions.timestampFormat,
+                                 mOptions.includeSource);
+            local.lineEnds.push_back(local.buffer.size());
+        }
 
+        // One lock for the whole batch. File output still goes line by
+        // line so that rotation and flush triggers see every record.
         std::lock_guard<std::mutex> lock(mMutex);
+        std::size_t                 start = 0;
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            const std::size_t end = local.lineEnds[i];
+            WriteLocked(std::string_view(local.buffer).substr(start,
+                                                              end - start),
+                        records[i]);
+            start = end;
+        }
+    }
 
-        if (mFile)
+    void JsonSink::WriteLocked(std::string_view line, const LogRecord& r)
+    {
+        if (mOs)
         {
-            if (mOptions.maxBytes > 0 &&
-                mCurrentSize + totalSize > mOptions.maxBytes)
-            {
-                std::fclose(mFile);
-                mFile = nullptr;
-                detail::RotateLogFile(mPath, mOptions.maxFiles);
-                try
-                {
-                    auto reopened = detail::OpenSecureLogFile(mPath);
-                    mFile        = reopened.file;
-                    mCurrentSize = reopened.currentSize;
-                }
-                catch (...)
-                {
-                }
-            }
-
-            if (mFile)
-            {
-                if (line.size() > 0)
-                    std::fwrite(line.data(), 1, line.size(), mFile);
-                std::fputc('\n', mFile);
-                mCurrentSize += totalSize;
-            }
+            mOs->write(line.data(), static_cast<std::streamsize>(line.size()));
+            return;
         }
-        else if (mOs)
+        if (!mFile)
+            return;
+
+        if (r.timestamp >= mRotateAt)
+        {
+            if (mCurrentSize > 0)
+                RotateLocked();
+            mRotateAt =
+                detail::NextRotationTime(mOptions.rotateEvery, r.timestamp);
+        }
+        else if (mOptions.maxBytes > 0 &&
+                 mCurrentSize + line.size() > mOptions.maxBytes)
+        {
+            RotateLocked();
+        }
+
+        if (!mFile)
+            return;
+        std::fwrite(line.data(), 1, line.size(), mFile);
+        mCurrentSize += line.size();
+        mUnflushed += line.size();
+        if (mOptions.flushPolicy &&
+            detail::FlushDue(*mOptions.flushPolicy, r.level, mUnflushed))
+            FlushLocked();
+    }
+
+    void JsonSink::RotateLocked()
+    {
+        std::FILE* old = mFile;
+        mFile          = nullptr;
+        mUnflushed     = 0;
+        mRotator->Rotate(old);
+        try
         {
-            (*mOs) << line << '\n';
+            auto reopened = detail::OpenSecureLogFile(mPath);
+            mFile        = reopened.file;
+            mCurrentSize = reopened.currentSize;
         }
+        catch (...)
+        {
+        }
+    }
+
+    void JsonSink::FlushLocked()
+    {
+        if (!mFile || mUnflushed == 0)
+            return;
+        detail::FlushLogFile(mFile, mOptions.flushPolicy &&
+                                        mOptions.flushPolicy->sync);
+        mUnflushed = 0;
     }
 
     void JsonSink::Flush()
     {
+        // Same path as a policy flush: honours flushPolicy->sync and
+        // restarts the byte count.
         std::lock_guard<std::mutex> lock(mMutex);
         if (mFile)
-            std::fflush(mFile);
+            FlushLocked();
         else if (mOs)
             mOs->flush();
     }
@@ -0,0 +1,247 @@
+#include "LogRotator.hpp"
+#include "Detail.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef SKIRNIR_USE_ZLIB
+#  include <zlib.h>
+#  ifndef _WIN32
+#    include <fcntl.h>
+#    include <unistd.h>
+#  endif
+#endif
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    namespace
+    {
+#ifdef SKIRNIR_USE_ZLIB
+        // Streams @p from into a gzip file at @p to. Returns false (and
+        // removes the partial output) on any failure.
+        bool GzipFile(const std::filesystem::path& from,
+                      const std::filesystem::path& to)
+        {
+            std::FILE* in = std::fopen(from.string().c_str(), "rb");
+            if (!in)
+                return false;
+
+#  ifdef _WIN32
+            gzFile out = ::gzopen(to.string().c_str(), "wb6");
+#  else
+            int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+#    ifdef O_NOFOLLOW
+            flags |= O_NOFOLLOW;
+#    endif
+            const int fd  = ::open(to.c_str(), flags, 0640);
+            gzFile    out = fd >= 0 ? ::gzdopen(fd, "wb6") : nullptr;
+            if (!out && fd >= 0)
+                ::close(fd);
+#  endif
+            if (!out)
+            {
+                std::fclose(in);
+                return false;
+            }
+
+            char buffer[64 * 1024];
+            bool ok = true;
+            for (;;)
+            {
+                const std::size_t n = std::fread(buffer, 1, sizeof(buffer), in);
+                if (n > 0 &&
+                    ::gzwrite(out, buffer, static_cast<unsigned>(n)) !=
+                        static_cast<int>(n))
+                {
+                    ok = false;
+                    break;
+                }
+                if (n < sizeof(buffer))
+                {
+                    ok = !std::ferror(in);
+                    break;
+                }
+            }
+            ok = ::gzclose(out) == Z_OK && ok;
+            std::fclose(in);
+
+            if (!ok)
+            {
+                std::error_code ec;
+                std::filesystem::remove(to, ec);
+            }
+            return ok;
+        }
+#endif
+    } // namespace
+
+    LogRotator::LogRotator(std::filesystem::path path, std::size_t maxFiles,
+                           bool compress) :
+        mPath(std::move(path)), mMaxFiles(maxFiles), mCompress(compress),
+        // Seeded from the clock so pending names never collide with
+        // leftovers of an earlier process.
+        mSeq(static_cast<std::uint64_t>(
+            std::chrono::system_clock::now().time_since_epoch().count()))
+    {
+#ifndef SKIRNIR_USE_ZLIB
+        if (mCompress)
+        {
+            throw std::runtime_error(
+                "Skirnir: compressRotated requires a build with "
+                "SKIRNIR_USE_ZLIB");
+        }
+#endif
+        RecoverPending();
+        mWorker = std::jthread([this](std::stop_token st) { Run(st); });
+    }
+
+    void LogRotator::RecoverPending()
+    {
+        // `path.pending-N` is renamed aside but not yet shifted to .1;
+        // `path.pending-N.gz` next to it is a partial gzip, and alone a
+        // finished one whose source was already removed.
+        struct Orphan
+        {
+            std::uint64_t         seq;
+            bool                  gz;
+            std::filesystem::path path;
+        };
+
+        const std::string prefix = mPath.filename().string() + ".pending-";
+        std::filesystem::path dir = mPath.parent_path();
+        if (dir.empty())
+            dir = ".";
+
+        std::vector<Orphan> orphans;
+        std::error_code     ec;
+        for (std::filesystem::directory_iterator it(dir, ec), end;
+             !ec && it != end; it.increment(ec))
+        {
+            const std::string name = it->path().filename().string();
+            if (!name.starts_with(prefix) ||
+                !std::filesystem::is_regular_file(it->symlink_status()))
+                continue;
+            std::string_view digits = std::string_view(name).substr(
+                prefix.size());
+            const bool gz = digits.ends_with(".gz");
+            if (gz)
+                digits.remove_suffix(3);
+            std::uint64_t seq  = 0;
+            const auto    last = digits.data() + digits.size();
+            auto [ptr, err]    = std::from_chars(digits.data(), last, seq);
+            if (digits.empty() || err != std::errc {} || ptr != last)
+                continue;
+            orphans.push_back({seq, gz, it->path()});
+        }
+
+        // Sequence numbers grow across processes, since each rotator
+        // seeds them from the clock, so this is rotation order.
+        std::sort(orphans.begin(), orphans.end(),
+                  [](const Orphan& a, const Orphan& b) {
+                      return a.seq != b.seq ? a.seq < b.seq : a.gz < b.gz;
+                  });
+        for (std::size_t i = 0; i < orphans.size(); ++i)
+        {
+            const Orphan& o = orphans[i];
+            if (o.gz && i > 0 && orphans[i - 1].seq == o.seq)
+            {
+                std::filesystem::remove(o.path, ec);
+                continue;
+            }
+            mQueue.push_back({nullptr, o.path, o.gz});
+        }
+    }
+
+    LogRotator::~LogRotator()
+    {
+        // Run() drains the queue before honouring the stop request.
+        mWorker.request_stop();
+        if (mWorker.joinable())
+            mWorker.join();
+    }
+
+    void LogRotator::Rotate(std::FILE* old)
+    {
+        Job job {old, {}};
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mMaxFiles > 0)
+        {
+            std::filesystem::path pending = mPath;
+            pending += ".pending-" + std::to_string(++mSeq);
+            std::error_code ec;
+            std::filesystem::rename(mPath, pending, ec);
+            if (!ec)
+                job.pending = std::move(pending);
+        }
+        mQueue.push_back(std::move(job));
+        mCv.notify_one();
+    }
+
+    void LogRotator::WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdleCv.wait(lock, [&] { return mQueue.empty() && !mBusy; });
+    }
+
+    void LogRotator::Run(std::stop_token st)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (;;)
+        {
+            mCv.wait(lock, st, [&] { return !mQueue.empty(); });
+            if (mQueue.empty())
+                return; // stop requested and nothing left
+
+            Job job = std::move(mQueue.front());
+            mQueue.pop_front();
+            mBusy = true;
+
+            lock.unlock();
+            Process(job);
+            lock.lock();
+
+            mBusy = false;
+            mIdleCv.notify_all();
+        }
+    }
+
+    void LogRotator::Process(Job& job)
+    {
+        // Closing flushes what is still buffered, which may block on
+        // I/O; that is why the stream is handed over instead.
+        if (job.file)
+            std::fclose(job.file);
+        if (job.pending.empty())
+            return;
+
+        std::error_code       ec;
+        std::filesystem::path source     = job.pending;
+        bool                  compressed = job.compressed;
+#ifdef SKIRNIR_USE_ZLIB
+        if (mCompress && !compressed)
+        {
+            std::filesystem::path gz = source;
+            gz += ".gz";
+            if (GzipFile(source, gz))
+            {
+                std::filesystem::remove(source, ec);
+                source     = std::move(gz);
+                compressed = true;
+            }
+        }
+#endif
+
+        ShiftRotatedLogs(mPath, mMaxFiles);
+
+        std::filesystem::path first = mPath;
+        first += compressed ? ".1.gz" : ".1";
+        std::filesystem::rename(source, first, ec);
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
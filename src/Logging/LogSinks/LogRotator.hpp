@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Skirnir/Common/Namespace.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /**
+     * @brief Moves rotation work off a sink's write path.
+     *
+     *  @c Rotate performs a single rename of the live file to a
+     *  pending name, so the sink can open a fresh file right away. A
+     *  background thread then closes the old stream, optionally gzips
+     *  it, shifts `path.1`..`path.N` up by one and drops the oldest.
+     *  Rotations are processed in order; the destructor finishes all
+     *  queued work before returning. Pending files left behind by a
+     *  process that stopped mid-rotation are picked up on construction
+     *  and finished first.
+     */
+    class LogRotator
+    {
+      public:
+        LogRotator(std::filesystem::path path, std::size_t maxFiles,
+                   bool compress);
+        ~LogRotator();
+
+        LogRotator(const LogRotator&)            = delete;
+        LogRotator& operator=(const LogRotator&) = delete;
+
+        /**
+         * @brief Renames the live file aside and queues the rest.
+         *
+         *  Call with the sink's lock held, before reopening the path.
+         *  @p old (may be null) is the stream still open on the file;
+         *  ownership passes to the rotator, which closes it.
+         */
+        void Rotate(std::FILE* old);
+
+        /** @brief Blocks until every queued rotation has finished. */
+        void WaitIdle();
+
+      private:
+        struct Job
+        {
+            std::FILE*            file = nullptr;
+            std::filesystem::path pending; // empty if the rename failed
+            bool                  compressed = false; // pending is a .gz
+        };
+
+        void RecoverPending();
+        void Run(std::stop_token st);
+        void Process(Job& job);
+
+        std::filesystem::path mPath;
+        std::size_t           mMaxFiles;
+        bool                  mCompress;
+
+        std::mutex                  mMutex;
+        std::condition_variable_any mCv;
+        std::condition_variable     mIdleCv;
+        std::deque<Job>             mQueue;
+        bool                        mBusy = false;
+        std::uint64_t               mSeq  = 0;
+
+        std::jthread mWorker;
+    };
+} // namespace SKIRNIR_NAMESPACE::detail
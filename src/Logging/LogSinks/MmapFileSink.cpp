@@ -0,0 +1,588 @@
+#include "Detail.hpp"
+#include "LogRotator.hpp"
+#include "Skirnir/Logging/LogRecord.hpp"
+#include "Skirnir/Logging/LogSinks/MmapFileSink.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace SKIRNIR_NAMESPACE
+{
+#ifndef _WIN32
+    namespace detail
+    {
+        inline std::size_t LogPageSize() noexcept
+        {
+            static const std::size_t page =
+                static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return page;
+        }
+
+        /**
+         * @brief One mapped window of the log file.
+         *
+         *  The window starts at the page boundary at or below
+         *  @c start - @c lead; producers reserve bytes in [start, start +
+         *  capacity) by bumping @c reserved and add them to
+         *  @c committed once copied. When the segment is replaced,
+         *  @c sealed records how many bytes were reserved inside it, so
+         *  the mapping can be released once @c committed catches up.
+         */
+        struct MmapSegment
+        {
+            // Closes the descriptor once the last segment of a file is
+            // released; mappings outlive it on their own.
+            struct FileHandle
+            {
+                int fd = -1;
+
+                ~FileHandle()
+                {
+                    if (fd >= 0)
+                        ::close(fd);
+                }
+            };
+
+            std::shared_ptr<FileHandle> file;
+
+            char*       map      = nullptr;
+            std::size_t mapBytes = 0;
+            std::size_t lead     = 0; // start - page-aligned map offset
+            std::size_t start    = 0; // file offset of the first slot
+            std::size_t capacity = 0;
+
+            // Spares only: the segment this one continues, or, with
+            // `fresh`, a new file at the successor path instead.
+            const MmapSegment* basis = nullptr;
+            bool               fresh = false;
+
+            std::atomic<std::size_t> reserved {0};
+            std::atomic<std::size_t> committed {0};
+            std::atomic<std::size_t> sealed {SIZE_MAX};
+            std::atomic<bool>        retired {false};
+
+            ~MmapSegment()
+            {
+                Unmap();
+            }
+
+            std::size_t Used() const noexcept
+            {
+                return std::min(reserved.load(std::memory_order_acquire),
+                                capacity);
+            }
+
+            // msync of [from, to) relative to start, widened to pages.
+            void Sync(std::size_t from, std::size_t to) const noexcept
+            {
+                const std::size_t page  = LogPageSize();
+                const std::size_t begin = (lead + from) / page * page;
+                const std::size_t end   = lead + to;
+                if (map && end > begin)
+                    ::msync(map + begin, end - begin, MS_SYNC);
+            }
+
+            void Unmap() noexcept
+            {
+                if (map)
+                    ::munmap(map, mapBytes);
+                map = nullptr;
+                file.reset();
+            }
+
+            // Moves the first slot to file offset @p at, which must lie
+            // inside the mapping; the capacity runs to its end.
+            void Rebase(std::size_t at) noexcept
+            {
+                const std::size_t aligned = start - lead;
+                lead                      = at - aligned;
+                capacity                  = aligned + mapBytes - at;
+                start                     = at;
+            }
+        };
+    } // namespace detail
+
+    namespace
+    {
+        [[noreturn]] void ThrowErrno(const char*                  what,
+                                     const std::filesystem::path& path)
+        {
+            throw std::runtime_error(std::string("Skirnir: ") + what +
+                                     " failed for '" + path.string() +
+                                     "': " + std::strerror(errno));
+        }
+
+        // Zero bytes at the end of an existing file are preallocated
+        // space left by a process that did not shut down cleanly.
+        std::size_t TrimTrailingZeros(int fd, std::size_t size)
+        {
+            char buf[4096];
+            std::size_t end = size;
+            while (end > 0)
+            {
+                const std::size_t chunk = std::min(end, sizeof(buf));
+                const ::ssize_t   got   = ::pread(
+                    fd, buf, chunk, static_cast<::off_t>(end - chunk));
+                if (got != static_cast<::ssize_t>(chunk))
+                    return size;
+                std::size_t i = chunk;
+                while (i > 0 && buf[i - 1] == '\0')
+                    --i;
+                end -= chunk - i;
+                if (i > 0)
+                    break;
+            }
+            if (end != size)
+                (void)::ftruncate(fd, static_cast<::off_t>(end));
+            return end;
+        }
+
+        // Preallocates [start, start + capacity) and maps it, starting
+        // the mapping at the page holding @p mapFrom (at most start).
+        std::unique_ptr<detail::MmapSegment> MapSegment(
+            std::shared_ptr<detail::MmapSegment::FileHandle> file,
+            std::size_t mapFrom, std::size_t start, std::size_t capacity,
+            const std::filesystem::path& path)
+        {
+            const std::size_t page    = detail::LogPageSize();
+            const std::size_t aligned = mapFrom / page * page;
+
+            // Reserve the blocks up front so copies into the mapping do
+            // not fault on allocation (or SIGBUS on a full disk).
+            const int err = ::posix_fallocate(
+                file->fd, static_cast<::off_t>(start),
+                static_cast<::off_t>(capacity));
+            if (err != 0)
+            {
+                if (err != EINVAL && err != EOPNOTSUPP)
+                {
+                    errno = err;
+                    ThrowErrno("posix_fallocate", path);
+                }
+                // Filesystems without fallocate: extend sparsely.
+                if (::ftruncate(file->fd,
+                                static_cast<::off_t>(start + capacity)) != 0)
+                    ThrowErrno("ftruncate", path);
+            }
+
+            auto seg      = std::make_unique<detail::MmapSegment>();
+            seg->lead     = start - aligned;
+            seg->start    = start;
+            seg->capacity = capacity;
+            seg->mapBytes = seg->lead + capacity;
+            void* map = ::mmap(nullptr, seg->mapBytes, PROT_READ | PROT_WRITE,
+                               MAP_SHARED, file->fd,
+                               static_cast<::off_t>(aligned));
+            if (map == MAP_FAILED)
+                ThrowErrno("mmap", path);
+            seg->map  = static_cast<char*>(map);
+            seg->file = std::move(file);
+            return seg;
+        }
+
+        std::size_t SegmentCapacity(const MmapFileSinkOptions& o,
+                                    std::size_t start, std::size_t needed)
+        {
+            std::size_t capacity = std::max<std::size_t>(o.segmentBytes, 1);
+            // Don't preallocate far past the rotation point.
+            if (o.maxBytes > 0 && start < o.maxBytes)
+                capacity = std::min(capacity, o.maxBytes - start);
+            return std::max(capacity, needed);
+        }
+
+        // Opens (or creates) @p path and maps a segment after its last
+        // record. With @p fresh, whatever the file held is discarded.
+        std::unique_ptr<detail::MmapSegment> OpenSegment(
+            const std::filesystem::path& path,
+            const MmapFileSinkOptions& options, std::size_t needed,
+            bool fresh = false)
+        {
+            auto opened = detail::OpenSecureLogFd(path);
+            auto file   = std::make_shared<detail::MmapSegment::FileHandle>();
+            file->fd    = opened.fd;
+
+            std::size_t size = 0;
+            if (fresh)
+            {
+                if (::ftruncate(file->fd, 0) != 0)
+                    ThrowErrno("ftruncate", path);
+            }
+            else
+                size = TrimTrailingZeros(file->fd, opened.currentSize);
+            return MapSegment(std::move(file), size, size,
+                              SegmentCapacity(options, size, needed), path);
+        }
+
+        // Whether the switch after @p active rotates, so its spare must
+        // be a new file rather than more of the same one.
+        bool EndsAtRotation(const MmapFileSinkOptions& o,
+                            const detail::MmapSegment& active) noexcept
+        {
+            return o.maxBytes > 0 &&
+                   active.start + active.capacity >= o.maxBytes;
+        }
+
+        bool SameFormat(const TimestampFormat& a,
+                        const TimestampFormat& b) noexcept
+        {
+            return a.style == b.style &&
+                   a.fractionalDigits == b.fractionalDigits;
+        }
+
+        // Same layout as FileSink. The buffer and formatter are per
+        // thread because producers never share a lock.
+        const std::string& FormatLine(const LogRecord&       r,
+                                      const TimestampFormat& format,
+                                      bool                   includeSource)
+        {
+            thread_local std::string        line;
+            thread_local TimestampFormatter timestamps {format};
+            if (!SameFormat(timestamps.Options(), format))
+                timestamps = TimestampFormatter {format};
+
+            line.clear();
+            line.push_back('[');
+            line.append(detail::LevelName(r.level));
+            line.append("] ");
+            line.append(timestamps.Format(r.timestamp));
+            detail::AppendTextRecordTail(line, r, includeSource);
+            return line;
+        }
+    } // namespace
+
+    MmapFileSink::MmapFileSink(std::filesystem::path path,
+                               MmapFileSinkOptions   options) :
+        mPath(std::move(path)), mOptions([&] {
+            MmapFileSinkOptions o = options;
+            if (o.maxBytes > 0 && o.maxFiles == 0)
+                o.maxFiles = 1; // same default as FileSink
+            return o;
+        }())
+    {
+        mNextPath = mPath;
+        mNextPath += ".next";
+
+        mSegments.push_back(OpenSegment(mPath, mOptions, 0));
+        mSegment.store(mSegments.back().get(), std::memory_order_release);
+
+        if (mOptions.maxBytes > 0)
+        {
+            mRotator = std::make_unique<detail::LogRotator>(
+                mPath, mOptions.maxFiles, false);
+        }
+        mWantSpare = true;
+        mWorker = std::jthread([this](std::stop_token st) { Run(st); });
+    }
+
+    MmapFileSink::~MmapFileSink()
+    {
+        mWorker.request_stop();
+        mWorker.join();
+
+        const bool sync = mOptions.durability != MmapDurability::None;
+        for (detail::MmapSegment* seg : mRetired)
+        {
+            if (sync)
+                seg->Sync(0, seg->sealed.load());
+            seg->Unmap();
+        }
+        if (mSpare && mSpare->fresh)
+        {
+            std::error_code ec;
+            std::filesystem::remove(mNextPath, ec);
+        }
+
+        // Drop the preallocated tail so readers see only records.
+        if (auto* seg = mSegment.load())
+        {
+            const std::size_t used = seg->Used();
+            seg->Sync(0, used);
+            (void)::ftruncate(seg->file->fd,
+                              static_cast<::off_t>(seg->start + used));
+        }
+        // mRotator, destroyed after this body, finishes queued shifts.
+    }
+
+    void MmapFileSink::Write(const LogRecord& r)
+    {
+        try
+        {
+            const std::string& line = FormatLine(r, mOptions.timestampFormat,
+                                                  mOptions.includeSource);
+            const std::size_t  len  = line.size();
+
+            for (;;)
+            {
+                detail::MmapSegment* seg =
+                    mSegment.load(std::memory_order_acquire);
+                if (!seg)
+                    return; // the file could not be reopened
+
+                const std::size_t off =
+                    seg->reserved.fetch_add(len, std::memory_order_acq_rel);
+                if (off + len <= seg->capacity)
+                {
+                    std::memcpy(seg->map + seg->lead + off, line.data(), len);
+                    if (mOptions.durability == MmapDurability::SyncOnError &&
+                        r.level >= LogLevel::Error)
+                    {
+                        seg->Sync(off, off + len);
+                        ::fdatasync(seg->file->fd);
+                    }
+                    Commit(seg, len);
+                    return;
+                }
+
+                if (off <= seg->capacity)
+                {
+                    // This reservation crossed the end, so every byte
+                    // below `off` belongs to a record; the next segment
+                    // starts exactly there.
+                    Advance(seg, off, len);
+                }
+                else
+                {
+                    std::unique_lock<std::mutex> lock(mSwitchMutex);
+                    mSwitchCv.wait(lock, [&] { return mSegment.load() != seg; });
+                }
+            }
+        }
+        catch (...)
+        {
+            // Swallow - a logging sink must not throw.
+        }
+    }
+
+    void MmapFileSink::Commit(detail::MmapSegment* seg, std::size_t bytes)
+    {
+        // The copy that completes a sealed segment hands it over.
+        if (seg->committed.fetch_add(bytes) + bytes == seg->sealed.load())
+            Retire(seg);
+    }
+
+    void MmapFileSink::Retire(detail::MmapSegment* seg)
+    {
+        // Both the sealing producer and the last copier may get here.
+        if (seg->retired.exchange(true))
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mSwitchMutex);
+            mRetired.push_back(seg);
+        }
+        mWorkCv.notify_one();
+    }
+
+    void MmapFileSink::Advance(detail::MmapSegment* full, std::size_t used,
+                               std::size_t needed)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mSwitchMutex);
+
+            detail::MmapSegment* next = nullptr;
+            try
+            {
+                mSegments.push_back(
+                    NextSegment(*full, full->start + used, needed));
+                next = mSegments.back().get();
+            }
+            catch (...)
+            {
+                // Stay closed, like FileSink; later writes are no-ops.
+            }
+            mSegment.store(next, std::memory_order_release);
+            mWantSpare = next != nullptr;
+        }
+        mSwitchCv.notify_all();
+        mWorkCv.notify_one();
+
+        // Every copy into `full` lies below `used`; the last one to land
+        // retires it, which may be right now.
+        full->sealed.store(used);
+        if (full->committed.load() == used)
+            Retire(full);
+    }
+
+    MmapFileSink::SegmentHolder MmapFileSink::NextSegment(
+        detail::MmapSegment& full, std::size_t end, std::size_t needed)
+    {
+        SegmentHolder spare  = std::move(mSpare);
+        const bool    rotate = mOptions.maxBytes > 0 && end > 0 &&
+                            end + needed > mOptions.maxBytes;
+        if (rotate)
+        {
+            // Cut the preallocated tail before the file is renamed.
+            // Producers still copying into `full` write below `end`.
+            (void)::ftruncate(full.file->fd, static_cast<::off_t>(end));
+            // One rename here; the rotator shifts older copies later.
+            mRotator->Rotate(nullptr);
+            if (spare && spare->fresh && needed <= spare->capacity)
+            {
+                std::error_code ec;
+                std::filesystem::rename(mNextPath, mPath, ec);
+                if (!ec)
+                    return spare;
+            }
+        }
+        else if (spare && spare->basis == &full &&
+                 end + needed <= spare->start + spare->capacity)
+        {
+            spare->Rebase(end);
+            return spare;
+        }
+
+        if (spare && spare->fresh)
+        {
+            std::error_code ec;
+            std::filesystem::remove(mNextPath, ec);
+        }
+        if (rotate)
+            return OpenSegment(mPath, mOptions, needed);
+        return MapSegment(full.file, end, end,
+                          SegmentCapacity(mOptions, end, needed), mPath);
+    }
+
+    MmapFileSink::SegmentHolder MmapFileSink::PrepareSpare(
+        const detail::MmapSegment& active)
+    {
+        if (EndsAtRotation(mOptions, active))
+        {
+            // Open the next file under a side name; the switch renames
+            // it into place.
+            auto spare   = OpenSegment(mNextPath, mOptions, 0, true);
+            spare->fresh = true;
+            return spare;
+        }
+
+        // The switch happens wherever the last record of `active` ends,
+        // so map from its start and rebase the spare then.
+        const std::size_t end   = active.start + active.capacity;
+        auto              spare = MapSegment(active.file, active.start, end,
+                                             SegmentCapacity(mOptions, end, 0),
+                                             mPath);
+        spare->basis            = &active;
+        return spare;
+    }
+
+    void MmapFileSink::Flush()
+    {
+        // Hold off a switch so the active mapping stays in place.
+        std::lock_guard<std::mutex> lock(mSwitchMutex);
+        if (auto* seg = mSegment.load())
+            seg->Sync(0, seg->Used());
+    }
+
+    void MmapFileSink::Run(std::stop_token st)
+    {
+        const bool periodic =
+            mOptions.durability == MmapDurability::PeriodicSync;
+        const bool syncRetired = mOptions.durability != MmapDurability::None;
+        auto       nextSync = std::chrono::steady_clock::now() +
+                        mOptions.syncInterval;
+
+        std::unique_lock<std::mutex> lock(mSwitchMutex);
+        for (;;)
+        {
+            const auto pending = [&] {
+                return !mRetired.empty() || (mWantSpare && !mSpare);
+            };
+            if (periodic)
+                mWorkCv.wait_until(lock, st, nextSync, pending);
+            else
+                mWorkCv.wait(lock, st, pending);
+            if (st.stop_requested())
+                return; // the destructor takes care of what is left
+
+            std::vector<detail::MmapSegment*> retired;
+            retired.swap(mRetired);
+            const bool prepare = mWantSpare && !mSpare;
+            mWantSpare         = false;
+            // Only this thread and the destructor release mappings, so
+            // the active segment stays mapped while it is used below.
+            detail::MmapSegment* active = mSegment.load();
+            lock.unlock();
+
+            for (detail::MmapSegment* seg : retired)
+            {
+                if (syncRetired)
+                    seg->Sync(0, seg->sealed.load());
+                seg->Unmap();
+            }
+
+            SegmentHolder spare;
+            if (prepare && active)
+            {
+                try
+                {
+                    spare = PrepareSpare(*active);
+                }
+                catch (...)
+                {
+                    // The producer maps the next segment itself.
+                }
+            }
+
+            if (periodic &&
+                std::chrono::steady_clock::now() >= nextSync)
+            {
+                if (active)
+                    active->Sync(0, active->Used());
+                nextSync = std::chrono::steady_clock::now() +
+                           mOptions.syncInterval;
+            }
+
+            lock.lock();
+            // A spare made for a segment that was replaced meanwhile may
+            // no longer fit; that switch has asked for a new one.
+            if (spare)
+            {
+                detail::MmapSegment* current = mSegment.load();
+                if (spare->fresh ? current && EndsAtRotation(mOptions, *current)
+                                 : spare->basis == current)
+                    mSpare = std::move(spare);
+                else if (spare->fresh)
+                {
+                    std::error_code ec;
+                    std::filesystem::remove(mNextPath, ec);
+                }
+            }
+        }
+    }
+#else
+    namespace detail
+    {
+        struct MmapSegment
+        {
+        };
+    } // namespace detail
+
+    MmapFileSink::MmapFileSink(std::filesystem::path path,
+                               MmapFileSinkOptions   options) :
+        mPath(std::move(path)), mOptions(std::move(options))
+    {
+        throw std::runtime_error(
+            "Skirnir: MmapFileSink is not supported on this platform");
+    }
+
+    MmapFileSink::~MmapFileSink() = default;
+
+    void MmapFileSink::Write(const LogRecord&)
+    {
+    }
+
+    void MmapFileSink::Flush()
+    {
+    }
+#endif
+} // namespace SKIRNIR_NAMESPACE
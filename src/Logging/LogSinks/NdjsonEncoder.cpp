@@ -0,0 +1,216 @@
+#include "NdjsonEncoder.hpp"
+#include "../../Common/EscapeScan.hpp"
+#include "Skirnir/Logging/LogRecord.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    namespace
+    {
+        // `{"level":"<name>","timestamp":`, one per level.
+        constexpr std::string_view LevelPrefix(LogLevel lvl)
+        {
+            switch (lvl)
+            {
+                case LogLevel::Debug:
+                    return R"({"level":"Debug","timestamp":)";
+                case LogLevel::Trace:
+                    return R"({"level":"Trace","timestamp":)";
+                case LogLevel::Information:
+                    return R"({"level":"Information","timestamp":)";
+                case LogLevel::Warning:
+                    return R"({"level":"Warning","timestamp":)";
+                case LogLevel::Error:
+                    return R"({"level":"Error","timestamp":)";
+                case LogLevel::Fatal:
+                    return R"({"level":"Fatal","timestamp":)";
+                case LogLevel::None:
+                    return R"({"level":"None","timestamp":)";
+            }
+            return R"({"level":"?","timestamp":)";
+        }
+
+        void AppendEscapedJson(std::string& out, std::string_view s)
+        {
+            AppendEscaped<EscapeSet::Json>(out, s.data(), s.size(),
+                                           AppendJsonEscape);
+        }
+
+        template <typename T>
+        void AppendNumber(std::string& out, T value)
+        {
+            char buffer[32];
+            const auto result =
+                std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, result.ptr);
+        }
+
+        // Writes a LogFieldValue or a LogPropertyValue; they differ only in
+        // whether strings are owned or viewed.
+        template <typename Value>
+        void AppendValue(std::string& out, const Value& value)
+        {
+            std::visit(
+                [&](const auto& v) {
+                    using V = std::decay_t<decltype(v)>;
+                    if constexpr (std::is_same_v<V, std::nullptr_t>)
+                        out.append("null");
+                    else if constexpr (std::is_same_v<V, bool>)
+                        out.append(v ? "true" : "false");
+                    else if constexpr (std::is_same_v<V, double>)
+                    {
+                        // JSON has no NaN or infinity.
+                        if (std::isfinite(v))
+                            AppendNumber(out, v);
+                        else
+                            out.append("null");
+                    }
+                    else if constexpr (std::is_convertible_v<const V&,
+                                                             std::string_view>)
+                    {
+                        out.push_back('"');
+                        AppendEscapedJson(out, v);
+                        out.push_back('"');
+                    }
+                    else
+                        AppendNumber(out, v);
+                },
+                value);
+        }
+
+        void AppendKey(std::string& out, std::string_view key, bool first)
+        {
+            if (!first)
+                out.push_back(',');
+            out.push_back('"');
+            AppendEscapedJson(out, key);
+            out.append("\":");
+        }
+
+        TimestampFormat JsonTimestampFormat(const TimestampFormat& format)
+        {
+            // The space-separated default is not a JSON-friendly date.
+            if (format.style == TimestampStyle::Default)
+                return {TimestampStyle::Iso8601, format.fractionalDigits};
+            return format;
+        }
+    } // namespace
+
+    const std::string& NdjsonEncoder::CategoryText(std::string_view category)
+    {
+        auto key = reinterpret_cast<std::uintptr_t>(category.data());
+        key ^= key >> 6;
+        const auto slot = key % mCategories.size();
+        CategoryEntry& entry = mCategories[slot];
+        if (entry.data == category.data() && entry.category == category)
+            return entry.encoded;
+
+        entry.data = category.data();
+        entry.category.assign(category);
+        entry.encoded.assign(R"(,"category":")");
+        AppendEscapedJson(entry.encoded, category);
+        entry.encoded.append(R"(","message":")");
+        return entry.encoded;
+    }
+
+    void NdjsonEncoder::Append(std::string& out, const LogRecord& r,
+                               const TimestampFormat& format,
+                               bool                   includeSource)
+    {
+        const TimestampFormat wanted  = JsonTimestampFormat(format);
+        const TimestampFormat& cached = mTimestamps.Options();
+        if (cached.style != wanted.style ||
+            cached.fractionalDigits != wanted.fractionalDigits)
+            mTimestamps = TimestampFormatter(wanted);
+
+        out.append(LevelPrefix(r.level));
+        const std::string_view ts = mTimestamps.Format(r.timestamp);
+        if (wanted.style == TimestampStyle::Epoch)
+        {
+            out.append(ts);
+        }
+        else
+        {
+            out.push_back('"');
+            out.append(ts);
+            out.push_back('"');
+        }
+
+        out.append(CategoryText(r.category));
+        AppendEscapedJson(out, r.message.View());
+
+        out.append(R"(","scopes":[)");
+        bool first = true;
+        r.scopes.ForEach([&](const std::string& scope) {
+            if (!first)
+                out.push_back(',');
+            first = false;
+            out.push_back('"');
+            AppendEscapedJson(out, scope);
+            out.push_back('"');
+        });
+        out.push_back(']');
+
+        if (includeSource && r.location.line() != 0)
+        {
+            out.append(R"(,"source":{"file":")");
+            AppendEscapedJson(out, r.location.file_name());
+            out.append(R"(","line":)");
+            AppendNumber(out, r.location.line());
+            out.append(R"(,"function":")");
+            AppendEscapedJson(out, r.location.function_name());
+            out.append("\"}");
+        }
+
+        // Template properties first, then explicitly attached fields.
+        // Each key is written once, by the first property or field that
+        // uses it, so the object never repeats a name.
+        if (!r.properties.empty() || !r.fields.empty())
+        {
+            const std::size_t propertyCount = r.properties.size();
+            auto propertyBefore = [&](std::string_view key, std::size_t end) {
+                for (std::size_t i = 0; i < end; ++i)
+                {
+                    if (r.properties[i].name == key)
+                        return true;
+                }
+                return false;
+            };
+
+            out.append(R"(,"fields":{)");
+            bool firstField = true;
+            for (std::size_t i = 0; i < propertyCount; ++i)
+            {
+                const LogProperty p = r.properties[i];
+                if (propertyBefore(p.name, i))
+                    continue;
+                AppendKey(out, p.name, firstField);
+                AppendValue(out, p.value);
+                firstField = false;
+            }
+            for (std::size_t i = 0; i < r.fields.size(); ++i)
+            {
+                const LogField& f = r.fields[i];
+                if (propertyBefore(f.key, propertyCount) ||
+                    std::any_of(r.fields.begin(), r.fields.begin() + i,
+                                [&](const LogField& earlier) {
+                                    return earlier.key == f.key;
+                                }))
+                    continue;
+                AppendKey(out, f.key, firstField);
+                AppendValue(out, f.value);
+                firstField = false;
+            }
+            out.push_back('}');
+        }
+        out.append("}\n");
+    }
+} // namespace SKIRNIR_NAMESPACE::detail
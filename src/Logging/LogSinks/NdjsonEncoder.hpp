@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Skirnir/Logging/TimestampFormat.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace SKIRNIR_NAMESPACE
+{
+    struct LogRecord;
+}
+
+namespace SKIRNIR_NAMESPACE::detail
+{
+    /**
+     * @brief Writes records as NDJSON lines without building a DOM.
+     *
+     *  Every line has the same field order:
+     *  @c {"level":..,"timestamp":..,"category":..,"message":..,
+     *  "scopes":[..]}, followed by @c "source":{..} when requested and
+     *  @c "fields":{..} when the record carries template properties or
+     *  structured fields. A key used more than once is written by the
+     *  first property, or failing that the first field, that uses it.
+     *  The escaped text around the category is cached per category, so
+     *  a logger's prefix is escaped once.
+     *
+     *  Not thread-safe; @c JsonSink keeps one per thread.
+     */
+    class NdjsonEncoder
+    {
+      public:
+        /**
+         * @brief Appends the line for @p r, newline included, to @p out.
+         *
+         *  Timestamps are ISO 8601 strings, or a number of seconds when
+         *  @p format uses @c TimestampStyle::Epoch. @p includeSource adds
+         *  the call site for records that have one.
+         */
+        void Append(std::string& out, const LogRecord& r,
+                    const TimestampFormat& format,
+                    bool                   includeSource = false);
+
+      private:
+        struct CategoryEntry
+        {
+            const char* data = nullptr;
+            std::string category; // copy, compared on every hit
+            // `","category":"<escaped>","message":"`
+            std::string encoded;
+        };
+
+        const std::string& CategoryText(std::string_view category);
+
+        // Direct-mapped on the address of the category text, which for
+        // Logger<T> records is the same static string on every call.
+        std::array<CategoryEntry, 64> mCategories {};
+        TimestampFormatter            mTimestamps;
+    };
+} // namespace SKIRNIR_NAMESPACE::detail
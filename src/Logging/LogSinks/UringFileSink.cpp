@@ -0,0 +1,520 @@
+#include "Detail.hpp"
+#include "IoUring.hpp"
+#include "LogRotator.hpp"
+#include "Skirnir/Logging/LogRecord.hpp"
+#include "Skirnir/Logging/LogSinks/UringFileSink.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#ifndef _WIN32
+#  include <cerrno>
+#  include <climits>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+namespace SKIRNIR_NAMESPACE
+{
+#ifndef _WIN32
+    namespace
+    {
+        // Completes a write the fast path left short; errors are dropped
+        // like every other sink I/O error.
+        void WriteAllAt(int fd, const char* data, std::size_t size,
+                        std::size_t offset) noexcept
+        {
+            while (size > 0)
+            {
+                const ::ssize_t n = ::pwrite(fd, data, size,
+                                             static_cast<::off_t>(offset));
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return;
+                }
+                data += n;
+                size -= static_cast<std::size_t>(n);
+                offset += static_cast<std::size_t>(n);
+            }
+        }
+
+#  ifdef IOV_MAX
+        constexpr std::size_t kMaxIov = IOV_MAX;
+#  else
+        constexpr std::size_t kMaxIov = 1024;
+#  endif
+
+#  ifdef SKIRNIR_HAS_IO_URING
+        constexpr std::uint64_t kSyncTag = ~std::uint64_t {0};
+#  endif
+    } // namespace
+
+    UringFileSink::UringFileSink(std::filesystem::path path,
+                                 FileSinkOptions       options,
+                                 UringFileSinkOptions  io) :
+        mPath(std::move(path)),
+        mOptions([&] {
+            FileSinkOptions o = options;
+            if ((o.maxBytes > 0 || o.rotateEvery != RotationInterval::Never) &&
+                o.maxFiles == 0)
+                o.maxFiles = 1; // same default as FileSink
+            return o;
+        }()),
+        mIo([&] {
+            UringFileSinkOptions o = io;
+            o.bufferBytes          = std::max<std::size_t>(o.bufferBytes, 256);
+            o.bufferCount          = std::max<std::size_t>(o.bufferCount, 2);
+            // A flush policy's interval bounds how long a partly filled
+            // buffer is held back.
+            if (options.flushPolicy &&
+                options.flushPolicy->interval.count() > 0)
+                o.flushInterval = std::min(o.flushInterval,
+                                           options.flushPolicy->interval);
+            return o;
+        }()),
+        mTimestamps(mOptions.timestampFormat)
+    {
+        if (mOptions.rotateOnOpen && mOptions.maxBytes > 0)
+        {
+            std::error_code ec;
+            std::filesystem::remove(mPath, ec);
+        }
+
+        // Before the file is opened: without zlib, compressRotated
+        // throws here.
+        if (mOptions.maxBytes > 0 ||
+            mOptions.rotateEvery != RotationInterval::Never)
+        {
+            mRotator = std::make_unique<detail::LogRotator>(
+                mPath, mOptions.maxFiles, mOptions.compressRotated);
+        }
+
+        auto opened  = detail::OpenSecureLogFd(mPath);
+        mFd          = opened.fd;
+        mFileOffset  = opened.currentSize;
+        mCurrentSize = opened.currentSize;
+        if (mRotator)
+        {
+            mRotateAt = detail::FirstRotationTime(mOptions.rotateEvery, mPath,
+                                                  mCurrentSize);
+        }
+
+        mStorage.reset(new char[mIo.bufferBytes * mIo.bufferCount]);
+        mBuffers.resize(mIo.bufferCount);
+        mFree.reserve(mIo.bufferCount);
+        for (std::size_t i = mIo.bufferCount; i-- > 0;)
+        {
+            mBuffers[i].data = mStorage.get() + i * mIo.bufferBytes;
+            mFree.push_back(i);
+        }
+
+#  ifdef SKIRNIR_HAS_IO_URING
+        if (mIo.useIoUring)
+        {
+            mRing = detail::IoUring::TryCreate(
+                static_cast<unsigned>(mIo.bufferCount + 1));
+            if (mRing)
+            {
+                std::vector<iovec> iov(mBuffers.size());
+                for (std::size_t i = 0; i < mBuffers.size(); ++i)
+                    iov[i] = {mBuffers[i].data, mIo.bufferBytes};
+                // Without registration (e.g. RLIMIT_MEMLOCK) the ring
+                // still works, using plain IORING_OP_WRITE.
+                mFixedBuffers = mRing->RegisterBuffers(iov);
+                mUsesIoUring.store(true, std::memory_order_release);
+            }
+        }
+#  endif
+
+        mLastSync = std::chrono::steady_clock::now();
+        mWriter   = std::jthread([this](std::stop_token st) { WriterLoop(st); });
+    }
+
+    UringFileSink::~UringFileSink()
+    {
+        mWriter.request_stop();
+        if (mWriter.joinable())
+            mWriter.join();
+
+        if (mFd >= 0)
+        {
+            if (mIo.syncInterval.count() > 0)
+                ::fdatasync(mFd);
+            ::close(mFd);
+        }
+        // Finishes any rotation still in progress.
+        mRotator.reset();
+    }
+
+    void UringFileSink::Write(const LogRecord& r)
+    {
+        // As in FileSink, everything after the timestamp is built
+        // outside the lock.
+        std::string tail;
+        detail::AppendTextRecordTail(tail, r, mOptions.includeSource);
+
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        std::string line;
+        line.reserve(48 + tail.size());
+        line.push_back('[');
+        line.append(detail::LevelName(r.level));
+        line.append("] ");
+        line.append(mTimestamps.Format(r.timestamp));
+        line.append(tail);
+
+        bool rotate = false;
+        if (r.timestamp >= mRotateAt)
+        {
+            // A period with no records leaves nothing to rotate.
+            rotate    = mCurrentSize > 0;
+            mRotateAt = detail::NextRotationTime(mOptions.rotateEvery,
+                                                 r.timestamp);
+        }
+        else if (mOptions.maxBytes > 0 &&
+                 mCurrentSize + line.size() > mOptions.maxBytes)
+        {
+            rotate = true;
+        }
+        if (rotate)
+        {
+            SealLocked();
+            mReady.push_back({Job::Kind::Rotate, kNoBuffer, {}});
+            mCurrentSize = 0;
+            mWorkCv.notify_one();
+        }
+
+        AppendLocked(lock, line);
+        mCurrentSize += line.size();
+
+        // With a flush policy, a due flush hands the buffer to the
+        // writer thread now instead of when it fills up.
+        if (mOptions.flushPolicy && mFilling != kNoBuffer &&
+            detail::FlushDue(*mOptions.flushPolicy, r.level,
+                             mBuffers[mFilling].size))
+            SealLocked();
+    }
+
+    void UringFileSink::AppendLocked(std::unique_lock<std::mutex>& lock,
+                                     const std::string&            line)
+    {
+        if (line.size() > mIo.bufferBytes)
+        {
+            SealLocked();
+            mReady.push_back({Job::Kind::Large, kNoBuffer, line});
+            ++mSealed;
+            mWorkCv.notify_one();
+            return;
+        }
+
+        // Waiting happens before any byte is copied, so a line is never
+        // split across buffers and producers cannot interleave.
+        for (;;)
+        {
+            if (mFilling != kNoBuffer)
+            {
+                Buffer& buf = mBuffers[mFilling];
+                if (mIo.bufferBytes - buf.size >= line.size())
+                {
+                    std::memcpy(buf.data + buf.size, line.data(), line.size());
+                    buf.size += line.size();
+                    return;
+                }
+                SealLocked();
+            }
+            if (mFree.empty())
+            {
+                mFreeCv.wait(lock, [&] {
+                    return !mFree.empty() || mFilling != kNoBuffer;
+                });
+                continue;
+            }
+            mFilling = mFree.back();
+            mFree.pop_back();
+        }
+    }
+
+    void UringFileSink::SealLocked()
+    {
+        if (mFilling == kNoBuffer || mBuffers[mFilling].size == 0)
+            return;
+        mReady.push_back({Job::Kind::Buffer, mFilling, {}});
+        mFilling = kNoBuffer;
+        ++mSealed;
+        mWorkCv.notify_one();
+    }
+
+    void UringFileSink::Flush()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        SealLocked();
+        const std::uint64_t target = mSealed;
+        mDoneCv.wait(lock, [&] { return mWritten >= target; });
+    }
+
+    void UringFileSink::WriterLoop(std::stop_token st)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        for (;;)
+        {
+            mWorkCv.wait_for(lock, st, mIo.flushInterval,
+                             [&] { return !mReady.empty(); });
+            if (mReady.empty())
+                SealLocked(); // interval elapsed with a partial buffer
+            if (mReady.empty())
+            {
+                if (st.stop_requested())
+                    return;
+                continue;
+            }
+
+            std::vector<Job> jobs(std::make_move_iterator(mReady.begin()),
+                                  std::make_move_iterator(mReady.end()));
+            mReady.clear();
+
+            lock.unlock();
+            WriteJobs(jobs);
+            lock.lock();
+
+            for (const Job& job : jobs)
+            {
+                if (job.kind == Job::Kind::Buffer)
+                {
+                    mBuffers[job.buffer].size = 0;
+                    mFree.push_back(job.buffer);
+                }
+                if (job.kind != Job::Kind::Rotate)
+                    ++mWritten;
+            }
+            mFreeCv.notify_all();
+            mDoneCv.notify_all();
+        }
+    }
+
+    void UringFileSink::WriteJobs(std::span<const Job> jobs)
+    {
+        std::vector<Chunk> chunks;
+        chunks.reserve(jobs.size());
+        for (const Job& job : jobs)
+        {
+            switch (job.kind)
+            {
+                case Job::Kind::Buffer:
+                {
+                    const Buffer& buf = mBuffers[job.buffer];
+                    chunks.push_back({buf.data, buf.size, job.buffer});
+                    break;
+                }
+                case Job::Kind::Large:
+                    chunks.push_back(
+                        {job.text.data(), job.text.size(), kNoBuffer});
+                    break;
+                case Job::Kind::Rotate:
+                    WriteChunks(chunks);
+                    chunks.clear();
+                    RotateFile();
+                    break;
+            }
+        }
+        WriteChunks(chunks);
+    }
+
+    void UringFileSink::WriteChunks(std::span<const Chunk> chunks)
+    {
+        if (chunks.empty() || mFd < 0)
+            return;
+
+        const auto now  = std::chrono::steady_clock::now();
+        const bool sync =
+            (mOptions.flushPolicy && mOptions.flushPolicy->sync) ||
+            (mIo.syncInterval.count() > 0 &&
+             now - mLastSync >= mIo.syncInterval);
+        if (sync)
+            mLastSync = now;
+
+        std::vector<std::size_t> offsets(chunks.size());
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            offsets[i] = mFileOffset;
+            mFileOffset += chunks[i].size;
+        }
+
+#  ifdef SKIRNIR_HAS_IO_URING
+        if (mRing)
+        {
+            // Groups leave one slot for the fsync; only the last group
+            // carries it, linked behind its writes. Earlier groups have
+            // completed by then, so it covers the whole batch.
+            const std::size_t group = mRing->Capacity() - 1;
+            std::vector<int>  results(chunks.size(), 0);
+            int               syncResult = sync ? -ECANCELED : 0;
+
+            for (std::size_t first = 0; first < chunks.size(); first += group)
+            {
+                const std::size_t last = std::min(first + group, chunks.size());
+                const bool syncHere    = sync && last == chunks.size();
+
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    io_uring_sqe* sqe = mRing->NextSqe();
+                    const bool fixed =
+                        mFixedBuffers && chunks[i].buffer != kNoBuffer;
+                    sqe->opcode = fixed ? IORING_OP_WRITE_FIXED
+                                        : IORING_OP_WRITE;
+                    sqe->fd   = mFd;
+                    sqe->addr = reinterpret_cast<std::uint64_t>(chunks[i].data);
+                    sqe->len  = static_cast<std::uint32_t>(chunks[i].size);
+                    sqe->off  = offsets[i];
+                    if (fixed)
+                        sqe->buf_index =
+                            static_cast<std::uint16_t>(chunks[i].buffer);
+                    sqe->user_data = i;
+                    if (syncHere)
+                        sqe->flags |= IOSQE_IO_LINK;
+                }
+                if (syncHere)
+                {
+                    io_uring_sqe* sqe = mRing->NextSqe();
+                    sqe->opcode      = IORING_OP_FSYNC;
+                    sqe->fd          = mFd;
+                    sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+                    sqe->user_data   = kSyncTag;
+                }
+
+                const unsigned expected =
+                    static_cast<unsigned>(last - first) + (syncHere ? 1 : 0);
+                unsigned seen = 0;
+                int      rc   = mRing->SubmitAndWait(expected);
+                while (rc == 0)
+                {
+                    seen += mRing->DrainCompletions(
+                        [&](std::uint64_t tag, int res) {
+                            if (tag == kSyncTag)
+                                syncResult = res;
+                            else
+                                results[tag] = res;
+                        });
+                    if (seen >= expected)
+                        break;
+                    rc = mRing->SubmitAndWait(expected - seen);
+                }
+                if (rc != 0)
+                {
+                    // The ring is unusable; finish on the pwrite path.
+                    mUsesIoUring.store(false, std::memory_order_release);
+                    mRing.reset();
+                    break;
+                }
+            }
+
+            // Short, failed or cancelled (broken link) writes are
+            // completed synchronously.
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                const std::size_t done =
+                    results[i] > 0 ? static_cast<std::size_t>(results[i]) : 0;
+                if (done < chunks[i].size)
+                {
+                    WriteAllAt(mFd, chunks[i].data + done,
+                               chunks[i].size - done, offsets[i] + done);
+                }
+            }
+            if (sync && syncResult < 0)
+                ::fdatasync(mFd);
+            return;
+        }
+#  endif
+
+        // Batch fallback: one pwritev per IOV_MAX chunks.
+        std::vector<iovec> iov;
+        for (std::size_t first = 0; first < chunks.size(); first += kMaxIov)
+        {
+            const std::size_t last = std::min(first + kMaxIov, chunks.size());
+            iov.clear();
+            std::size_t total = 0;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                iov.push_back({const_cast<char*>(chunks[i].data),
+                               chunks[i].size});
+                total += chunks[i].size;
+            }
+
+            ::ssize_t n;
+            do
+            {
+                n = ::pwritev(mFd, iov.data(), static_cast<int>(iov.size()),
+                              static_cast<::off_t>(offsets[first]));
+            } while (n < 0 && errno == EINTR);
+
+            std::size_t written = n > 0 ? static_cast<std::size_t>(n) : 0;
+            if (written < total)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    const std::size_t done = std::min(written, chunks[i].size);
+                    written -= done;
+                    if (done < chunks[i].size)
+                    {
+                        WriteAllAt(mFd, chunks[i].data + done,
+                                   chunks[i].size - done, offsets[i] + done);
+                    }
+                }
+            }
+        }
+        if (sync)
+            ::fdatasync(mFd);
+    }
+
+    void UringFileSink::RotateFile()
+    {
+        if (mFd >= 0)
+        {
+            if (mIo.syncInterval.count() > 0)
+                ::fdatasync(mFd);
+            ::close(mFd);
+            mFd = -1;
+        }
+        // One rename here; shifting older copies and compression run on
+        // the rotator's thread.
+        mRotator->Rotate(nullptr);
+        try
+        {
+            auto reopened = detail::OpenSecureLogFd(mPath);
+            mFd           = reopened.fd;
+            mFileOffset   = reopened.currentSize;
+        }
+        catch (...)
+        {
+            // Stay closed; staged records are dropped until the sink is
+            // replaced, as with FileSink.
+        }
+    }
+#else
+    UringFileSink::UringFileSink(std::filesystem::path path,
+                                 FileSinkOptions       options,
+                                 UringFileSinkOptions  io) :
+        mPath(std::move(path)), mOptions(std::move(options)),
+        mIo(std::move(io)), mTimestamps(mOptions.timestampFormat)
+    {
+        throw std::runtime_error(
+            "Skirnir: UringFileSink is not supported on this platform");
+    }
+
+    UringFileSink::~UringFileSink() = default;
+
+    void UringFileSink::Write(const LogRecord&)
+    {
+    }
+
+    void UringFileSink::Flush()
+    {
+    }
+#endif
+} // namespace SKIRNIR_NAMESPACE
@@ -4,13 +4,24 @@
 #include "Skirnir/Logging/LogSinks.hpp"
 #include "Skirnir/Logging/Logger.hpp"
 
+#include "LogRateLimiter.hpp"
+#include "LogSinks/Detail.hpp"
+
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -18,10 +29,13 @@ namespace SKIRNIR_NAMESPACE
 {
     namespace
     {
-        std::vector<std::string>& ScopeStack()
+        // Innermost scope of the calling thread. Each node links to its
+        // outer scope, so the whole stack is shared by records with a
+        // single reference-count increment.
+        Arc<const LogScopeNode>& ScopeTail()
         {
-            thread_local std::vector<std::string> stack;
-            return stack;
+            thread_local Arc<const LogScopeNode> tail;
+            return tail;
         }
     } // namespace
 
@@ -46,83 +60,299 @@ namespace SKIRNIR_NAMESPACE
         return LogLevel::Information;
     }
 
+    std::string LoggerOptions::ConfigurationSection(std::string_view path)
+    {
+        for (int segments = 0; segments < 2; ++segments)
+        {
+            const auto dot = path.rfind('.');
+            if (dot == std::string_view::npos)
+                return {};
+            path = path.substr(0, dot);
+        }
+        return std::string(path);
+    }
+
     void LoggerOptions::ConfigureFrom(Arc<ConfigurationOptions> config,
                                       std::string_view          path)
     {
         if (!config)
             return;
 
-        // Default log level
-        if (auto level = config->GetString(path); !level.empty())
+        // Async-sink and rate-limit options live next to the levels
+        // section: the default path is "logging.logLevel.default", so
+        // they are read from "logging.async.*" and "logging.rateLimit.*".
         {
-            logLevel = ParseLogLevel(level);
-        }
+            std::string root = ConfigurationSection(path);
+            if (!root.empty())
+                root += '.';
 
-        // Async-sink options live under "logging.async.*" — the default
-        // path is "logging.logLevel.default" so the parent is "logging".
-        // We tolerate arbitrary paths by deriving the parent of @p path.
-        {
-            std::string_view parent = path;
-            const auto       dot    = parent.rfind('.');
-            if (dot != std::string_view::npos)
-                parent = parent.substr(0, dot);
+            asyncEnabled =
+                config->GetBool(root + "async.enabled", asyncEnabled);
 
-            const std::string asyncEnabledKey =
-                std::string(parent) + ".async.enabled";
-            const std::string asyncCapacityKey =
-                std::string(parent) + ".async.queueCapacity";
+            const auto capacity =
+                config->GetInt(root + "async.queueCapacity",
+                               static_cast<int64_t>(asyncQueueCapacity));
+            if (capacity > 0)
+                asyncQueueCapacity = static_cast<std::size_t>(capacity);
 
-            if (config->HasKey(asyncEnabledKey))
-            {
-                asyncEnabled = config->GetBool(asyncEnabledKey, asyncEnabled);
-            }
-            if (config->HasKey(asyncCapacityKey))
+            // An absent section keeps the limit that is already set.
+            const std::string rl   = root + "rateLimit";
+            const std::string mode = config->GetString(rl + ".mode");
+            if (!mode.empty())
             {
-                const auto v = config->GetInt(asyncCapacityKey,
-                                              static_cast<int64_t>(
-                                                  asyncQueueCapacity));
-                if (v > 0)
+                LogRateLimit limit = RateLimit();
+                if (mode == "tokenBucket" || mode == "TokenBucket")
+                    limit.mode = LogRateLimitMode::TokenBucket;
+                else if (mode == "sample" || mode == "Sample")
+                    limit.mode = LogRateLimitMode::Sample;
+                else
+                    limit.mode = LogRateLimitMode::Off;
+
+                const auto burst = config->GetInt(rl + ".burst", limit.burst);
+                if (burst > 0)
+                    limit.burst = static_cast<std::uint32_t>(burst);
+                const double perSecond =
+                    config->GetDouble(rl + ".perSecond", limit.perSecond);
+                if (perSecond > 0)
+                    limit.perSecond = perSecond;
+                const auto every =
+                    config->GetInt(rl + ".sampleEvery", limit.sampleEvery);
+                if (every > 0)
+                    limit.sampleEvery = static_cast<std::uint32_t>(every);
+                if (const std::string maxLevel =
+                        config->GetString(rl + ".maxLevel");
+                    !maxLevel.empty())
+                {
+                    limit.maxLevel = ParseLogLevel(maxLevel);
+                }
+                const auto summaryMs = config->GetInt(
+                    rl + ".summaryIntervalMs", limit.summaryInterval.count());
+                if (summaryMs >= 0)
                 {
-                    asyncQueueCapacity = static_cast<std::size_t>(v);
+                    limit.summaryInterval =
+                        std::chrono::milliseconds(summaryMs);
                 }
+
+                SetRateLimit(limit);
             }
         }
 
+        const std::string defaultLevel = config->GetString(path);
+
         // Namespace-specific levels live in the same object that holds the
         // default key, so locate the parent section and iterate its members.
-        auto dot = path.rfind('.');
-        if (dot == std::string_view::npos)
-            return;
+        // They are collected without holding mLogLevelsMutex (ForEachMember
+        // reads from the configuration, not the map) and published below
+        // in one shot.
+        std::map<std::string, LogLevel, std::less<>> overrides;
+        if (const auto dot = path.rfind('.'); dot != std::string_view::npos)
+        {
+            const std::string_view sectionPath = path.substr(0, dot);
+            const std::string_view defaultKey  = path.substr(dot + 1);
 
-        std::string_view sectionPath = path.substr(0, dot);
-        std::string_view defaultKey  = path.substr(dot + 1);
-
-        // Collect the entries first while holding only a shared lock on the
-        // map (ForEachMember reads from the configuration, not the map), and
-        // then publish them under an exclusive lock in one shot. This keeps
-        // the writer out of any hot read path on GetLogLevelFor<T>.
-        std::vector<std::pair<std::string, LogLevel>> additions;
-        config->ForEachMember(
-            sectionPath,
-            [&](std::string_view key, simdjson::dom::element value) {
-                if (key == defaultKey)
-                    return;
-                if (!value.is_string())
-                    return;
-                std::string_view sv;
-                if (value.get_string().get(sv) != simdjson::SUCCESS)
-                    return;
-                additions.emplace_back(std::string(key), ParseLogLevel(sv));
-            });
+            config->ForEachMember(
+                sectionPath,
+                [&](std::string_view key, simdjson::dom::element value) {
+                    if (key == defaultKey)
+                        return;
+                    std::string_view sv;
+                    if (value.get_string().get(sv) != simdjson::SUCCESS)
+                        return;
+                    overrides[std::string(key)] = ParseLogLevel(sv);
+                });
+        }
+
+        // The configuration is the full picture: overrides that are no
+        // longer present are dropped, and every live logger is updated.
+        std::unique_lock<std::shared_mutex> lock(mLogLevelsMutex);
+        if (!defaultLevel.empty())
+            logLevel = ParseLogLevel(defaultLevel);
+        mLogLevels = std::move(overrides);
+        RefreshLevelSlots();
+    }
+
+    void LoggerOptions::SetLogLevel(LogLevel level)
+    {
+        std::unique_lock<std::shared_mutex> lock(mLogLevelsMutex);
+        logLevel = level;
+        RefreshLevelSlots();
+    }
+
+    void LoggerOptions::SetLogLevel(std::string_view category, LogLevel level)
+    {
+        std::unique_lock<std::shared_mutex> lock(mLogLevelsMutex);
+        mLogLevels.insert_or_assign(std::string(category), level);
+        RefreshLevelSlots();
+    }
 
-        if (!additions.empty())
+    const std::atomic<LogLevel>&
+        LoggerOptions::AcquireLevelSlot(std::string_view typeName,
+                                        std::string_view typeNs)
+    {
         {
-            std::unique_lock<std::shared_mutex> lock(mLogLevelsMutex);
-            for (auto& [key, level] : additions)
+            std::shared_lock<std::shared_mutex> lock(mLogLevelsMutex);
+            if (mResolvedDefault == logLevel)
             {
-                mLogLevels[std::move(key)] = level;
+                if (auto it = mLevelSlots.find(typeName);
+                    it != mLevelSlots.end())
+                {
+                    return it->second.level;
+                }
             }
         }
+
+        std::unique_lock<std::shared_mutex> lock(mLogLevelsMutex);
+        // @c logLevel is a plain field that callers may assign directly
+        // before creating loggers; pick such changes up here.
+        if (mResolvedDefault != logLevel)
+            RefreshLevelSlots();
+
+        auto it = mLevelSlots.find(typeName);
+        if (it == mLevelSlots.end())
+        {
+            it = mLevelSlots
+                     .try_emplace(std::string(typeName), std::string(typeNs),
+                                  ResolveLogLevel(typeName, typeNs))
+                     .first;
+        }
+        return it->second.level;
+    }
+
+    LogLevel LoggerOptions::ResolveLogLevel(std::string_view typeName,
+                                            std::string_view typeNs) const
+    {
+        // Called with mLogLevelsMutex held.
+        if (auto it = mLogLevels.find(typeName); it != mLogLevels.end())
+            return it->second;
+        if (auto it = mLogLevels.find(typeNs); it != mLogLevels.end())
+            return it->second;
+
+        // Enclosing namespaces, innermost first: "my_app::services::db"
+        // matches a "my_app::services" (or dotted "my_app.services")
+        // override.
+        std::size_t bestLength = 0;
+        LogLevel    best       = logLevel;
+        for (const auto& [key, level] : mLogLevels)
+        {
+            if (key.size() <= bestLength || typeNs.size() <= key.size() ||
+                !typeNs.starts_with(key))
+            {
+                continue;
+            }
+            const std::string_view rest = typeNs.substr(key.size());
+            if (rest.starts_with("::") || rest.starts_with('.'))
+            {
+                bestLength = key.size();
+                best       = level;
+            }
+        }
+        return best;
+    }
+
+    void LoggerOptions::RefreshLevelSlots()
+    {
+        // Called with mLogLevelsMutex held exclusively.
+        mResolvedDefault = logLevel;
+        for (auto& [typeName, slot] : mLevelSlots)
+        {
+            slot.level.store(ResolveLogLevel(typeName, slot.typeNamespace),
+                             std::memory_order_relaxed);
+        }
+    }
+
+    LoggerOptions::~LoggerOptions()
+    {
+        // Report what the last window suppressed while the sinks are
+        // still here.
+        if (mSummaryTimer.joinable())
+        {
+            mSummaryTimer.request_stop();
+            mSummaryTimer.join();
+            DispatchRateLimitSummary();
+        }
+    }
+
+    void LoggerOptions::SetRateLimit(const LogRateLimit& limit)
+    {
+        std::lock_guard<std::mutex> lock(mRateLimitMutex);
+        // The limiter is never replaced once created, so loggers may
+        // use it without holding the mutex.
+        if (!mRateLimiter)
+            mRateLimiter = std::make_shared<detail::LogRateLimiter>();
+
+        // The timer runs exactly while summaries are on. Stop it and
+        // report the counts it has not reported yet, so a new policy
+        // starts a fresh window.
+        if (mSummaryTimer.joinable())
+        {
+            mSummaryTimer = {};
+            DispatchRateLimitSummary();
+        }
+
+        mRateLimiter->SetPolicy(limit);
+        mRateLimitEnabled.store(limit.mode != LogRateLimitMode::Off,
+                                std::memory_order_release);
+
+        if (limit.mode != LogRateLimitMode::Off &&
+            limit.summaryInterval.count() > 0)
+        {
+            const auto interval = limit.summaryInterval;
+            mSummaryTimer = std::jthread([this, interval](std::stop_token st) {
+                detail::RunEvery(st, interval,
+                                 [this] { DispatchRateLimitSummary(); });
+            });
+        }
+    }
+
+    LogRateLimit LoggerOptions::RateLimit() const
+    {
+        std::lock_guard<std::mutex> lock(mRateLimitMutex);
+        return mRateLimiter ? mRateLimiter->Policy() : LogRateLimit {};
+    }
+
+    bool LoggerOptions::AdmitCallSite(LogLevel                    lvl,
+                                      const std::source_location& site)
+    {
+        const std::int64_t now =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        return mRateLimiter->Admit(lvl, site, now);
+    }
+
+    void LoggerOptions::DispatchRateLimitSummary()
+    {
+        // Runs on the summary timer, or with the timer stopped; the
+        // limiter outlives both.
+        auto sites = mRateLimiter->TakeSuppressed();
+        if (sites.empty())
+            return;
+        std::sort(sites.begin(), sites.end(),
+                  [](const auto& a, const auto& b) {
+                      return a.count > b.count;
+                  });
+
+        std::uint64_t total = 0;
+        for (const auto& s : sites)
+            total += s.count;
+
+        LogRecord record;
+        record.level     = LogLevel::Warning;
+        record.timestamp = std::chrono::system_clock::now();
+        record.category  = refl::type_name<LogRateLimit>();
+        std::string text = detail::Format(
+            "suppressed {} records from {} call site(s):", total, sites.size());
+        constexpr std::size_t MaxListed = 5;
+        for (std::size_t i = 0; i < sites.size() && i < MaxListed; ++i)
+        {
+            text += detail::Format(" {}:{} ({})", sites[i].file, sites[i].line,
+                                   sites[i].count);
+        }
+        if (sites.size() > MaxListed)
+            text += " ...";
+        record.message = text;
+        record.fields.emplace_back("suppressed", total);
+        Dispatch(record);
     }
 
     void LoggerOptions::PublishSinks()
@@ -213,20 +443,20 @@ namespace SKIRNIR_NAMESPACE
 
     void LoggerOptions::PushScope(std::string name)
     {
-        ScopeStack().push_back(std::move(name));
+        auto& tail = ScopeTail();
+        tail       = MakeArc<LogScopeNode>(std::move(name), tail);
     }
 
     void LoggerOptions::PopScope()
     {
-        auto& stack = ScopeStack();
-        if (!stack.empty())
-            stack.pop_back();
+        auto& tail = ScopeTail();
+        if (tail)
+            tail = tail->parent;
     }
 
-    std::vector<std::string> LoggerOptions::CurrentScopes() const
+    LogScopeChain LoggerOptions::CurrentScopes() const noexcept
     {
-        const auto& stack = ScopeStack();
-        return {stack.begin(), stack.end()};
+        return LogScopeChain(ScopeTail());
     }
 
     Arc<LogScope> LoggerOptions::BeginScope(std::string name)
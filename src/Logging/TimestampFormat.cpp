@@ -0,0 +1,180 @@
+#include "Skirnir/Logging/TimestampFormat.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ratio>
+#include <string_view>
+
+namespace SKIRNIR_NAMESPACE
+{
+    namespace
+    {
+        using Clock = std::chrono::system_clock;
+
+        // Digits std::format prints for the clock's fractional seconds:
+        // 9 for nanosecond clocks, 7 for 100 ns ticks, and so on.
+        constexpr int NativeDigits()
+        {
+            std::intmax_t den    = Clock::period::den;
+            int           digits = 0;
+            while (den > 1)
+            {
+                den /= 10;
+                ++digits;
+            }
+            return digits;
+        }
+
+        constexpr std::int64_t Pow10(int exponent)
+        {
+            std::int64_t value = 1;
+            while (exponent-- > 0)
+                value *= 10;
+            return value;
+        }
+
+        constexpr std::int64_t SecondsPerDay = 86'400;
+
+        constexpr std::int64_t FloorDiv(std::int64_t a, std::int64_t b)
+        {
+            return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+        }
+
+        struct CivilDate
+        {
+            std::int64_t year;
+            unsigned     month;
+            unsigned     day;
+        };
+
+        // Days since 1970-01-01 to proleptic Gregorian y/m/d
+        // (H. Hinnant, "chrono-Compatible Low-Level Date Algorithms").
+        constexpr CivilDate CivilFromDays(std::int64_t z)
+        {
+            z += 719'468;
+            const std::int64_t era = (z >= 0 ? z : z - 146'096) / 146'097;
+            const auto doe = static_cast<unsigned>(z - era * 146'097);
+            const unsigned yoe =
+                (doe - doe / 1460 + doe / 36'524 - doe / 146'096) / 365;
+            const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const unsigned mp  = (5 * doy + 2) / 153;
+            const unsigned d   = doy - (153 * mp + 2) / 5 + 1;
+            const unsigned m   = mp < 10 ? mp + 3 : mp - 9;
+            const std::int64_t y =
+                static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2);
+            return {y, m, d};
+        }
+
+        inline void Put2(char* out, unsigned value)
+        {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+        }
+
+        // Writes @p value zero-padded to exactly @p width digits.
+        inline void PutFixed(char* out, std::uint64_t value, int width)
+        {
+            for (int i = width - 1; i >= 0; --i)
+            {
+                out[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+        }
+    } // namespace
+
+    TimestampFormatter::TimestampFormatter(TimestampFormat format) noexcept :
+        mFormat(format),
+        mDigits(format.fractionalDigits < 0
+                    ? NativeDigits()
+                    : std::min(format.fractionalDigits, 9))
+    {
+    }
+
+    void TimestampFormatter::RebuildSeconds(std::int64_t seconds)
+    {
+        char* out = mBuffer;
+
+        if (mFormat.style == TimestampStyle::Epoch)
+        {
+            auto result = std::to_chars(out, out + 24, seconds);
+            mPrefixSize = static_cast<std::size_t>(result.ptr - out);
+            return;
+        }
+
+        const std::int64_t day       = FloorDiv(seconds, SecondsPerDay);
+        const auto         secOfDay  = static_cast<unsigned>(
+            seconds - day * SecondsPerDay);
+
+        if (!mHasCache || day != mCachedDay)
+        {
+            const CivilDate date = CivilFromDays(day);
+            // %F pads the year to at least four digits.
+            std::size_t pos = 0;
+            if (date.year >= 0 && date.year <= 9999)
+            {
+                PutFixed(out, static_cast<std::uint64_t>(date.year), 4);
+                pos = 4;
+            }
+            else
+            {
+                auto result = std::to_chars(out, out + 24, date.year);
+                pos         = static_cast<std::size_t>(result.ptr - out);
+            }
+            out[pos] = '-';
+            Put2(out + pos + 1, date.month);
+            out[pos + 3] = '-';
+            Put2(out + pos + 4, date.day);
+            out[pos + 6] =
+                mFormat.style == TimestampStyle::Iso8601 ? 'T' : ' ';
+            mPrefixSize = pos + 7 + 8; // date, separator, "HH:MM:SS"
+            mCachedDay  = day;
+        }
+
+        char* time = out + mPrefixSize - 8;
+        Put2(time, secOfDay / 3600);
+        time[2] = ':';
+        Put2(time + 3, secOfDay / 60 % 60);
+        time[5] = ':';
+        Put2(time + 6, secOfDay % 60);
+    }
+
+    std::string_view TimestampFormatter::Format(Clock::time_point tp)
+    {
+        using namespace std::chrono;
+
+        const auto         wholeSeconds = floor<seconds>(tp);
+        const std::int64_t seconds = wholeSeconds.time_since_epoch().count();
+
+        if (!mHasCache || seconds != mCachedSeconds)
+        {
+            RebuildSeconds(seconds);
+            mCachedSeconds = seconds;
+            mHasCache      = true;
+        }
+
+        std::size_t size = mPrefixSize;
+        if (mDigits > 0)
+        {
+            // Ticks of the clock within the second, rescaled to the
+            // requested number of digits (truncating, like chrono).
+            constexpr int native = NativeDigits();
+            auto          ticks  = static_cast<std::uint64_t>(
+                (tp - wholeSeconds).count());
+            if (mDigits < native)
+                ticks /= static_cast<std::uint64_t>(Pow10(native - mDigits));
+            else if (mDigits > native)
+                ticks *= static_cast<std::uint64_t>(Pow10(mDigits - native));
+
+            mBuffer[size++] = '.';
+            PutFixed(mBuffer + size, ticks, mDigits);
+            size += static_cast<std::size_t>(mDigits);
+        }
+        if (mFormat.style == TimestampStyle::Iso8601)
+            mBuffer[size++] = 'Z';
+
+        return {mBuffer, size};
+    }
+} // namespace SKIRNIR_NAMESPACE
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <Skirnir/Logging.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+
+// Counting replacement for the global allocation functions. It applies
+// to the whole executable, which is why this spec is built on its own
+// (SkirnirAllocTest_run) rather than into SkirnirTest_run. Counting is
+// enabled per thread so that allocations made by unrelated threads
+// (gtest, lingering sink workers) never leak into a measurement.
+namespace
+{
+    thread_local bool        tCounting    = false;
+    thread_local std::size_t tAllocations = 0;
+
+    class AllocationCounter
+    {
+      public:
+        AllocationCounter()
+        {
+            tAllocations = 0;
+            tCounting    = true;
+        }
+
+        ~AllocationCounter()
+        {
+            tCounting = false;
+        }
+
+        std::size_t Count() const noexcept
+        {
+            return tAllocations;
+        }
+    };
+
+    void* CountedAlloc(std::size_t size)
+    {
+        if (tCounting)
+            ++tAllocations;
+        if (void* p = std::malloc(size ? size : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    struct AllocationCategory
+    {
+    };
+
+    // Sink that inspects the record without keeping or copying it.
+    class InspectingSink final : public skr::ILogSink
+    {
+      public:
+        void Write(const skr::LogRecord& r) override
+        {
+            mCount.fetch_add(1, std::memory_order_relaxed);
+            mBytes.fetch_add(r.message.size() + r.category.size() +
+                                 r.scopes.size(),
+                             std::memory_order_relaxed);
+        }
+
+        std::uint64_t Count() const noexcept
+        {
+            return mCount.load(std::memory_order_relaxed);
+        }
+
+      private:
+        std::atomic<std::uint64_t> mCount {0};
+        std::atomic<std::uint64_t> mBytes {0};
+    };
+
+    // Sink that keeps the last record, so tests can look at what the
+    // logger produced.
+    class LastRecordSink final : public skr::ILogSink
+    {
+      public:
+        void Write(const skr::LogRecord& r) override
+        {
+            last = r;
+        }
+
+        skr::LogRecord last;
+    };
+} // namespace
+
+TEST(LogRecordAllocationSpec, Dispatch_DoesNotAllocateOnCommonPath)
+{
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ClearSinks();
+    auto sink = skr::MakeArc<InspectingSink>();
+    options->AddSink(sink);
+
+    skr::Logger<AllocationCategory> logger(options);
+    auto scope = options->BeginScope("request-42");
+
+    // Warm-up: first dispatch may publish the sink snapshot.
+    logger.LogInformation("warm-up {}", 0);
+
+    std::size_t allocations = 0;
+    {
+        AllocationCounter counter;
+        for (int i = 0; i < 1000; ++i)
+        {
+            logger.LogInformation("user {} did {} in {} steps", i,
+                                  std::string_view("checkout"), i * 3);
+        }
+        allocations = counter.Count();
+    }
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(sink->Count(), 1001u);
+}
+
+TEST(LogRecordAllocationSpec, LongMessage_SpillsToHeapAndKeepsContent)
+{
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ClearSinks();
+    auto sink = skr::MakeArc<LastRecordSink>();
+    options->AddSink(sink);
+
+    skr::Logger<AllocationCategory> logger(options);
+
+    const std::string big(skr::LogMessage::InlineCapacity * 3, 'x');
+    logger.LogInformation("<{}>", big);
+
+    ASSERT_EQ(sink->last.message.size(), big.size() + 2);
+    EXPECT_FALSE(sink->last.message.IsInline());
+    EXPECT_EQ(sink->last.message, "<" + big + ">");
+
+    logger.LogInformation("short");
+    EXPECT_TRUE(sink->last.message.IsInline());
+    EXPECT_EQ(sink->last.message, "short");
+}
+
+TEST(LogRecordAllocationSpec, Category_PointsAtStaticTypeName)
+{
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ClearSinks();
+    auto sink = skr::MakeArc<LastRecordSink>();
+    options->AddSink(sink);
+
+    skr::Logger<AllocationCategory> logger(options);
+    logger.LogInformation("a");
+    const auto first = sink->last.category;
+    logger.LogInformation("b");
+
+    EXPECT_EQ(first.data(), sink->last.category.data());
+    EXPECT_NE(first.find("AllocationCategory"), std::string_view::npos);
+}
+
+TEST(LogRecordAllocationSpec, Scopes_AreSharedBetweenRecords)
+{
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ClearSinks();
+    auto sink = skr::MakeArc<LastRecordSink>();
+    options->AddSink(sink);
+
+    skr::Logger<AllocationCategory> logger(options);
+
+    auto outer = options->BeginScope("outer");
+    auto inner = options->BeginScope("inner");
+
+    logger.LogInformation("one");
+    const auto first = sink->last.scopes;
+    logger.LogInformation("two");
+
+    EXPECT_EQ(first.Tail().get(), sink->last.scopes.Tail().get());
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0], "outer");
+    EXPECT_EQ(first[1], "inner");
+}
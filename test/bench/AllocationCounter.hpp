@@ -0,0 +1,51 @@
+// Counts heap allocations per thread by replacing the global operator new
+// and operator delete. Include it from exactly one source file of each
+// benchmark executable: the replacements are ordinary (non-inline)
+// definitions, and a second copy would not link.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Heap allocations made by the current thread; see the replaced
+    // global operator new below.
+    thread_local std::uint64_t tAllocations = 0;
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++tAllocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
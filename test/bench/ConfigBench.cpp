@@ -0,0 +1,407 @@
+// Configuration microbenchmark. Every case reports heap allocations per
+// operation next to its time, so changes to the lookup and merge paths
+// show up in both.
+//
+// Key lookup: builds configurations of a few thousand to a few hundred
+// thousand keys and measures the per-call cost of the dotted-path getters:
+//   A. HasKey on an existing leaf
+//   B. HasKey on a missing key
+//   C. GetInt on an existing leaf
+//   D. GetString on an existing leaf
+//   E. GetSection on the object holding a leaf (depth 2 and deeper)
+//
+// The first table keeps ~4k leaves and varies the depth; the second keeps
+// depth 2 and varies the key count. Keys are visited in a shuffled order
+// so the lookups do not walk memory sequentially. Build() time, which
+// includes indexing, is reported per configuration.
+//
+// Build: ConfigurationBuilder from scratch to Build() over 1 to 64
+// overlapping JSON string sources of 1 to 10k leaves each, and over 1000
+// prefixed environment variables.
+//
+// Binding: Bind<T>() on option structs of 5, 48 and 200 fields (F to H),
+// and on one holding a vector and a map of 64 nested structs each (I).
+
+#include <Skirnir/Configuration.hpp>
+
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define SKR_BENCH_FIELDS8(p)                                                 \
+    int p##0 = 0, p##1 = 0, p##2 = 0, p##3 = 0, p##4 = 0, p##5 = 0, p##6 = 0, \
+        p##7 = 0;
+
+namespace bench
+{
+    struct Small
+    {
+        std::string        host;
+        int                port    = 0;
+        bool               ssl     = false;
+        double             timeout = 0.0;
+        std::optional<int> retries;
+    };
+
+    struct Fields48
+    {
+        SKR_BENCH_FIELDS8(a) SKR_BENCH_FIELDS8(b) SKR_BENCH_FIELDS8(c)
+        SKR_BENCH_FIELDS8(d) SKR_BENCH_FIELDS8(e) SKR_BENCH_FIELDS8(f)
+    };
+
+    struct Fields200
+    {
+        SKR_BENCH_FIELDS8(a) SKR_BENCH_FIELDS8(b) SKR_BENCH_FIELDS8(c)
+        SKR_BENCH_FIELDS8(d) SKR_BENCH_FIELDS8(e) SKR_BENCH_FIELDS8(f)
+        SKR_BENCH_FIELDS8(g) SKR_BENCH_FIELDS8(h) SKR_BENCH_FIELDS8(i)
+        SKR_BENCH_FIELDS8(j) SKR_BENCH_FIELDS8(k) SKR_BENCH_FIELDS8(l)
+        SKR_BENCH_FIELDS8(m) SKR_BENCH_FIELDS8(n) SKR_BENCH_FIELDS8(o)
+        SKR_BENCH_FIELDS8(p) SKR_BENCH_FIELDS8(q) SKR_BENCH_FIELDS8(r)
+        SKR_BENCH_FIELDS8(s) SKR_BENCH_FIELDS8(t) SKR_BENCH_FIELDS8(u)
+        SKR_BENCH_FIELDS8(v) SKR_BENCH_FIELDS8(w) SKR_BENCH_FIELDS8(x)
+        SKR_BENCH_FIELDS8(y)
+    };
+
+    struct Cluster
+    {
+        std::vector<Small>           nodes;
+        std::map<std::string, Small> named;
+    };
+} // namespace bench
+
+namespace
+{
+    namespace skr = SKIRNIR_NAMESPACE;
+
+    constexpr int kLookups    = 2'000'000;
+    constexpr int kBindFields = 4'000'000;  // fields bound per Bind case
+    constexpr int kBuildBytes = 64 << 20;   // JSON parsed per Build case
+    constexpr int kEnvBuilds  = 200;
+
+    struct Measurement
+    {
+        double nsPerOp     = 0;
+        double allocsPerOp = 0;
+    };
+
+    // Calls @p op(i) for i in [0, iterations) and returns the mean time
+    // and heap allocations per call.
+    template <typename Fn>
+    Measurement Measure(int iterations, Fn&& op)
+    {
+        const std::uint64_t allocations = tAllocations;
+        const auto          t0          = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            op(i);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        Measurement out;
+        out.nsPerOp =
+            std::chrono::duration<double, std::nano>(t1 - t0).count() /
+            iterations;
+        out.allocsPerOp =
+            static_cast<double>(tAllocations - allocations) / iterations;
+        return out;
+    }
+
+    // A tree of @p depth levels with @p fan members per object; leaves
+    // hold their ordinal. Every leaf path is appended to @p keys.
+    void Generate(std::string& json, std::vector<std::string>& keys,
+                  std::string& path, int depth, int fan, int& ordinal)
+    {
+        json.push_back('{');
+        for (int i = 0; i < fan; ++i)
+        {
+            if (i > 0)
+                json.push_back(',');
+            const std::string name = "key" + std::to_string(i);
+            const auto        base = path.size();
+            if (base > 0)
+                path.push_back('.');
+            path += name;
+            json += "\"" + name + "\":";
+            if (depth == 1)
+            {
+                json += std::to_string(ordinal++);
+                keys.push_back(path);
+            }
+            else
+            {
+                Generate(json, keys, path, depth - 1, fan, ordinal);
+            }
+            path.resize(base);
+        }
+        json.push_back('}');
+    }
+
+    template <typename Fn>
+    void Run(const char* label, const std::vector<std::string>& keys,
+             Fn&& lookup)
+    {
+        std::uint64_t checksum = 0;
+        const auto    m        = Measure(kLookups, [&](int i) {
+            checksum += lookup(keys[static_cast<std::size_t>(i) % keys.size()]);
+        });
+        std::printf("    %-14s: %8.1f ns/op %6.2f alloc/op  (checksum %llu)\n",
+                    label, m.nsPerOp, m.allocsPerOp,
+                    static_cast<unsigned long long>(checksum));
+    }
+
+    void Case(int depth, int fan)
+    {
+        std::string              json;
+        std::vector<std::string> keys;
+        std::string              path;
+        int                      leaves = 0;
+        Generate(json, keys, path, depth, fan, leaves);
+
+        std::vector<std::string> missing;
+        missing.reserve(keys.size());
+        for (const auto& key : keys)
+            missing.push_back(key + "x");
+
+        std::mt19937 rng(42);
+        std::shuffle(keys.begin(), keys.end(), rng);
+        std::shuffle(missing.begin(), missing.end(), rng);
+
+        // The object holding each leaf, in the same shuffled order.
+        std::vector<std::string> sections;
+        if (depth > 1)
+        {
+            sections.reserve(keys.size());
+            for (const auto& key : keys)
+                sections.push_back(key.substr(0, key.rfind('.')));
+        }
+
+        skr::Arc<skr::ConfigurationOptions> config;
+        const auto build = Measure(1, [&](int) {
+            config = skr::ConfigurationBuilder().AddJsonString(json).Build();
+        });
+        std::printf("depth %d, %d keys, %.1f KiB: Build %.2f ms, %.0f allocs\n",
+                    depth, leaves, json.size() / 1024.0, build.nsPerOp / 1e6,
+                    build.allocsPerOp);
+
+        Run("[A] HasKey", keys,
+            [&](const std::string& k) { return config->HasKey(k) ? 1 : 0; });
+        Run("[B] HasKey-", missing,
+            [&](const std::string& k) { return config->HasKey(k) ? 1 : 0; });
+        Run("[C] GetInt", keys, [&](const std::string& k) {
+            return static_cast<std::uint64_t>(config->GetInt(k));
+        });
+        Run("[D] GetString", keys,
+            [&](const std::string& k) { return config->GetString(k).size(); });
+        if (!sections.empty())
+        {
+            Run("[E] GetSection", sections, [&](const std::string& k) {
+                return config->GetSection(k)->HasKey("key0") ? 1 : 0;
+            });
+        }
+    }
+
+    // A fresh builder over @p sources, built; the sources are parsed and
+    // merged on every call, as at startup.
+    void BuildCase(int sources, int fan)
+    {
+        std::vector<std::string> jsons;
+        std::size_t              bytes = 0;
+        int                      leaves = 0;
+        for (int s = 0; s < sources; ++s)
+        {
+            // Same shape, different values: every source overrides the
+            // previous one's leaves.
+            std::string              json;
+            std::vector<std::string> keys;
+            std::string              path;
+            int                      ordinal = s;
+            Generate(json, keys, path, 2, fan, ordinal);
+            bytes += json.size();
+            leaves = static_cast<int>(keys.size());
+            jsons.push_back(std::move(json));
+        }
+
+        const int iterations =
+            std::max(3, static_cast<int>(kBuildBytes / bytes));
+        std::uint64_t checksum = 0;
+        const auto    m        = Measure(iterations, [&](int) {
+            skr::ConfigurationBuilder builder;
+            for (const auto& json : jsons)
+                builder.AddJsonString(json);
+            checksum += static_cast<std::uint64_t>(
+                builder.Build()->GetInt("key0.key1"));
+        });
+        std::printf("    %2d x %5d keys %8.1f KiB: %9.3f ms/build %9.0f "
+                    "alloc/build  (checksum %llu)\n",
+                    sources, leaves, bytes / 1024.0, m.nsPerOp / 1e6,
+                    m.allocsPerOp, static_cast<unsigned long long>(checksum));
+    }
+
+    void SetEnv(const std::string& name, const std::string& value)
+    {
+#if defined(_WIN32)
+        _putenv_s(name.c_str(), value.c_str());
+#else
+        ::setenv(name.c_str(), value.c_str(), 1);
+#endif
+    }
+
+    void UnsetEnv(const std::string& name)
+    {
+#if defined(_WIN32)
+        _putenv_s(name.c_str(), "");
+#else
+        ::unsetenv(name.c_str());
+#endif
+    }
+
+    // 1000 variables, SKRBENCH_group<g>__key<k>: ten sections of a hundred
+    // keys each; values alternate between numbers and text so
+    // both coercion paths run.
+    void EnvCase()
+    {
+        std::vector<std::string> names;
+        for (int g = 0; g < 10; ++g)
+        {
+            for (int k = 0; k < 100; ++k)
+            {
+                names.push_back("SKRBENCH_group" + std::to_string(g) +
+                                "__key" + std::to_string(k));
+                SetEnv(names.back(), k % 2 ? "value" + std::to_string(k)
+                                           : std::to_string(g * 100 + k));
+            }
+        }
+
+        std::uint64_t checksum = 0;
+        const auto    m        = Measure(kEnvBuilds, [&](int) {
+            checksum += static_cast<std::uint64_t>(
+                skr::ConfigurationBuilder()
+                    .AddEnvironmentVariables("SKRBENCH_")
+                    .Build()
+                    ->GetInt("group9.key98"));
+        });
+        std::printf("    %4zu env vars         : %9.3f ms/build %9.0f "
+                    "alloc/build  (checksum %llu)\n",
+                    names.size(), m.nsPerOp / 1e6, m.allocsPerOp,
+                    static_cast<unsigned long long>(checksum));
+
+        for (const auto& name : names)
+            UnsetEnv(name);
+    }
+
+    void BuildCases()
+    {
+        std::printf("Build\n");
+        for (int sources : {1, 4, 16, 64})
+        {
+            // ~1 KiB, ~16 KiB and ~190 KiB per source.
+            for (int fan : {8, 32, 100})
+                BuildCase(sources, fan);
+        }
+        EnvCase();
+    }
+
+    // {"a0": 1, ..., "a7": 8, "b0": 9, ...} for the first @p groups letters.
+    std::string FieldsJson(int groups)
+    {
+        std::string json  = "{";
+        int         value = 0;
+        for (int g = 0; g < groups; ++g)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                if (value > 0)
+                    json += ',';
+                json += '"';
+                json += static_cast<char>('a' + g);
+                json += std::to_string(i) + "\":" + std::to_string(++value);
+            }
+        }
+        return json + "}";
+    }
+
+    std::string SmallJson(int i)
+    {
+        return "{\"host\":\"node" + std::to_string(i) +
+               ".local\",\"port\":" + std::to_string(5000 + i) +
+               ",\"ssl\":true,\"timeout\":2.5,\"retries\":3}";
+    }
+
+    template <typename T>
+    void BindCase(const char* label, const std::string& json, int fields,
+                  std::uint64_t (*checksumOf)(const T&))
+    {
+        auto config = skr::ConfigurationBuilder().AddJsonString(json).Build();
+        const int     iterations = kBindFields / fields;
+        std::uint64_t checksum   = 0;
+
+        const auto m = Measure(iterations, [&](int) {
+            checksum += checksumOf(*config->Bind<T>());
+        });
+        std::printf("    %-16s: %9.1f ns/bind %6.1f ns/field %7.1f "
+                    "alloc/bind (checksum %llu)\n",
+                    label, m.nsPerOp, m.nsPerOp / fields, m.allocsPerOp,
+                    static_cast<unsigned long long>(checksum));
+    }
+
+    void BindCases()
+    {
+        std::printf("Bind<T>\n");
+        BindCase<bench::Small>("[F] 5 fields", SmallJson(1), 5,
+                               [](const bench::Small& o) {
+                                   return std::uint64_t(o.port + o.host.size());
+                               });
+        BindCase<bench::Fields48>("[G] 48 fields", FieldsJson(6), 48,
+                                  [](const bench::Fields48& o) {
+                                      return std::uint64_t(o.a0 + o.f7);
+                                  });
+        BindCase<bench::Fields200>("[H] 200 fields", FieldsJson(25), 200,
+                                   [](const bench::Fields200& o) {
+                                       return std::uint64_t(o.a0 + o.y7);
+                                   });
+
+        std::string cluster = "{\"nodes\":[";
+        for (int i = 0; i < 64; ++i)
+            cluster += (i ? "," : "") + SmallJson(i);
+        cluster += "],\"named\":{";
+        for (int i = 0; i < 64; ++i)
+            cluster += (i ? ",\"n" : "\"n") + std::to_string(i) +
+                       "\":" + SmallJson(i);
+        cluster += "}}";
+        BindCase<bench::Cluster>("[I] 2x64 nested", cluster, 128 * 5,
+                                 [](const bench::Cluster& o) {
+                                     return std::uint64_t(o.nodes.size() +
+                                                          o.named.size());
+                                 });
+    }
+} // namespace
+
+int main()
+{
+    std::printf("ConfigBench: %d lookups per case\n", kLookups);
+    std::printf("-----------------------------------------------\n");
+
+    // ~4k leaves at increasing depth.
+    Case(1, 4096);
+    Case(2, 64);
+    Case(3, 16);
+    Case(4, 8);
+    Case(6, 4);
+
+    // Depth 2, increasing key count.
+    Case(2, 32);
+    Case(2, 100);
+    Case(2, 316);
+
+    BuildCases();
+    BindCases();
+    return 0;
+}
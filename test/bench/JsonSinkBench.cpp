@@ -0,0 +1,144 @@
+// NDJSON encoding microbenchmark.
+//
+// Compares the per-record cost of turning a LogRecord into an NDJSON line:
+//   A. simdjson::to_json on a reflected view   (what JsonSink used to do)
+//   B. JsonSink::Write                          (hand-written encoder)
+//   C. JsonSink::Write with four structured fields
+//   D. JsonSink::WriteBatch, 64 records per call
+//
+// Every case writes into the same counting stream buffer, so the numbers
+// cover encoding plus the sink's own locking, but no real I/O. The
+// message contains a quote and a newline so that escaping is exercised.
+
+#include "Skirnir/Logging/LogRecord.hpp"
+#include "Skirnir/Logging/LogSinks/JsonSink.hpp"
+
+#define SIMDJSON_STATIC_REFLECTION 1
+#include <simdjson.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::system_clock;
+
+    constexpr int kIterations = 2'000'000;
+    constexpr int kBatch      = 64;
+
+    // Discards output but keeps the byte count observable.
+    class CountingBuffer final : public std::streambuf
+    {
+      public:
+        std::uint64_t bytes = 0;
+
+      protected:
+        std::streamsize xsputn(const char*, std::streamsize n) override
+        {
+            bytes += static_cast<std::uint64_t>(n);
+            return n;
+        }
+
+        int_type overflow(int_type ch) override
+        {
+            ++bytes;
+            return ch;
+        }
+    };
+
+    struct JsonRecordView
+    {
+        SKIRNIR_NAMESPACE::LogLevel   level;
+        Clock::time_point             timestamp;
+        std::string_view              category;
+        std::string_view              message;
+        std::vector<std::string_view> scopes;
+    };
+
+    SKIRNIR_NAMESPACE::LogRecord MakeRecord()
+    {
+        SKIRNIR_NAMESPACE::LogRecord r;
+        r.level     = SKIRNIR_NAMESPACE::LogLevel::Information;
+        r.timestamp = Clock::now();
+        r.category  = "my_app::services::OrderRepository";
+        r.message   = "order 1842 \"accepted\" for customer 77\nretry=0";
+        return r;
+    }
+
+    template <typename Fn>
+    void Run(const char* label, int records, CountingBuffer& sink, Fn&& body)
+    {
+        sink.bytes    = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        body();
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(t1 - t0).count();
+        std::printf("%-36s: %8.1f ns/rec  %12.0f rec/s  (%llu bytes)\n",
+                    label, seconds * 1e9 / records, records / seconds,
+                    static_cast<unsigned long long>(sink.bytes));
+    }
+} // namespace
+
+int main()
+{
+    std::printf("JsonSinkBench: %d records\n", kIterations);
+    std::printf("-----------------------------------------------\n");
+
+    CountingBuffer buffer;
+    std::ostream   os(&buffer);
+
+    SKIRNIR_NAMESPACE::LogRecord record = MakeRecord();
+
+    Run("[A] simdjson::to_json", kIterations, buffer, [&] {
+        for (int i = 0; i < kIterations; ++i)
+        {
+            JsonRecordView view {record.level, record.timestamp,
+                                 record.category, record.message.View(),
+                                 {}};
+            auto json = simdjson::to_json(view);
+            if (json.has_value())
+                os << std::string_view(json.value()) << '\n';
+        }
+    });
+
+    {
+        SKIRNIR_NAMESPACE::JsonSink sink(os);
+        Run("[B] JsonSink::Write", kIterations, buffer, [&] {
+            for (int i = 0; i < kIterations; ++i)
+                sink.Write(record);
+        });
+    }
+
+    {
+        SKIRNIR_NAMESPACE::LogRecord withFields = MakeRecord();
+        withFields.fields = {{"order_id", 1842},
+                             {"customer", "c-77"},
+                             {"amount", 129.95},
+                             {"express", true}};
+
+        SKIRNIR_NAMESPACE::JsonSink sink(os);
+        Run("[C] JsonSink::Write, 4 fields", kIterations, buffer, [&] {
+            for (int i = 0; i < kIterations; ++i)
+                sink.Write(withFields);
+        });
+    }
+
+    {
+        std::vector<SKIRNIR_NAMESPACE::LogRecord> batch(kBatch, record);
+
+        SKIRNIR_NAMESPACE::JsonSink sink(os);
+        Run("[D] JsonSink::WriteBatch x64", kIterations, buffer, [&] {
+            for (int i = 0; i < kIterations / kBatch; ++i)
+                sink.WriteBatch(batch);
+        });
+    }
+    return 0;
+}
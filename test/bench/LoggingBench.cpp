@@ -1,148 +1,492 @@
-// Logging throughput microbenchmark.
+// Logging benchmark suite.
 //
-// Measures LoggerOptions::Dispatch() under three sink configurations:
-//   A. ConsoleSink        (synchronous, mutex-protected — reproduces
-//                          the regression observed in the wrk benchmark
-//                          at 657k → 16k req/s when log middleware is
-//                          enabled).
-//   B. AsyncSink(ConsoleSink)  (the new default).
-//   C. NullSink           (sanity upper bound, no I/O).
+// Every case prints one JSON object per line on stdout, so runs can be
+// stored and compared over time; a readable summary goes to stderr.
 //
-// Each case runs N producer threads, each issuing kPerThread records for
-// kSeconds wall time. We report records/sec/core and the AsyncSink drop
-// count. The benchmark is intentionally minimal — no Google Benchmark
-// dependency — so the CMake build stays self-contained.
+//   producer  Per-call latency of Logger<T>::LogInformation (p50, p99,
+//             p999, max), records/s and heap allocations per record.
+//             Swept over the number of format arguments and over the
+//             message size, for NullSink, FileSink, JsonSink and
+//             AsyncSink(NullSink).
+//   e2e       Enqueue-to-write latency through AsyncSink: the inner
+//             sink subtracts the record timestamp from the time it
+//             receives the record. Run paced and saturated.
+//   overload  Drop rate of AsyncSink when producers outrun a slow inner
+//             sink.
+//
+// File sinks write under $SKIRNIR_BENCH_DIR, else /dev/shm (tmpfs) when
+// it exists, else the temporary directory, so the numbers measure the
+// logging path rather than the disk.
+//
+// Usage: SkirnirBench [--quick] [--threads N]
+//
+// No Google Benchmark dependency, so the CMake build stays
+// self-contained.
 
 #include "Skirnir/Common/Arc.hpp"
 #include "Skirnir/Logging/LogSinks.hpp"
 #include "Skirnir/Logging/Logger.hpp"
 
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace
 {
+    namespace skr = SKIRNIR_NAMESPACE;
+
+    using SteadyClock = std::chrono::steady_clock;
+
     struct BenchCategory
     {
     };
 
-    struct BenchResult
+    using BenchLogger = skr::Logger<BenchCategory>;
+    using Call        = std::function<void(BenchLogger&, int)>;
+
+    struct Settings
     {
-        std::uint64_t records;
-        double        seconds;
-        std::uint64_t dropped;
+        int records = 200'000; // per producer thread
+        int threads = 1;
     };
 
-    template <typename SinkFactory>
-    BenchResult Run(SinkFactory&& makeSink, int threads, int perThread)
+    // ----- Statistics ---------------------------------------------------
+
+    struct Percentiles
     {
-        auto options = SKIRNIR_NAMESPACE::MakeArc<SKIRNIR_NAMESPACE::LoggerOptions>();
-        options->ClearSinks();
-        options->AddSink(makeSink());
+        std::uint64_t p50  = 0;
+        std::uint64_t p99  = 0;
+        std::uint64_t p999 = 0;
+        std::uint64_t max  = 0;
+    };
 
-        SKIRNIR_NAMESPACE::Logger<BenchCategory> logger(options);
+    Percentiles Summarize(std::vector<std::uint32_t>& samples)
+    {
+        Percentiles out;
+        if (samples.empty())
+            return out;
+        std::sort(samples.begin(), samples.end());
+        const auto at = [&](double q) {
+            const auto i = static_cast<std::size_t>(
+                q * static_cast<double>(samples.size() - 1));
+            return static_cast<std::uint64_t>(samples[i]);
+        };
+        out.p50  = at(0.50);
+        out.p99  = at(0.99);
+        out.p999 = at(0.999);
+        out.max  = samples.back();
+        return out;
+    }
 
-        std::atomic<int> ready {0};
-        std::atomic<bool> go {false};
-        std::atomic<std::uint64_t> total {0};
+    std::uint32_t ElapsedNs(SteadyClock::time_point from,
+                            SteadyClock::time_point to)
+    {
+        const auto ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+                .count();
+        return static_cast<std::uint32_t>(
+            std::clamp<long long>(ns, 0, UINT32_MAX));
+    }
 
-        std::vector<std::thread> ts;
-        ts.reserve(threads);
-        for (int t = 0; t < threads; ++t)
+    // ----- Sinks --------------------------------------------------------
+
+    std::filesystem::path BenchDirectory()
+    {
+        if (const char* dir = std::getenv("SKIRNIR_BENCH_DIR"))
+            return dir;
+        std::error_code ec;
+        if (std::filesystem::is_directory("/dev/shm", ec))
+            return "/dev/shm";
+        return std::filesystem::temp_directory_path();
+    }
+
+    std::filesystem::path BenchFile(std::string_view name)
+    {
+        auto path = BenchDirectory() /
+                    ("skirnir-bench-" + std::string(name) + ".log");
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return path;
+    }
+
+    // Records how long each record took from Logger<T> to this sink.
+    class LatencySink final : public skr::ILogSink
+    {
+      public:
+        void Write(const skr::LogRecord& r) override
+        {
+            const auto now = std::chrono::system_clock::now();
+            const auto ns =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - r.timestamp)
+                    .count();
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSamples.push_back(static_cast<std::uint32_t>(
+                std::clamp<long long>(ns, 0, UINT32_MAX)));
+        }
+
+        std::vector<std::uint32_t> Take()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return std::move(mSamples);
+        }
+
+      private:
+        std::mutex                 mMutex;
+        std::vector<std::uint32_t> mSamples;
+    };
+
+    // Stands in for a sink that cannot keep up, e.g. a remote collector.
+    class SlowSink final : public skr::ILogSink
+    {
+      public:
+        explicit SlowSink(std::chrono::nanoseconds cost) : mCost(cost)
+        {
+        }
+
+        void Write(const skr::LogRecord&) override
+        {
+            const auto until = SteadyClock::now() + mCost;
+            while (SteadyClock::now() < until)
+            {
+            }
+        }
+
+      private:
+        std::chrono::nanoseconds mCost;
+    };
+
+    struct SinkCase
+    {
+        const char*                              name;
+        std::function<skr::Arc<skr::ILogSink>()> make;
+    };
+
+    std::vector<SinkCase> ProducerSinks()
+    {
+        return {
+            {"null", [] { return skr::MakeArc<skr::NullSink>(); }},
+            {"file",
+             [] {
+                 return skr::MakeArc<skr::FileSink>(BenchFile("file"), false);
+             }},
+            {"json",
+             [] { return skr::MakeArc<skr::JsonSink>(BenchFile("json")); }},
+            {"async_null",
+             [] {
+                 return skr::MakeArc<skr::AsyncSink>(
+                     skr::MakeArc<skr::NullSink>(), 1 << 16);
+             }},
+        };
+    }
+
+    // ----- Workloads ----------------------------------------------------
+
+    // One call with @p Args format arguments. The message text stays
+    // close to 40 bytes whatever the count, so only formatting varies.
+    template <int Args>
+    void LogArgs(BenchLogger& logger, int i)
+    {
+        if constexpr (Args == 0)
+            logger.LogInformation("order accepted for customer 77, eu-west");
+        else if constexpr (Args == 1)
+            logger.LogInformation("order {} accepted for customer 77", i);
+        else if constexpr (Args == 2)
+            logger.LogInformation("order {} accepted for customer {}", i, 77);
+        else if constexpr (Args == 4)
+            logger.LogInformation("order {} for {} at {:.2f} via {}", i, 77,
+                                  12.5, "eu");
+        else
+            logger.LogInformation("{} {} {} {} {:.1f} {} {} {}", i, 77, 'x',
+                                  true, 12.5, "eu", 3u, -1);
+    }
+
+    struct ProducerResult
+    {
+        Percentiles   latency;
+        double        recordsPerSec      = 0;
+        double        allocationsPerCall = 0;
+        std::uint64_t dropped            = 0;
+    };
+
+    // Runs @p call on every producer thread and times each call.
+    ProducerResult RunProducers(const Settings&                s,
+                                const skr::Arc<skr::ILogSink>& sink,
+                                const Call&                    call)
+    {
+        auto options = skr::MakeArc<skr::LoggerOptions>();
+        options->logLevel = skr::LogLevel::Information;
+        options->AddSink(sink);
+        BenchLogger logger(options);
+
+        std::vector<std::vector<std::uint32_t>> samples(s.threads);
+        std::atomic<std::uint64_t>             allocations {0};
+        std::atomic<int>                       ready {0};
+        std::atomic<bool>                      go {false};
+
+        std::vector<std::thread> producers;
+        producers.reserve(s.threads);
+        for (int t = 0; t < s.threads; ++t)
         {
-            ts.emplace_back([&]() {
+            producers.emplace_back([&, t] {
+                auto& mine = samples[t];
+                mine.reserve(s.records);
+                // Warm up per-thread buffers and caches before measuring.
+                for (int i = 0; i < 1000; ++i)
+                    call(logger, i);
+
                 ready.fetch_add(1, std::memory_order_release);
                 while (!go.load(std::memory_order_acquire))
-                {
                     std::this_thread::yield();
-                }
-                for (int i = 0; i < perThread; ++i)
+
+                const std::uint64_t before = tAllocations;
+                for (int i = 0; i < s.records; ++i)
                 {
-                    logger.LogInformation("bench-msg-{}", i);
+                    const auto t0 = SteadyClock::now();
+                    call(logger, i);
+                    mine.push_back(ElapsedNs(t0, SteadyClock::now()));
                 }
-                total.fetch_add(perThread, std::memory_order_relaxed);
+                // The samples vector was reserved, so every allocation
+                // counted here came from the logging path.
+                allocations.fetch_add(tAllocations - before,
+                                      std::memory_order_relaxed);
             });
         }
 
-        while (ready.load(std::memory_order_acquire) < threads)
-        {
+        while (ready.load(std::memory_order_acquire) < s.threads)
             std::this_thread::yield();
+        const auto start = SteadyClock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& p : producers)
+            p.join();
+        const auto end = SteadyClock::now();
+        sink->Flush();
+
+        std::vector<std::uint32_t> all;
+        all.reserve(static_cast<std::size_t>(s.records) * s.threads);
+        for (auto& v : samples)
+            all.insert(all.end(), v.begin(), v.end());
+
+        const double calls   = static_cast<double>(all.size());
+        const double seconds =
+            std::chrono::duration<double>(end - start).count();
+
+        ProducerResult out;
+        out.latency            = Summarize(all);
+        out.recordsPerSec      = seconds > 0 ? calls / seconds : 0;
+        out.allocationsPerCall = calls > 0 ? allocations.load() / calls : 0;
+        if (auto* async = dynamic_cast<skr::AsyncSink*>(sink.get()))
+            out.dropped = async->DroppedCount();
+        return out;
+    }
+
+    void PrintProducer(const Settings& s, const char* sink, int args,
+                       std::size_t payload, const ProducerResult& r)
+    {
+        std::printf("{\"case\":\"producer\",\"sink\":\"%s\",\"threads\":%d,"
+                    "\"records\":%d,\"args\":%d,\"payload_bytes\":%zu,"
+                    "\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,"
+                    "\"max_ns\":%llu,\"records_per_sec\":%.0f,"
+                    "\"allocs_per_record\":%.3f,\"dropped\":%llu}\n",
+                    sink, s.threads, s.records, args, payload,
+                    static_cast<unsigned long long>(r.latency.p50),
+                    static_cast<unsigned long long>(r.latency.p99),
+                    static_cast<unsigned long long>(r.latency.p999),
+                    static_cast<unsigned long long>(r.latency.max),
+                    r.recordsPerSec, r.allocationsPerCall,
+                    static_cast<unsigned long long>(r.dropped));
+        std::fprintf(stderr,
+                     "producer %-10s args=%d payload=%-5zu p50=%6llu "
+                     "p99=%7llu p999=%8llu ns  %10.0f rec/s  %.2f alloc/rec\n",
+                     sink, args, payload,
+                     static_cast<unsigned long long>(r.latency.p50),
+                     static_cast<unsigned long long>(r.latency.p99),
+                     static_cast<unsigned long long>(r.latency.p999),
+                     r.recordsPerSec, r.allocationsPerCall);
+    }
+
+    void ProducerSuite(const Settings& s)
+    {
+        const std::pair<int, Call> argCases[] = {
+            {0, LogArgs<0>}, {1, LogArgs<1>}, {2, LogArgs<2>},
+            {4, LogArgs<4>}, {8, LogArgs<8>},
+        };
+        // Crosses the 256-byte inline message buffer.
+        const std::size_t payloads[] = {16, 64, 240, 1024, 4096};
+
+        for (const SinkCase& sink : ProducerSinks())
+        {
+            for (const auto& [args, call] : argCases)
+            {
+                const auto r = RunProducers(s, sink.make(), call);
+                PrintProducer(s, sink.name, args, 0, r);
+            }
+            for (const std::size_t payload : payloads)
+            {
+                const std::string text(payload, 'x');
+                const auto        r = RunProducers(
+                    s, sink.make(), [&](BenchLogger& logger, int) {
+                        logger.LogInformation("{}", text);
+                    });
+                PrintProducer(s, sink.name, 1, payload, r);
+            }
+        }
+    }
+
+    // Enqueue-to-write latency. When @p perSecond is zero, producers
+    // log as fast as they can and the latency includes queueing.
+    void EndToEnd(const Settings& s, double perSecond)
+    {
+        auto options      = skr::MakeArc<skr::LoggerOptions>();
+        options->logLevel = skr::LogLevel::Information;
+        auto latency      = skr::MakeArc<LatencySink>();
+        auto async        = skr::MakeArc<skr::AsyncSink>(latency, 8192);
+        options->AddSink(async);
+        BenchLogger logger(options);
+
+        const auto gap =
+            perSecond > 0
+                ? std::chrono::nanoseconds(static_cast<long long>(
+                      1e9 * s.threads / perSecond))
+                : std::chrono::nanoseconds(0);
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < s.threads; ++t)
+        {
+            producers.emplace_back([&] {
+                auto next = SteadyClock::now();
+                for (int i = 0; i < s.records; ++i)
+                {
+                    if (gap.count() > 0)
+                    {
+                        next += gap;
+                        while (SteadyClock::now() < next)
+                        {
+                        }
+                    }
+                    logger.LogInformation("order {} accepted", i);
+                }
+            });
         }
+        for (auto& p : producers)
+            p.join();
+        async->Flush();
 
-        const auto t0 = std::chrono::steady_clock::now();
-        go.store(true, std::memory_order_release);
+        auto       samples = latency->Take();
+        const auto written = samples.size();
+        const auto p       = Summarize(samples);
+        const auto dropped = async->DroppedCount();
 
-        for (auto& th : ts)
-            th.join();
+        std::printf("{\"case\":\"e2e\",\"sink\":\"async_latency\","
+                    "\"threads\":%d,\"records\":%d,\"target_per_sec\":%.0f,"
+                    "\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,"
+                    "\"max_ns\":%llu,\"written\":%zu,\"dropped\":%llu}\n",
+                    s.threads, s.records, perSecond,
+                    static_cast<unsigned long long>(p.p50),
+                    static_cast<unsigned long long>(p.p99),
+                    static_cast<unsigned long long>(p.p999),
+                    static_cast<unsigned long long>(p.max), written,
+                    static_cast<unsigned long long>(dropped));
+        std::fprintf(stderr,
+                     "e2e      target=%-9.0f p50=%6llu p99=%7llu "
+                     "p999=%8llu ns  dropped=%llu\n",
+                     perSecond, static_cast<unsigned long long>(p.p50),
+                     static_cast<unsigned long long>(p.p99),
+                     static_cast<unsigned long long>(p.p999),
+                     static_cast<unsigned long long>(dropped));
+    }
 
-        // For the AsyncSink case, Flush() drains the queue so we measure
-        // the steady-state producer rate fairly.
-        options->Sinks().front()->Flush();
+    // Producers outrun an inner sink that needs @c kCost per record.
+    void Overload(const Settings& s)
+    {
+        constexpr auto        kCost     = std::chrono::microseconds(2);
+        constexpr std::size_t kCapacity = 1024;
+        const int             threads   = std::max(2, s.threads);
 
-        const auto t1 = std::chrono::steady_clock::now();
-        const double seconds =
-            std::chrono::duration<double>(t1 - t0).count();
+        auto options      = skr::MakeArc<skr::LoggerOptions>();
+        options->logLevel = skr::LogLevel::Information;
+        auto async        = skr::MakeArc<skr::AsyncSink>(
+            skr::MakeArc<SlowSink>(kCost), kCapacity);
+        options->AddSink(async);
+        BenchLogger logger(options);
 
-        // Probe the drop counter if the sink exposes one.
-        std::uint64_t dropped = 0;
-        if (auto* async = dynamic_cast<SKIRNIR_NAMESPACE::AsyncSink*>(
-                options->Sinks().front().get()))
+        const auto               start = SteadyClock::now();
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t)
         {
-            dropped = async->DroppedCount();
+            producers.emplace_back([&] {
+                for (int i = 0; i < s.records; ++i)
+                    logger.LogInformation("order {} accepted", i);
+            });
         }
+        for (auto& p : producers)
+            p.join();
+        const double seconds =
+            std::chrono::duration<double>(SteadyClock::now() - start).count();
+        async->Flush();
 
-        return {total.load(), seconds, dropped};
+        const double submitted = static_cast<double>(s.records) * threads;
+        const auto   dropped   = async->DroppedCount();
+        std::printf("{\"case\":\"overload\",\"sink\":\"async_slow\","
+                    "\"threads\":%d,\"records\":%d,\"queue_capacity\":%zu,"
+                    "\"sink_cost_ns\":%lld,\"submitted_per_sec\":%.0f,"
+                    "\"dropped\":%llu,\"drop_rate\":%.4f}\n",
+                    threads, s.records, kCapacity,
+                    static_cast<long long>(
+                        std::chrono::nanoseconds(kCost).count()),
+                    submitted / seconds,
+                    static_cast<unsigned long long>(dropped),
+                    static_cast<double>(dropped) / submitted);
+        std::fprintf(stderr, "overload threads=%d dropped=%llu (%.1f%%)\n",
+                     threads, static_cast<unsigned long long>(dropped),
+                     100.0 * static_cast<double>(dropped) / submitted);
     }
 } // namespace
 
-int main()
+int main(int argc, char** argv)
 {
-    constexpr int kThreads    = 14;
-    constexpr int kPerThread  = 200'000;
-
-    std::printf("LoggingBench: %d threads x %d records each\n",
-                kThreads, kPerThread);
-    std::printf("-----------------------------------------------\n");
-
-    {
-        auto r = Run(
-            [] {
-                return SKIRNIR_NAMESPACE::MakeArc<SKIRNIR_NAMESPACE::ConsoleSink>();
-            },
-            kThreads, kPerThread);
-        const double rate = static_cast<double>(r.records) / r.seconds;
-        std::printf("[A] ConsoleSink (sync)         : %10.0f rec/s   "
-                    "(%.2fs, dropped=%llu)\n",
-                    rate, r.seconds,
-                    static_cast<unsigned long long>(r.dropped));
-    }
+    Settings s;
+    for (int i = 1; i < argc; ++i)
     {
-        auto r = Run(
-            [] {
-                return SKIRNIR_NAMESPACE::MakeArc<SKIRNIR_NAMESPACE::AsyncSink>(
-                    SKIRNIR_NAMESPACE::MakeArc<SKIRNIR_NAMESPACE::ConsoleSink>(),
-                    8192);
-            },
-            kThreads, kPerThread);
-        const double rate = static_cast<double>(r.records) / r.seconds;
-        std::printf("[B] AsyncSink(ConsoleSink)     : %10.0f rec/s   "
-                    "(%.2fs, dropped=%llu)\n",
-                    rate, r.seconds,
-                    static_cast<unsigned long long>(r.dropped));
+        if (std::strcmp(argv[i], "--quick") == 0)
+            s.records = 20'000;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            s.threads = std::max(1, std::atoi(argv[++i]));
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--quick] [--threads N]\n",
+                         argv[0]);
+            return 2;
+        }
     }
+
+    std::fprintf(stderr,
+                 "LoggingBench: %d thread(s) x %d records, files in %s\n",
+                 s.threads, s.records, BenchDirectory().string().c_str());
+
+    ProducerSuite(s);
+    EndToEnd(s, 100'000);
+    EndToEnd(s, 0);
+    Overload(s);
+
+    for (const char* name : {"file", "json"})
     {
-        auto r = Run(
-            [] { return SKIRNIR_NAMESPACE::MakeArc<SKIRNIR_NAMESPACE::NullSink>(); },
-            kThreads, kPerThread);
-        const double rate = static_cast<double>(r.records) / r.seconds;
-        std::printf("[C] NullSink (no I/O)          : %10.0f rec/s   "
-                    "(%.2fs, dropped=%llu)\n",
-                    rate, r.seconds,
-                    static_cast<unsigned long long>(r.dropped));
+        std::error_code ec;
+        std::filesystem::remove(BenchFile(name), ec);
     }
     return 0;
 }
@@ -0,0 +1,91 @@
+// Timestamp formatting microbenchmark.
+//
+// Compares the per-record cost of the timestamp text written by the text
+// sinks:
+//   A. std::format("{:%F %T}")       (what the sinks used to call)
+//   B. TimestampFormatter, Default   (cached date/seconds prefix)
+//   C. TimestampFormatter, Iso8601 with millisecond precision
+//   D. TimestampFormatter, Epoch
+//
+// Timestamps advance by kStepNs per iteration, so a realistic share of
+// calls lands in a new second (and occasionally a new day). A checksum
+// over the produced characters keeps the work observable.
+
+#include "Skirnir/Logging/Format.hpp"
+#include "Skirnir/Logging/TimestampFormat.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using Clock = std::chrono::system_clock;
+
+    constexpr int           kIterations = 5'000'000;
+    constexpr std::int64_t  kStepNs     = 1'700; // ~590k records/s
+
+    Clock::time_point StartTime()
+    {
+        // 2025-03-12 23:59:50 UTC: the run crosses midnight.
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::seconds(1'741'823'990)));
+    }
+
+    template <typename Fn>
+    void Run(const char* label, Fn&& format)
+    {
+        auto          tp       = StartTime();
+        std::uint64_t checksum = 0;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            const std::string_view text = format(tp);
+            checksum += static_cast<unsigned char>(text.back()) + text.size();
+            tp += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::nanoseconds(kStepNs));
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(t1 - t0).count();
+        std::printf("%-36s: %8.1f ns/op  %12.0f op/s  (checksum %llu)\n",
+                    label, seconds * 1e9 / kIterations, kIterations / seconds,
+                    static_cast<unsigned long long>(checksum));
+    }
+} // namespace
+
+int main()
+{
+    std::printf("TimestampBench: %d timestamps, %lld ns apart\n", kIterations,
+                static_cast<long long>(kStepNs));
+    std::printf("-----------------------------------------------\n");
+
+    {
+        std::string buffer;
+        Run("[A] std::format {:%F %T}", [&](Clock::time_point tp) {
+            buffer = SKIRNIR_NAMESPACE::detail::Format("{:%F %T}", tp);
+            return std::string_view(buffer);
+        });
+    }
+    {
+        SKIRNIR_NAMESPACE::TimestampFormatter formatter;
+        Run("[B] TimestampFormatter Default",
+            [&](Clock::time_point tp) { return formatter.Format(tp); });
+    }
+    {
+        SKIRNIR_NAMESPACE::TimestampFormatter formatter(
+            {SKIRNIR_NAMESPACE::TimestampStyle::Iso8601, 3});
+        Run("[C] TimestampFormatter Iso8601 (ms)",
+            [&](Clock::time_point tp) { return formatter.Format(tp); });
+    }
+    {
+        SKIRNIR_NAMESPACE::TimestampFormatter formatter(
+            {SKIRNIR_NAMESPACE::TimestampStyle::Epoch, 6});
+        Run("[D] TimestampFormatter Epoch (us)",
+            [&](Clock::time_point tp) { return formatter.Format(tp); });
+    }
+    return 0;
+}
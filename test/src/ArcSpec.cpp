@@ -222,6 +222,52 @@ TEST(ArcSpec, ArcCopyPreservesLifetime)
     EXPECT_EQ(storedRaw->id, 11);
 }
 
+TEST(ArcSpec, AtomicArcLoadSharesOwnership)
+{
+    using namespace arc_test;
+    Counter::Instances().store(0);
+    {
+        skr::AtomicArc<Widget> slot(skr::MakeArc<Widget>(1));
+        auto                   a = slot.load();
+        EXPECT_EQ(a->id, 1);
+        EXPECT_EQ(a.use_count(), 2u);
+
+        auto previous = slot.exchange(skr::MakeArc<Widget>(2));
+        EXPECT_EQ(previous.get(), a.get());
+        EXPECT_EQ(slot.load()->id, 2);
+        EXPECT_EQ(a->id, 1);
+    }
+    EXPECT_EQ(Counter::Instances().load(), 0);
+}
+
+TEST(ArcSpec, AtomicArcConcurrentLoadAndStore)
+{
+    using namespace arc_test;
+    Counter::Instances().store(0);
+    {
+        skr::AtomicArc<Widget>   slot(skr::MakeArc<Widget>(0));
+        std::atomic<bool>        done {false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&] {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    auto local = slot.load();
+                    EXPECT_GE(local->id, 0);
+                }
+            });
+        }
+        for (int i = 1; i <= 10000; ++i)
+            slot.store(skr::MakeArc<Widget>(i));
+        done.store(true);
+        for (auto& reader : readers)
+            reader.join();
+        EXPECT_EQ(slot.load()->id, 10000);
+    }
+    EXPECT_EQ(Counter::Instances().load(), 0);
+}
+
 TEST(ArcSpec, DiSingleInjectArcDependency)
 {
     using namespace arc_test;
@@ -2,6 +2,12 @@
 
 #include <Skirnir/Configuration.hpp>
 
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
 namespace bind_test
 {
     struct DatabaseOptions
@@ -22,6 +28,34 @@ namespace bind_test
     {
         std::vector<std::string> tags;
     };
+
+    struct Endpoint
+    {
+        std::string host;
+        int         port = 80;
+    };
+
+    struct ClusterOptions
+    {
+        std::vector<Endpoint>           nodes;
+        std::map<std::string, Endpoint> named;
+        std::map<std::string, int>      weights;
+        std::optional<int>              retries;
+        std::optional<Endpoint>         fallback;
+        std::optional<std::string>      comment = "preset";
+        std::vector<std::vector<int>>   matrix;
+        Endpoint                        primary {"primary", 5432};
+        float                           ratio  = 0.0f;
+        std::uint16_t                   shards = 0;
+    };
+
+    struct Wide
+    {
+        int a0 = 0, a1 = 0, a2 = 0, a3 = 0, a4 = 0, a5 = 0, a6 = 0, a7 = 0;
+        int b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0, b7 = 0;
+        int c0 = 0, c1 = 0, c2 = 0, c3 = 0, c4 = 0, c5 = 0, c6 = 0, c7 = 0;
+        int d0 = 0, d1 = 0, d2 = 0, d3 = 0, d4 = 0, d5 = 0, d6 = 0, d7 = 0;
+    };
 } // namespace bind_test
 
 TEST(BindSpec, BindsPrimitives)
@@ -107,3 +141,103 @@ TEST(BindSpec, BindsArray)
     EXPECT_EQ(opts->tags[0], "alpha");
     EXPECT_EQ(opts->tags[2], "gamma");
 }
+
+TEST(BindSpec, BindsContainersOfStructs)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({
+                          "nodes": [{"host": "a", "port": 1}, {"host": "b"}],
+                          "named": {"east": {"host": "e", "port": 2}},
+                          "weights": {"x": 1, "y": 2},
+                          "matrix": [[1, 2], [3]],
+                          "ratio": 0.5,
+                          "shards": 12
+                      })")
+                      .Build();
+
+    auto opts = config->Bind<bind_test::ClusterOptions>();
+    ASSERT_EQ(opts->nodes.size(), 2u);
+    EXPECT_EQ(opts->nodes[0].host, "a");
+    EXPECT_EQ(opts->nodes[0].port, 1);
+    EXPECT_EQ(opts->nodes[1].host, "b");
+    EXPECT_EQ(opts->nodes[1].port, 80);
+    ASSERT_EQ(opts->named.count("east"), 1u);
+    EXPECT_EQ(opts->named.at("east").port, 2);
+    EXPECT_EQ(opts->weights, (std::map<std::string, int> {{"x", 1}, {"y", 2}}));
+    EXPECT_EQ(opts->matrix, (std::vector<std::vector<int>> {{1, 2}, {3}}));
+    EXPECT_FLOAT_EQ(opts->ratio, 0.5f);
+    EXPECT_EQ(opts->shards, 12);
+}
+
+TEST(BindSpec, BindsOptionalFields)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({
+                          "retries": 3,
+                          "fallback": {"host": "f"},
+                          "comment": null
+                      })")
+                      .Build();
+
+    auto opts = config->Bind<bind_test::ClusterOptions>();
+    EXPECT_EQ(opts->retries, std::optional<int>(3));
+    ASSERT_TRUE(opts->fallback.has_value());
+    EXPECT_EQ(opts->fallback->host, "f");
+    EXPECT_EQ(opts->fallback->port, 80);
+    EXPECT_FALSE(opts->comment.has_value());
+
+    auto empty = skr::ConfigurationBuilder().AddJsonString("{}").Build();
+    auto defaults = empty->Bind<bind_test::ClusterOptions>();
+    EXPECT_FALSE(defaults->retries.has_value());
+    EXPECT_EQ(defaults->comment, std::optional<std::string>("preset"));
+}
+
+TEST(BindSpec, NestedStructKeepsUnmentionedFields)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({"primary": {"port": 6543}})")
+                      .Build();
+
+    auto opts = config->Bind<bind_test::ClusterOptions>();
+    EXPECT_EQ(opts->primary.host, "primary");
+    EXPECT_EQ(opts->primary.port, 6543);
+}
+
+TEST(BindSpec, MismatchedContainerLeavesFieldUntouched)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({
+                          "nodes": [{"host": "a"}, 7],
+                          "weights": {"x": 1, "y": "two"},
+                          "retries": "many"
+                      })")
+                      .Build();
+
+    auto opts = config->Bind<bind_test::ClusterOptions>();
+    EXPECT_TRUE(opts->nodes.empty());
+    EXPECT_TRUE(opts->weights.empty());
+    EXPECT_FALSE(opts->retries.has_value());
+}
+
+TEST(BindSpec, DispatchesEveryFieldOfAWideStruct)
+{
+    std::string json = "{\"unknown\": 1";
+    int         value = 1;
+    for (char group : {'a', 'b', 'c', 'd'})
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            json += ",\"" + std::string(1, group) + std::to_string(i) +
+                    "\": " + std::to_string(value++);
+        }
+    }
+    json += ", \"a0\": 99}";
+    auto config = skr::ConfigurationBuilder().AddJsonString(json).Build();
+
+    auto opts = config->Bind<bind_test::Wide>();
+    EXPECT_EQ(opts->a0, 1); // a repeated key keeps its first value
+    EXPECT_EQ(opts->a7, 8);
+    EXPECT_EQ(opts->b0, 9);
+    EXPECT_EQ(opts->c3, 20);
+    EXPECT_EQ(opts->d7, 32);
+}
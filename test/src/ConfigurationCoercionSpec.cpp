@@ -4,6 +4,7 @@
 #include <Skirnir/Configuration.hpp>
 
 #include <clocale>
+#include <cstdint>
 #include <cstdlib>
 #include <locale>
 #include <optional>
@@ -95,9 +96,9 @@ TEST(ConfigurationCoercionSpec, InMemorySource_IntegerOverflowIsCoercedToDouble)
                       .AddInMemory({{"big", "99999999999999999999"}})
                       .Build();
 
-    // std::stoll throws out_of_range, std::stod accepts it as a finite
-    // double in the ~1e20 range with pos == v.size(), so the leaf is
-    // stored as a JSON number (double), not a string. Read it back as a
+    // Too large for int64, but a finite double in the ~1e20 range that
+    // consumes the whole value, so the leaf is stored as a JSON number
+    // (double), not a string. Read it back as a
     // double to confirm.
     double d = config->GetDouble("big", 0.0);
     EXPECT_GT(d, 1e19);
@@ -325,3 +326,52 @@ TEST(ConfigurationCoercionSpec, EnvironmentVariables_OverflowingIntegerMatchesIn
     EXPECT_EQ(envCfg->GetString("SKR_TEST_BIG"),
               memCfg->GetString("SKR_TEST_BIG"));
 }
+
+TEST(ConfigurationCoercionSpec, InMemorySource_NumbersFollowStrtollAndStrtodSyntax)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddInMemory({{"plus", "+5"},
+                                    {"space", " 42"},
+                                    {"min", "-9223372036854775808"},
+                                    {"doubleSign", "--5"},
+                                    {"mixedSign", "+-5"},
+                                    {"tiny", "1e-999"},
+                                    {"fraction", "-.25"}})
+                      .Build();
+
+    EXPECT_EQ(config->GetInt("plus"), 5);
+    EXPECT_EQ(config->GetInt("space"), 42);
+    EXPECT_EQ(config->GetInt("min"), INT64_MIN);
+    EXPECT_EQ(config->GetString("doubleSign"), "--5");
+    EXPECT_EQ(config->GetString("mixedSign"), "+-5");
+    // Underflow rounds to zero the way strtod does, rather than
+    // overflowing to infinity.
+    EXPECT_DOUBLE_EQ(config->GetDouble("tiny", -1.0), 0.0);
+    EXPECT_DOUBLE_EQ(config->GetDouble("fraction"), -0.25);
+}
+
+TEST(ConfigurationCoercionSpec, EnvironmentVariables_ConflictingNamesResolveLikeInMemory)
+{
+    ScopedEnv leaf("SKR_TEST_CONFLICT_A", "1");
+    ScopedEnv deep("SKR_TEST_CONFLICT_A__B", "2");
+    ScopedEnv triple("SKR_TEST_CONFLICT_X___Y", "3");
+    ScopedEnv trailing("SKR_TEST_CONFLICT_E__", "4");
+
+    auto envCfg = skr::ConfigurationBuilder()
+                      .AddEnvironmentVariables("SKR_TEST_CONFLICT_")
+                      .Build();
+    auto memCfg = skr::ConfigurationBuilder()
+                      .AddInMemory({{"A", "1"},
+                                    {"A.B", "2"},
+                                    {"X._Y", "3"},
+                                    {"E.", "4"}})
+                      .Build();
+
+    for (const char* key : {"A", "A.B", "X", "X._Y", "E"})
+    {
+        EXPECT_EQ(envCfg->HasKey(key), memCfg->HasKey(key)) << key;
+        EXPECT_EQ(envCfg->GetValue(key), memCfg->GetValue(key)) << key;
+    }
+    EXPECT_EQ(envCfg->GetInt("A.B"), 2);
+    EXPECT_EQ(envCfg->GetInt("X._Y"), 3);
+}
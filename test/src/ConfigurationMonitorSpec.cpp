@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+
+#include <Skirnir/Skirnir.hpp>
+
+#include "TestPaths.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace monitor_test
+{
+    struct ServerOptions
+    {
+        std::string host;
+        int         port = 0;
+    };
+
+    using skirnir_test::TempFile;
+
+    skr::ConfigurationMonitorOptions Manual()
+    {
+        skr::ConfigurationMonitorOptions options;
+        options.watchFiles = false;
+        return options;
+    }
+} // namespace monitor_test
+
+TEST(ConfigurationMonitorSpec, Reload_PublishesChangedFile)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"server": {"host": "a", "port": 1}})");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .AddJsonString(R"({"server": {"host": "b"}})")
+                       .BuildMonitor(Manual());
+
+    auto before = monitor->Current();
+    EXPECT_EQ(before->GetInt("server.port"), 1);
+    EXPECT_EQ(before->GetString("server.host"), "b");
+
+    file.Replace(R"({"server": {"host": "a", "port": 2}})");
+    const auto changed = monitor->Reload();
+
+    EXPECT_EQ(changed, (std::vector<std::string> {"server.port"}));
+    EXPECT_EQ(monitor->Current()->GetInt("server.port"), 2);
+    EXPECT_EQ(monitor->Current()->GetString("server.host"), "b");
+    // Earlier snapshots are immutable.
+    EXPECT_EQ(before->GetInt("server.port"), 1);
+}
+
+TEST(ConfigurationMonitorSpec, Reload_UnchangedFileKeepsSnapshot)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"a": 1})");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(Manual());
+
+    auto before = monitor->Current();
+    EXPECT_TRUE(monitor->Reload().empty());
+    // Reformatting without changing a value is not a change either.
+    file.Replace("{\n  \"a\": 1\n}\n");
+    EXPECT_TRUE(monitor->Reload().empty());
+    EXPECT_EQ(monitor->Current().get(), before.get());
+}
+
+TEST(ConfigurationMonitorSpec, Reload_ReportsAddedRemovedAndRetypedKeys)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"keep": 1, "gone": 2, "obj": {"x": 1}, "arr": [1]})");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(Manual());
+
+    file.Replace(R"({"keep": 1, "obj": 5, "arr": [1, 2], "new": {"y": 1}})");
+    const auto changed = monitor->Reload();
+
+    EXPECT_EQ(changed,
+              (std::vector<std::string> {"gone", "obj", "arr", "new"}));
+}
+
+TEST(ConfigurationMonitorSpec, Reload_InvalidFileKeepsSnapshot)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"a": 1})");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(Manual());
+    auto before = monitor->Current();
+
+    file.Replace(R"({"a": )");
+    EXPECT_THROW(monitor->Reload(), std::runtime_error);
+    EXPECT_EQ(monitor->Current().get(), before.get());
+
+    file.Replace(R"({"a": 3})");
+    EXPECT_EQ(monitor->Reload(), (std::vector<std::string> {"a"}));
+    EXPECT_EQ(monitor->Current()->GetInt("a"), 3);
+}
+
+TEST(ConfigurationMonitorSpec, Reload_PublishesOtherSourcesWhenOneFails)
+{
+    using namespace monitor_test;
+    TempFile good(R"({"a": 1})", "good.json");
+    TempFile bad(R"({"b": 1})", "bad.json");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(good.Path())
+                       .AddJsonFile(bad.Path())
+                       .BuildMonitor(Manual());
+
+    good.Replace(R"({"a": 2})");
+    bad.Replace(R"({"b": )");
+    EXPECT_THROW(monitor->Reload(), std::runtime_error);
+    // The good file's change is not held back by the bad one, and is
+    // not lost: the good source will not report it a second time.
+    EXPECT_EQ(monitor->Current()->GetInt("a"), 2);
+    EXPECT_EQ(monitor->Current()->GetInt("b"), 1);
+
+    bad.Replace(R"({"b": 3})");
+    EXPECT_EQ(monitor->Reload(), (std::vector<std::string> {"b"}));
+    EXPECT_EQ(monitor->Current()->GetInt("a"), 2);
+}
+
+TEST(ConfigurationMonitorSpec, Subscribe_OnlyMatchingKeysNotify)
+{
+    using namespace monitor_test;
+    TempFile file(
+        R"({"logging": {"logLevel": {"default": "Information"}},
+            "server": {"port": 1}})");
+    auto monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(Manual());
+
+    int logging = 0, level = 0, server = 0, all = 0;
+    monitor->Subscribe("logging", [&](const auto&) { ++logging; });
+    monitor->Subscribe("logging.logLevel.default", [&](const auto&) {
+        ++level;
+    });
+    const auto token =
+        monitor->Subscribe("server", [&](const auto&) { ++server; });
+    monitor->Subscribe("", [&](const auto&) { ++all; });
+
+    file.Replace(R"({"logging": {"logLevel": {"default": "Debug"}},
+                   "server": {"port": 1}})");
+    monitor->Reload();
+    EXPECT_EQ(logging, 1);
+    EXPECT_EQ(level, 1);
+    EXPECT_EQ(server, 0);
+    EXPECT_EQ(all, 1);
+
+    // Replacing a parent wholesale concerns listeners below it.
+    file.Replace(R"({"logging": null, "server": {"port": 2}})");
+    monitor->Unsubscribe(token);
+    monitor->Reload();
+    EXPECT_EQ(logging, 2);
+    EXPECT_EQ(level, 2);
+    EXPECT_EQ(server, 0);
+    EXPECT_EQ(all, 2);
+}
+
+TEST(ConfigurationMonitorSpec, Watcher_ReloadsAfterFileChanges)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"server": {"port": 1}})");
+
+    skr::ConfigurationMonitorOptions options;
+    options.debounce = std::chrono::milliseconds(20);
+    auto monitor     = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(options);
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<int>        ports;
+    monitor->Subscribe("server.port", [&](const auto& config) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ports.push_back(static_cast<int>(config->GetInt("server.port")));
+        cv.notify_all();
+    });
+
+    file.Replace(R"({"server": {"port": 2}})");
+    file.Replace(R"({"server": {"port": 3}})");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] {
+        return !ports.empty() && ports.back() == 3;
+    }));
+    EXPECT_EQ(monitor->Current()->GetInt("server.port"), 3);
+}
+
+TEST(ConfigurationMonitorSpec, Watcher_IgnoresBusySiblingFile)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"server": {"port": 1}})");
+
+    skr::ConfigurationMonitorOptions options;
+    options.debounce = std::chrono::milliseconds(50);
+    auto monitor     = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(options);
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    int                     port = 1;
+    monitor->Subscribe("server.port", [&](const auto& config) {
+        std::lock_guard<std::mutex> lock(mutex);
+        port = static_cast<int>(config->GetInt("server.port"));
+        cv.notify_all();
+    });
+
+    // A log file next to the configuration, written far more often than
+    // the debounce interval, must not hold back the reload.
+    const auto   sibling = file.Path().parent_path() / "app.log";
+    std::jthread writer([&](std::stop_token stop) {
+        while (!stop.stop_requested())
+        {
+            std::ofstream(sibling, std::ios::app) << "line\n";
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    file.Replace(R"({"server": {"port": 2}})");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+                            [&] { return port == 2; }));
+}
+
+#if defined(__linux__)
+namespace monitor_test
+{
+    // Claims to be backed by a file in a directory that does not exist.
+    class UnwatchableSource final : public skr::IConfigurationSource
+    {
+      public:
+        simdjson::dom::element Load() override
+        {
+            if (!mLoaded)
+            {
+                mElement = mParser.parse(std::string("{}")).value();
+                mLoaded  = true;
+            }
+            return mElement;
+        }
+
+        std::filesystem::path WatchedPath() const override
+        {
+            return "/nonexistent/skirnir_monitor_test/appsettings.json";
+        }
+
+      private:
+        simdjson::dom::parser  mParser;
+        simdjson::dom::element mElement;
+        bool                   mLoaded = false;
+    };
+} // namespace monitor_test
+
+TEST(ConfigurationMonitorSpec, Watcher_RejectsUnwatchableDirectory)
+{
+    using namespace monitor_test;
+    std::vector<skr::Arc<skr::IConfigurationSource>> sources {
+        skr::MakeArc<UnwatchableSource>()};
+    EXPECT_THROW(skr::ConfigurationMonitor monitor(sources),
+                 std::runtime_error);
+    // Nothing is watched without watchFiles.
+    EXPECT_NO_THROW(skr::ConfigurationMonitor monitor(sources, Manual()));
+}
+#endif
+
+TEST(ConfigurationMonitorSpec, Options_FollowRegisteredMonitor)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"server": {"host": "a", "port": 1}})");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(Manual());
+
+    skr::ServiceCollection services;
+    services.AddSingleton(monitor->Current());
+    services.AddSingleton(monitor);
+    services.AddOptions<ServerOptions>("server");
+    auto provider = services.CreateServiceProvider();
+    auto options  = provider->GetService<skr::Options<ServerOptions>>();
+
+    auto before = options->Value();
+    file.Replace(R"({"server": {"host": "a", "port": 2}, "other": 1})");
+    monitor->Reload();
+    EXPECT_EQ(options->Value()->port, 2);
+
+    // Changes elsewhere leave the snapshot alone.
+    auto current = options->Value();
+    file.Replace(R"({"server": {"host": "a", "port": 2}, "other": 2})");
+    monitor->Reload();
+    EXPECT_EQ(options->Value().get(), current.get());
+    EXPECT_EQ(before->port, 1);
+}
+
+TEST(ConfigurationMonitorSpec, Logging_FollowsRateLimitReload)
+{
+    using namespace monitor_test;
+    TempFile file(R"({"logging": {"logLevel": {"default": "Information"},
+                                  "rateLimit": {"mode": "off"}}})");
+    auto     monitor = skr::ConfigurationBuilder()
+                       .AddJsonFile(file.Path())
+                       .BuildMonitor(Manual());
+
+    skr::ServiceCollection services;
+    services.AddSingleton(monitor->Current());
+    services.AddSingleton(monitor);
+    skr::LoggingExtension logging;
+    logging.ConfigureFrom();
+    logging.ConfigureServices(services);
+    auto provider = services.CreateServiceProvider();
+    logging.UseServices(*provider);
+    auto options = provider->GetService<skr::LoggerOptions>();
+    EXPECT_EQ(options->RateLimit().mode, skr::LogRateLimitMode::Off);
+
+    // Only the rate limit changes; the levels section stays the same.
+    file.Replace(R"({"logging": {"logLevel": {"default": "Information"},
+                                 "rateLimit": {"mode": "tokenBucket",
+                                               "burst": 3}}})");
+    monitor->Reload();
+    EXPECT_EQ(options->RateLimit().mode, skr::LogRateLimitMode::TokenBucket);
+    EXPECT_EQ(options->RateLimit().burst, 3u);
+}
@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+
+#include <Skirnir/Skirnir.hpp>
+
+#include "TestPaths.hpp"
+
+// Internal header: forged snapshots need the checksum's hash.
+#include "../../src/Configuration/Detail.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace snapshot_test
+{
+    namespace fs = std::filesystem;
+
+    using skirnir_test::TempDir;
+
+    constexpr const char* kSettings = R"({
+        "server": {"host": "example.org", "port": 8080, "tls": true,
+                   "ratio": 0.25, "big": 18446744073709551615,
+                   "neg": -42, "empty": "", "nothing": null},
+        "logging": {"sinks": ["console", "file"],
+                    "level": "Debug", "name": "café \"q\""}
+    })";
+
+    skr::Arc<skr::ConfigurationOptions> Build(const TempDir&     dir,
+                                              const std::string& overrides)
+    {
+        return skr::ConfigurationBuilder()
+            .AddJsonFile(dir.Path("appsettings.json"))
+            .AddJsonString(overrides)
+            .AddInMemory({{"server.region", "eu"}})
+            .WithSnapshotCache(dir.Path("cache/config.snapshot"))
+            .Build();
+    }
+
+    void ExpectSettings(const skr::ConfigurationOptions& config)
+    {
+        EXPECT_EQ(config.GetString("server.host"), "example.org");
+        EXPECT_EQ(config.GetInt("server.port"), 8080);
+        EXPECT_TRUE(config.GetBool("server.tls"));
+        EXPECT_DOUBLE_EQ(config.GetDouble("server.ratio"), 0.25);
+        EXPECT_EQ(config.GetValue("server.big"), "18446744073709551615");
+        EXPECT_EQ(config.GetInt("server.neg"), -42);
+        EXPECT_EQ(config.GetValue("server.empty"), "");
+        EXPECT_TRUE(config.HasKey("server.nothing"));
+        EXPECT_FALSE(config.GetValue("server.nothing").has_value());
+        EXPECT_EQ(config.GetString("server.region"), "eu");
+        EXPECT_EQ(config.GetArray("logging.sinks"),
+                  (std::vector<std::string> {"console", "file"}));
+        EXPECT_EQ(config.GetString("logging.name"), "café \"q\"");
+        EXPECT_FALSE(config.HasKey("server.missing"));
+    }
+} // namespace snapshot_test
+
+TEST(ConfigurationSnapshotSpec, SecondBuildUsesSnapshot)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+    dir.Write("appsettings.json", kSettings);
+
+    auto built = Build(dir, R"({"logging": {"level": "Trace"}})");
+    ASSERT_TRUE(fs::exists(dir.Path("cache/config.snapshot")));
+    const std::string written = dir.Read("cache/config.snapshot");
+    const auto        stamp =
+        fs::last_write_time(dir.Path("cache/config.snapshot"));
+
+    auto cached = Build(dir, R"({"logging": {"level": "Trace"}})");
+    ExpectSettings(*built);
+    ExpectSettings(*cached);
+    EXPECT_EQ(cached->GetString("logging.level"), "Trace");
+    // Served from the snapshot, not rebuilt and rewritten.
+    EXPECT_EQ(dir.Read("cache/config.snapshot"), written);
+    EXPECT_EQ(fs::last_write_time(dir.Path("cache/config.snapshot")), stamp);
+}
+
+TEST(ConfigurationSnapshotSpec, SectionsOutliveTheConfiguration)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+    dir.Write("appsettings.json", kSettings);
+    Build(dir, "{}");
+
+    auto config  = Build(dir, "{}");
+    auto section = config->GetSection("logging");
+    config       = nullptr;
+
+    EXPECT_EQ(section->GetString("level"), "Debug");
+    std::vector<std::string> keys;
+    section->ForEachMember("", [&](std::string_view key, auto) {
+        keys.emplace_back(key);
+    });
+    EXPECT_EQ(keys, (std::vector<std::string> {"sinks", "level", "name"}));
+}
+
+TEST(ConfigurationSnapshotSpec, ChangedSourcesInvalidateSnapshot)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+    dir.Write("appsettings.json", kSettings);
+    Build(dir, "{}");
+
+    // A different layer on top is a different configuration...
+    EXPECT_EQ(Build(dir, R"({"server": {"port": 1}})")->GetInt("server.port"),
+              1);
+
+    // ...and so is an edited file.
+    dir.Write("appsettings.json", R"({"server": {"port": 2}})");
+    auto config = Build(dir, "{}");
+    EXPECT_EQ(config->GetInt("server.port"), 2);
+    EXPECT_FALSE(config->HasKey("logging"));
+}
+
+TEST(ConfigurationSnapshotSpec, DamagedSnapshotIsRebuilt)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+    dir.Write("appsettings.json", kSettings);
+    Build(dir, "{}");
+
+    std::string damaged = dir.Read("cache/config.snapshot");
+    damaged[damaged.size() / 2] ^= 0x5a;
+    dir.Write("cache/config.snapshot", damaged);
+    ExpectSettings(*Build(dir, "{}"));
+    EXPECT_NE(dir.Read("cache/config.snapshot"), damaged);
+
+    dir.Write("cache/config.snapshot", "short");
+    ExpectSettings(*Build(dir, "{}"));
+}
+
+#ifndef _WIN32
+TEST(ConfigurationSnapshotSpec, SnapshotIsReadableByOwnerOnly)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+    dir.Write("appsettings.json", kSettings);
+    Build(dir, "{}");
+
+    const auto perms =
+        fs::status(dir.Path("cache/config.snapshot")).permissions();
+    EXPECT_EQ(perms & (fs::perms::group_all | fs::perms::others_all),
+              fs::perms::none);
+}
+#endif
+
+namespace snapshot_test
+{
+    // Offsets in the snapshot header: tape length in words, string
+    // buffer length in bytes, checksum; the tape follows the header.
+    constexpr std::size_t kTapeWordsAt   = 32;
+    constexpr std::size_t kStringBytesAt = 40;
+    constexpr std::size_t kChecksumAt    = 48;
+    constexpr std::size_t kHeaderBytes   = 56;
+
+    std::uint64_t Word(const std::string& bytes, std::size_t at)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes.data() + at, sizeof(word));
+        return word;
+    }
+
+    void SetWord(std::string& bytes, std::size_t at, std::uint64_t word)
+    {
+        std::memcpy(bytes.data() + at, &word, sizeof(word));
+    }
+
+    // Index of the first tape word of @p type.
+    std::size_t FindTapeWord(const std::string& snapshot, char type)
+    {
+        const std::uint64_t words = Word(snapshot, kTapeWordsAt);
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            if (static_cast<char>(Word(snapshot, kHeaderBytes + i * 8) >>
+                                  56) == type)
+                return i;
+        }
+        ADD_FAILURE() << "no tape word of type " << type;
+        return 0;
+    }
+
+    // Recomputes the checksum, as anyone who can write the file could.
+    void Reseal(std::string& snapshot)
+    {
+        const std::size_t tapeBytes = Word(snapshot, kTapeWordsAt) * 8;
+        const std::string_view tape(snapshot.data() + kHeaderBytes,
+                                    tapeBytes);
+        const std::string_view strings(
+            snapshot.data() + kHeaderBytes + tapeBytes,
+            Word(snapshot, kStringBytesAt));
+        SetWord(snapshot, kChecksumAt,
+                skr::detail::HashCombine(
+                    skr::detail::HashCombine(0, tape), strings));
+    }
+} // namespace snapshot_test
+
+TEST(ConfigurationSnapshotSpec, ForgedSnapshotIsRejected)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+    dir.Write("appsettings.json", kSettings);
+    Build(dir, "{}");
+    const std::string good = dir.Read("cache/config.snapshot");
+
+    const std::vector<std::function<void(std::string&)>> forgeries {
+        // A string offset past the string buffer.
+        [](std::string& s) {
+            const std::size_t at = kHeaderBytes + 8 * FindTapeWord(s, '"');
+            SetWord(s, at, (Word(s, at) & ~0x00ffffffffffffffull) |
+                               Word(s, kStringBytesAt));
+        },
+        // A string whose length runs past the string buffer.
+        [](std::string& s) {
+            const std::size_t at = kHeaderBytes + 8 * FindTapeWord(s, '"');
+            const std::size_t length =
+                kHeaderBytes + Word(s, kTapeWordsAt) * 8 +
+                (Word(s, at) & 0x00ffffffffffffffull);
+            const std::uint32_t huge = 0x7fffffff;
+            std::memcpy(s.data() + length, &huge, sizeof(huge));
+        },
+        // A container that jumps past the end of the tape.
+        [](std::string& s) {
+            const std::size_t at = kHeaderBytes + 8 * FindTapeWord(s, '[');
+            SetWord(s, at, (Word(s, at) & ~0xffffffffull) |
+                               (Word(s, kTapeWordsAt) + 16));
+        },
+        // An object key that is not a string.
+        [](std::string& s) {
+            const std::size_t at = kHeaderBytes + 8 * FindTapeWord(s, '"');
+            SetWord(s, at, std::uint64_t {'t'} << 56);
+        },
+    };
+    for (const auto& forge : forgeries)
+    {
+        std::string forged = good;
+        forge(forged);
+        Reseal(forged);
+        dir.Write("cache/config.snapshot", forged);
+        ExpectSettings(*Build(dir, "{}"));
+        EXPECT_NE(dir.Read("cache/config.snapshot"), forged);
+    }
+}
+
+namespace snapshot_test
+{
+    class OpaqueSource final : public skr::IConfigurationSource
+    {
+      public:
+        simdjson::dom::element Load() override
+        {
+            if (!mLoaded)
+            {
+                mElement = mParser.parse(std::string(R"({"x": 1})")).value();
+                mLoaded  = true;
+            }
+            return mElement;
+        }
+
+      private:
+        simdjson::dom::parser  mParser;
+        simdjson::dom::element mElement;
+        bool                   mLoaded = false;
+    };
+} // namespace snapshot_test
+
+TEST(ConfigurationSnapshotSpec, SourcesWithoutFingerprintBypassCache)
+{
+    using namespace snapshot_test;
+    TempDir dir;
+
+    auto config = skr::ConfigurationBuilder()
+                      .AddSource(skr::MakeArc<OpaqueSource>())
+                      .WithSnapshotCache(dir.Path("config.snapshot"))
+                      .Build();
+    EXPECT_EQ(config->GetInt("x"), 1);
+    EXPECT_FALSE(fs::exists(dir.Path("config.snapshot")));
+}
@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <string>
 #include <utility>
+#include <vector>
 
 TEST(ConfigurationSpec, LoadFromString_SimpleValue)
 {
@@ -96,6 +97,87 @@ TEST(ConfigurationSpec, ConfigurationBuilder_ChainingMergesObjects)
     EXPECT_EQ(config->GetString("logging.namespaces.MyApp"), "Debug");
 }
 
+TEST(ConfigurationSpec, ConfigurationBuilder_LaterValueReplacesWholesale)
+{
+    auto config =
+        skr::ConfigurationBuilder()
+            .AddJsonString(R"({"db": {"host": "a", "port": 1}, "tags": [1, 2]})")
+            .AddJsonString(R"({"db": "disabled", "tags": [3]})")
+            .AddJsonString(R"({"db": {"port": 2}})")
+            .Build();
+
+    // The scalar shadows the first object, so only the last one remains.
+    EXPECT_FALSE(config->HasKey("db.host"));
+    EXPECT_EQ(config->GetInt("db.port"), 2);
+    auto tags = config->GetArray("tags");
+    ASSERT_EQ(tags.size(), 1u);
+    EXPECT_EQ(tags[0], "3");
+}
+
+TEST(ConfigurationSpec, ConfigurationBuilder_MergeKeepsSourceValues)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({"z": 1, "a": {"x": "q\"uote"}})")
+                      .AddJsonString(R"({"a": {"y": 18446744073709551615},
+                                         "m": 0.1})")
+                      .Build();
+
+    std::vector<std::string> keys;
+    config->ForEachMember(
+        "", [&](std::string_view k, auto) { keys.emplace_back(k); });
+    EXPECT_EQ(keys, (std::vector<std::string> {"z", "a", "m"}));
+    EXPECT_EQ(config->GetString("a.x"), "q\"uote");
+    EXPECT_EQ(config->GetValue("a.y"),
+              std::optional<std::string>("18446744073709551615"));
+    EXPECT_DOUBLE_EQ(config->GetDouble("m"), 0.1);
+}
+
+TEST(ConfigurationSpec, ConfigurationBuilder_MergeKeepsTypesAndShape)
+{
+    auto config =
+        skr::ConfigurationBuilder()
+            .AddJsonString(R"({"n": {"ratio": 1.5, "empty": {}, "list": []}})")
+            .AddJsonString(R"({"n": {"ratio": 2.0, "deep": [[1, "two"], {}],
+                               "flag": false, "none": null,
+                               "text": "tab\tand \u00e9"}})")
+            .Build();
+
+    // The merged document is written straight from the sources: a double
+    // stays a double even without a fractional part.
+    auto ratio = config->GetSection("n")->Root()["ratio"];
+    ASSERT_EQ(ratio.error(), simdjson::SUCCESS);
+    EXPECT_TRUE(ratio.value().is_double());
+    EXPECT_DOUBLE_EQ(config->GetDouble("n.ratio"), 2.0);
+
+    EXPECT_EQ(config->GetValue("n.empty"), std::optional<std::string>("{}"));
+    EXPECT_EQ(config->GetValue("n.list"), std::optional<std::string>("[]"));
+    EXPECT_EQ(config->GetValue("n.deep"),
+              std::optional<std::string>(R"([[1,"two"],{}])"));
+    EXPECT_TRUE(config->HasKey("n.flag"));
+    EXPECT_FALSE(config->GetBool("n.flag", true));
+    EXPECT_TRUE(config->HasKey("n.none"));
+    EXPECT_EQ(config->GetValue("n.none"), std::nullopt);
+    EXPECT_EQ(config->GetString("n.text"), "tab\tand \xc3\xa9");
+
+    std::vector<std::string> keys;
+    config->ForEachMember(
+        "n", [&](std::string_view k, auto) { keys.emplace_back(k); });
+    EXPECT_EQ(keys, (std::vector<std::string> {"ratio", "empty", "list",
+                                               "deep", "flag", "none",
+                                               "text"}));
+}
+
+TEST(ConfigurationSpec, InMemorySource_LeafAndSectionAtSamePath)
+{
+    // Map order puts "a" before "a.b", so the section replaces the leaf.
+    auto config = skr::ConfigurationBuilder()
+                      .AddInMemory({{"a", "1"}, {"a.b", "2"}, {"c.d", "3"}})
+                      .Build();
+
+    EXPECT_EQ(config->GetInt("a.b"), 2);
+    EXPECT_EQ(config->GetInt("c.d"), 3);
+}
+
 TEST(ConfigurationSpec, TypedGetters)
 {
     auto config = skr::ConfigurationBuilder()
@@ -120,6 +202,46 @@ TEST(ConfigurationSpec, TypedGetters)
     EXPECT_EQ(tags[2], "c");
 }
 
+TEST(ConfigurationSpec, KeyLookup_ManyKeys)
+{
+    std::string json = "{";
+    for (int i = 0; i < 2000; ++i)
+    {
+        if (i > 0)
+            json += ',';
+        json += "\"s" + std::to_string(i) + "\":{\"v\":" + std::to_string(i) +
+                ",\"n\":{\"w\":\"x" + std::to_string(i) + "\"}}";
+    }
+    json += '}';
+    auto config = skr::ConfigurationBuilder().AddJsonString(json).Build();
+
+    for (int i = 0; i < 2000; i += 37)
+    {
+        auto s = "s" + std::to_string(i);
+        EXPECT_EQ(config->GetInt(s + ".v", -1), i);
+        EXPECT_EQ(config->GetString(s + ".n.w"), "x" + std::to_string(i));
+    }
+    EXPECT_FALSE(config->HasKey("s2000.v"));
+    EXPECT_FALSE(config->HasKey("s1.v.extra"));
+}
+
+TEST(ConfigurationSpec, KeyLookup_IrregularKeys)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({"a": {"": {"b": 1}, "c": 2},
+                                         "d.e": 3,
+                                         "f": [{"g": 4}]})")
+                      .Build();
+
+    // Dotted member names cannot be addressed; empty ones can via "..".
+    EXPECT_FALSE(config->HasKey("d.e"));
+    EXPECT_EQ(config->GetInt("a..b", -1), 1);
+    EXPECT_EQ(config->GetInt("a.c.", -1), 2);
+    EXPECT_FALSE(config->HasKey(".a"));
+    EXPECT_FALSE(config->HasKey("f.g"));
+    EXPECT_TRUE(config->HasKey(""));
+}
+
 TEST(ConfigurationSpec, GetSection)
 {
     auto config = skr::ConfigurationBuilder()
@@ -148,6 +270,31 @@ TEST(ConfigurationSpec, GetSection_OutlivesParent)
     EXPECT_EQ(section->GetInt("b"), 42);
 }
 
+TEST(ConfigurationSpec, GetSection_Nested)
+{
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({"a": {"b": {"c": {"d": 1}, "e": 2},
+                                               "": {"f": {"g": 3}}}})")
+                      .Build();
+
+    auto b = config->GetSection("a.b");
+    auto c = b->GetSection("c");
+    EXPECT_EQ(b->GetInt("e"), 2);
+    EXPECT_EQ(b->GetInt("c.d"), 1);
+    EXPECT_EQ(c->GetInt("d"), 1);
+    EXPECT_FALSE(c->HasKey("e"));
+    EXPECT_FALSE(b->HasKey("a"));
+
+    // Reached through an empty segment, so lookups walk the section.
+    auto f = config->GetSection("a..f");
+    EXPECT_EQ(f->GetInt("g"), 3);
+    EXPECT_FALSE(f->HasKey("d"));
+
+    auto root = config->GetSection("");
+    EXPECT_EQ(root->GetInt("a.b.e"), 2);
+    EXPECT_FALSE(config->GetSection("a.b.e")->HasKey("x"));
+}
+
 TEST(ConfigurationSpec, MalformedJson_Throws)
 {
     EXPECT_THROW(
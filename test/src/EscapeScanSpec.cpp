@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+// Internal headers: the escaping helpers are not part of the public API.
+#include "../../src/Common/EscapeScan.hpp"
+#include "../../src/Configuration/Detail.hpp"
+#include "../../src/Logging/LogSinks/Detail.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    // Byte-at-a-time implementations the vectorized versions replaced.
+    std::string ReferenceSanitize(std::string_view s, bool preserveTabs)
+    {
+        std::string out;
+        for (char c : s)
+        {
+            switch (c)
+            {
+                case '\r':
+                    out.append("\\r");
+                    break;
+                case '\n':
+                    out.append("\\n");
+                    break;
+                case '\t':
+                    if (preserveTabs)
+                        out.push_back('\t');
+                    else
+                        out.append("\\t");
+                    break;
+                case '\0':
+                    out.append("\\0");
+                    break;
+                case '\b':
+                    out.append("\\b");
+                    break;
+                case '\f':
+                    out.append("\\f");
+                    break;
+                case '\v':
+                    out.append("\\v");
+                    break;
+                case '\x1b':
+                    out.append("\\x1b");
+                    break;
+                default:
+                {
+                    const auto u = static_cast<unsigned char>(c);
+                    if (u < 0x20 || u == 0x7f)
+                    {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\x%02x", u);
+                        out.append(buf);
+                    }
+                    else
+                    {
+                        out.push_back(c);
+                    }
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    std::string ReferenceJsonString(std::string_view s)
+    {
+        std::string out = "\"";
+        for (char c : s)
+        {
+            switch (c)
+            {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\b':
+                    out += "\\b";
+                    break;
+                case '\f':
+                    out += "\\f";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x",
+                                      static_cast<unsigned char>(c));
+                        out += buf;
+                    }
+                    else
+                    {
+                        out.push_back(c);
+                    }
+                    break;
+            }
+        }
+        out.push_back('"');
+        return out;
+    }
+
+    // Mostly printable text with occasional arbitrary bytes, at lengths
+    // that straddle the 16- and 32-byte vector widths.
+    std::string RandomText(std::mt19937& rng)
+    {
+        std::string s(rng() % 130, 'x');
+        for (auto& c : s)
+        {
+            const unsigned roll = rng() % 100;
+            if (roll < 85)
+                c = static_cast<char>(' ' + rng() % 95);
+            else
+                c = static_cast<char>(rng() % 256);
+        }
+        return s;
+    }
+} // namespace
+
+TEST(EscapeScanSpec, FindFirstEscape_MatchesScalarScan)
+{
+    using skr::detail::EscapeSet;
+    std::mt19937 rng(1234);
+
+    for (int i = 0; i < 20'000; ++i)
+    {
+        const std::string s = RandomText(rng);
+        EXPECT_EQ(skr::detail::FindFirstEscape<EscapeSet::LogText>(s.data(),
+                                                                   s.size()),
+                  skr::detail::FindFirstEscapeScalar<EscapeSet::LogText>(
+                      s.data(), s.size()));
+        EXPECT_EQ(
+            skr::detail::FindFirstEscape<EscapeSet::LogTextKeepTabs>(
+                s.data(), s.size()),
+            skr::detail::FindFirstEscapeScalar<EscapeSet::LogTextKeepTabs>(
+                s.data(), s.size()));
+        EXPECT_EQ(skr::detail::FindFirstEscape<EscapeSet::Json>(s.data(),
+                                                                s.size()),
+                  skr::detail::FindFirstEscapeScalar<EscapeSet::Json>(
+                      s.data(), s.size()));
+    }
+}
+
+// FindFirstEscape only takes one of the vector paths on a given machine;
+// call every path compiled in (and supported by this CPU) directly.
+TEST(EscapeScanSpec, EveryVectorPath_MatchesScalarScan)
+{
+    using skr::detail::EscapeSet;
+    std::mt19937 rng(4321);
+
+    const auto check = [](const std::string& s, auto scan) {
+        EXPECT_EQ(scan.template operator()<EscapeSet::LogText>(s),
+                  skr::detail::FindFirstEscapeScalar<EscapeSet::LogText>(
+                      s.data(), s.size()));
+        EXPECT_EQ(
+            scan.template operator()<EscapeSet::LogTextKeepTabs>(s),
+            skr::detail::FindFirstEscapeScalar<EscapeSet::LogTextKeepTabs>(
+                s.data(), s.size()));
+        EXPECT_EQ(scan.template operator()<EscapeSet::Json>(s),
+                  skr::detail::FindFirstEscapeScalar<EscapeSet::Json>(
+                      s.data(), s.size()));
+    };
+
+    for (int i = 0; i < 5'000; ++i)
+    {
+        const std::string s = RandomText(rng);
+#if defined(SKIRNIR_ESCAPE_SCAN_SSE2)
+        check(s, []<EscapeSet Set>(const std::string& t) {
+            return skr::detail::FindFirstEscapeSse2<Set>(t.data(), t.size());
+        });
+#endif
+#if defined(SKIRNIR_ESCAPE_SCAN_AVX2)
+#  if defined(SKIRNIR_ESCAPE_SCAN_AVX2_DISPATCH)
+        if (skr::detail::CpuHasAvx2())
+#  endif
+            check(s, []<EscapeSet Set>(const std::string& t) {
+                return skr::detail::FindFirstEscapeAvx2<Set>(t.data(),
+                                                             t.size());
+            });
+#endif
+#if defined(SKIRNIR_ESCAPE_SCAN_NEON)
+        check(s, []<EscapeSet Set>(const std::string& t) {
+            return skr::detail::FindFirstEscapeNeon<Set>(t.data(), t.size());
+        });
+#endif
+        check(s, []<EscapeSet Set>(const std::string& t) {
+            return skr::detail::FindFirstEscape<Set>(t.data(), t.size());
+        });
+    }
+}
+
+TEST(EscapeScanSpec, SanitizeForLog_MatchesReference)
+{
+    std::mt19937 rng(99);
+
+    for (int i = 0; i < 20'000; ++i)
+    {
+        const std::string s = RandomText(rng);
+        EXPECT_EQ(skr::detail::SanitizeForLog(s, false),
+                  ReferenceSanitize(s, false));
+        EXPECT_EQ(skr::detail::SanitizeForLog(s, true),
+                  ReferenceSanitize(s, true));
+    }
+
+    // Every single byte value, alone and inside a clean run.
+    for (int b = 0; b < 256; ++b)
+    {
+        const std::string one(1, static_cast<char>(b));
+        const std::string padded =
+            std::string(37, 'a') + one + std::string(20, 'b');
+        EXPECT_EQ(skr::detail::SanitizeForLog(one),
+                  ReferenceSanitize(one, false));
+        EXPECT_EQ(skr::detail::SanitizeForLog(padded, true),
+                  ReferenceSanitize(padded, true));
+    }
+}
+
+TEST(EscapeScanSpec, JsonAppendString_MatchesReference)
+{
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 20'000; ++i)
+    {
+        const std::string s = RandomText(rng);
+        std::string       out;
+        skr::detail::AppendString(out, s);
+        EXPECT_EQ(out, ReferenceJsonString(s));
+    }
+}
+
+TEST(EscapeScanSpec, CleanInput_IsCopiedVerbatim)
+{
+    const std::string clean(1000, 'q');
+    EXPECT_EQ(skr::detail::SanitizeForLog(clean), clean);
+
+    std::string out;
+    skr::detail::AppendString(out, clean);
+    EXPECT_EQ(out.size(), clean.size() + 2);
+}
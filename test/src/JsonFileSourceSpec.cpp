@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <Skirnir/Skirnir.hpp>
+
+#include "TestPaths.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace json_file_test
+{
+    using skirnir_test::TempFile;
+
+    skr::JsonFileSourceOptions Mapped()
+    {
+        skr::JsonFileSourceOptions options;
+        options.memoryMap = true;
+        return options;
+    }
+
+    // {"v": value} padded with trailing spaces to exactly @p size bytes.
+    std::string Document(int value, std::size_t size)
+    {
+        std::string json = "{\"v\": " + std::to_string(value) + "}";
+        json.resize(size, ' ');
+        return json;
+    }
+
+    constexpr const char* kSample = R"({
+        "server": {"host": "example.org", "port": 8080, "tls": true},
+        "logging": {"level": "Debug", "sinks": ["console", "file"]},
+        "limits": {"ratio": 0.5, "big": 18446744073709551615},
+        "name": "café \"quoted\""
+    })";
+} // namespace json_file_test
+
+TEST(JsonFileSourceSpec, MemoryMap_MatchesRead)
+{
+    using namespace json_file_test;
+    TempFile file(kSample);
+
+    auto read   = skr::ConfigurationBuilder().AddJsonFile(file.Path()).Build();
+    auto mapped = skr::ConfigurationBuilder()
+                      .AddJsonFile(file.Path(), Mapped())
+                      .Build();
+
+    for (const char* key : {"server.host", "server.port", "server.tls",
+                            "logging.level", "limits.ratio", "limits.big",
+                            "name"})
+    {
+        EXPECT_EQ(mapped->GetValue(key), read->GetValue(key)) << key;
+    }
+    EXPECT_EQ(mapped->GetArray("logging.sinks"),
+              (std::vector<std::string> {"console", "file"}));
+}
+
+TEST(JsonFileSourceSpec, MemoryMap_FilesEndingNearAPageBoundary)
+{
+    using namespace json_file_test;
+    // Files ending within SIMDJSON_PADDING bytes of a page boundary take
+    // the anonymous-tail path; the others are padded by their last page.
+    constexpr std::size_t padding = simdjson::SIMDJSON_PADDING;
+    for (std::size_t page : {std::size_t {4096}, std::size_t {16384}})
+    {
+        for (std::size_t size = page - padding - 8; size <= page + 8; ++size)
+        {
+            TempFile file(Document(static_cast<int>(size), size));
+            auto     config = skr::ConfigurationBuilder()
+                              .AddJsonFile(file.Path(), Mapped())
+                              .Build();
+            ASSERT_EQ(config->GetInt("v"), static_cast<int64_t>(size));
+        }
+    }
+}
+
+TEST(JsonFileSourceSpec, MemoryMap_EnforcesMaxSize)
+{
+    using namespace json_file_test;
+    TempFile file(Document(1, 1024));
+
+    auto options    = Mapped();
+    options.maxSize = 1023;
+    EXPECT_THROW(skr::JsonFileSource(file.Path(), options).Load(),
+                 std::runtime_error);
+
+    options.maxSize = 1024;
+    EXPECT_NO_THROW(skr::JsonFileSource(file.Path(), options).Load());
+}
+
+TEST(JsonFileSourceSpec, MemoryMap_RejectsMissingEmptyAndInvalidFiles)
+{
+    using namespace json_file_test;
+    EXPECT_THROW(skr::JsonFileSource("/nonexistent/skirnir.json", Mapped())
+                     .Load(),
+                 std::runtime_error);
+
+    TempFile empty("");
+    EXPECT_THROW(skr::JsonFileSource(empty.Path(), Mapped()).Load(),
+                 std::runtime_error);
+
+    TempFile invalid(R"({"a": )");
+    EXPECT_THROW(skr::JsonFileSource(invalid.Path(), Mapped()).Load(),
+                 std::runtime_error);
+}
+
+TEST(JsonFileSourceSpec, Reload_OnlyWhenContentChanges)
+{
+    using namespace json_file_test;
+    for (bool memoryMap : {false, true})
+    {
+        TempFile                   file(R"({"a": 1})");
+        skr::JsonFileSourceOptions options;
+        options.memoryMap = memoryMap;
+        skr::JsonFileSource source(file.Path(), options);
+
+        EXPECT_EQ(source.Load()["a"].get_int64().value(), 1);
+        EXPECT_FALSE(source.Reload());
+        file.Write(R"({"a": 2})");
+        EXPECT_TRUE(source.Reload());
+        EXPECT_EQ(source.Load()["a"].get_int64().value(), 2);
+    }
+}
+
+TEST(JsonFileSourceSpec, Keys_MaterializeOnlySelectedValues)
+{
+    using namespace json_file_test;
+    TempFile file(kSample);
+
+    for (bool memoryMap : {false, true})
+    {
+        skr::JsonFileSourceOptions options;
+        options.memoryMap = memoryMap;
+        options.keys      = {"server.port", "logging", "missing.key",
+                             "server.host.nested", "name"};
+        auto config       = skr::ConfigurationBuilder()
+                          .AddJsonFile(file.Path(), options)
+                          .Build();
+
+        EXPECT_EQ(config->GetInt("server.port"), 8080);
+        EXPECT_EQ(config->GetString("logging.level"), "Debug");
+        EXPECT_EQ(config->GetArray("logging.sinks"),
+                  (std::vector<std::string> {"console", "file"}));
+        EXPECT_EQ(config->GetString("name"), "café \"quoted\"");
+        EXPECT_FALSE(config->HasKey("server.host"));
+        EXPECT_FALSE(config->HasKey("limits"));
+        EXPECT_FALSE(config->HasKey("missing"));
+    }
+}
+
+TEST(JsonFileSourceSpec, Keys_MergeWithLaterSources)
+{
+    using namespace json_file_test;
+    TempFile file(kSample);
+
+    skr::JsonFileSourceOptions options;
+    options.keys = {"server"};
+    auto config  = skr::ConfigurationBuilder()
+                      .AddJsonFile(file.Path(), options)
+                      .AddJsonString(R"({"server": {"port": 9090}})")
+                      .Build();
+
+    EXPECT_EQ(config->GetString("server.host"), "example.org");
+    EXPECT_EQ(config->GetInt("server.port"), 9090);
+}
+
+TEST(JsonFileSourceSpec, Keys_ReportMalformedSelectedValues)
+{
+    using namespace json_file_test;
+    TempFile file(R"({"a": {"b": tru}, "c": 1})");
+
+    skr::JsonFileSourceOptions options;
+    options.keys = {"a.b"};
+    EXPECT_THROW(skr::JsonFileSource(file.Path(), options).Load(),
+                 std::runtime_error);
+}
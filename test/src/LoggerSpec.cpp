@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <Skirnir/Configuration.hpp>
-#include <Skirnir/Logging/Logger.hpp>
+#include <Skirnir/Logging.hpp>
+
+#include <chrono>
+#include <optional>
 
 class Unknown
 {
@@ -79,4 +82,199 @@ TEST(LoggerSpec, LoggerOptions_NamespaceHierarchy)
     // MyApp.Services.Database should match MyApp.Services (partial match)
     EXPECT_EQ(options->GetLogLevelFor<my_app::services::DataBase>(),
               skr::LogLevel::Debug);
-}
\ No newline at end of file
+}
+namespace log_floor_test
+{
+    class Chatty
+    {
+    };
+
+    namespace quiet::inner
+    {
+        class Worker
+        {
+        };
+    } // namespace quiet::inner
+
+    class CountingSink final : public skr::ILogSink
+    {
+      public:
+        void Write(const skr::LogRecord&) override
+        {
+            ++count;
+        }
+
+        int count = 0;
+    };
+} // namespace log_floor_test
+
+template <>
+inline constexpr std::optional<skr::LogLevel>
+    skr::CompiledCategoryLogLevel<log_floor_test::Chatty> =
+        skr::LogLevel::Warning;
+
+template <>
+inline constexpr std::optional<skr::LogLevel>
+    skr::CompiledNamespaceLogLevel<^^log_floor_test::quiet> =
+        skr::LogLevel::Error;
+
+TEST(LoggerSpec, CompiledLevel_CategoryAndNamespaceFloors)
+{
+    using skr::LogLevel;
+
+    static_assert(skr::Logger<log_floor_test::Chatty>::CompiledLevel ==
+                  LogLevel::Warning);
+    static_assert(
+        !skr::Logger<log_floor_test::Chatty>::IsCompiledIn(LogLevel::Debug));
+    static_assert(
+        skr::Logger<log_floor_test::Chatty>::IsCompiledIn(LogLevel::Warning));
+
+    // Innermost specialized namespace applies to nested namespaces too.
+    static_assert(
+        skr::Logger<log_floor_test::quiet::inner::Worker>::CompiledLevel ==
+        LogLevel::Error);
+
+    // Fatal is never elided; it has to keep throwing.
+    static_assert(
+        skr::Logger<log_floor_test::quiet::inner::Worker>::IsCompiledIn(
+            LogLevel::Fatal));
+
+    // Unspecialized categories keep the global floor.
+    static_assert(skr::Logger<Unknown>::CompiledLevel ==
+                  skr::CompiledMinLogLevel);
+}
+
+TEST(LoggerSpec, LogMacros_SkipArgumentEvaluationWhenDisabled)
+{
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ClearSinks();
+    auto sink = skr::MakeArc<log_floor_test::CountingSink>();
+    options->AddSink(sink);
+    options->logLevel = skr::LogLevel::Error;
+
+    auto logger = skr::MakeArc<skr::Logger<log_floor_test::Chatty>>(options);
+
+    int evaluated = 0;
+
+    // Below the compile-time floor: compiled out entirely.
+    SKIRNIR_LOG_DEBUG(logger, "{}", ++evaluated);
+    logger->LogDebug("{}", 1);
+    // Above the floor but below the runtime level.
+    SKIRNIR_LOG_WARNING(logger, "{}", ++evaluated);
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_EQ(sink->count, 0);
+    EXPECT_FALSE(logger->IsEnabled(skr::LogLevel::Warning));
+
+    SKIRNIR_LOG_ERROR(logger, "{}", ++evaluated);
+    EXPECT_EQ(evaluated, 1);
+    EXPECT_EQ(sink->count, 1);
+    EXPECT_TRUE(logger->IsEnabled(skr::LogLevel::Error));
+}
+
+namespace log_reload_test
+{
+    namespace services::db
+    {
+        class Connection
+        {
+        };
+    } // namespace services::db
+} // namespace log_reload_test
+
+TEST(LoggerSpec, LiveLogger_SeesReconfiguredLevel)
+{
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ClearSinks();
+    auto sink = skr::MakeArc<log_floor_test::CountingSink>();
+    options->AddSink(sink);
+    options->logLevel = skr::LogLevel::Error;
+
+    skr::Logger<log_reload_test::services::db::Connection> logger(options);
+    EXPECT_FALSE(logger.IsEnabled(skr::LogLevel::Warning));
+
+    // Enclosing-namespace override, picked up without a new logger.
+    options->ConfigureFrom(skr::ConfigurationBuilder()
+                               .AddJsonString(R"({
+                                   "logging": {
+                                       "logLevel": {
+                                           "default": "Error",
+                                           "log_reload_test::services": "Warning"
+                                       }
+                                   }
+                               })")
+                               .Build());
+    EXPECT_TRUE(logger.IsEnabled(skr::LogLevel::Warning));
+    logger.LogWarning("visible");
+    EXPECT_EQ(sink->count, 1);
+
+    // A reload without the override falls back to the default.
+    options->ConfigureFrom(skr::ConfigurationBuilder()
+                               .AddJsonString(R"({
+                                   "logging": {
+                                       "logLevel": { "default": "Fatal" }
+                                   }
+                               })")
+                               .Build());
+    EXPECT_FALSE(logger.IsEnabled(skr::LogLevel::Error));
+
+    options->SetLogLevel("log_reload_test::services::db::Connection",
+                         skr::LogLevel::Information);
+    EXPECT_TRUE(logger.IsEnabled(skr::LogLevel::Information));
+
+    options->SetLogLevel(skr::LogLevel::None);
+    EXPECT_TRUE(logger.IsEnabled(skr::LogLevel::Information))
+        << "A type-specific override outranks the default";
+}
+
+TEST(LoggerSpec, LoggerOptions_ConfigureFrom_ReadsRateLimitAndAsync)
+{
+    // As documented: siblings of "logLevel" under "logging".
+    auto config = skr::ConfigurationBuilder()
+                      .AddJsonString(R"({
+                          "logging": {
+                              "logLevel": { "default": "Information" },
+                              "async": {
+                                  "enabled": false,
+                                  "queueCapacity": 256
+                              },
+                              "rateLimit": {
+                                  "mode": "tokenBucket",
+                                  "burst": 20,
+                                  "perSecond": 5,
+                                  "sampleEvery": 100,
+                                  "maxLevel": "Warning",
+                                  "summaryIntervalMs": 10000
+                              }
+                          }
+                      })")
+                      .Build();
+
+    auto options = skr::MakeArc<skr::LoggerOptions>();
+    options->ConfigureFrom(config);
+
+    const skr::LogRateLimit limit = options->RateLimit();
+    EXPECT_EQ(limit.mode, skr::LogRateLimitMode::TokenBucket);
+    EXPECT_EQ(limit.burst, 20u);
+    EXPECT_DOUBLE_EQ(limit.perSecond, 5.0);
+    EXPECT_EQ(limit.sampleEvery, 100u);
+    EXPECT_EQ(limit.maxLevel, skr::LogLevel::Warning);
+    EXPECT_EQ(limit.summaryInterval, std::chrono::milliseconds(10'000));
+    EXPECT_TRUE(options->RateLimitEnabled());
+
+    EXPECT_FALSE(options->asyncEnabled);
+    EXPECT_EQ(options->asyncQueueCapacity, 256u);
+
+    // Sections under "logLevel" are not the logging options.
+    auto nested = skr::MakeArc<skr::LoggerOptions>();
+    nested->ConfigureFrom(skr::ConfigurationBuilder()
+                              .AddJsonString(R"({
+                                  "logging": {
+                                      "logLevel": {
+                                          "default": "Information",
+                                          "rateLimit": { "mode": "sample" }
+                                      }
+                                  }
+                              })")
+                              .Build());
+    EXPECT_EQ(nested->RateLimit().mode, skr::LogRateLimitMode::Off);
+}
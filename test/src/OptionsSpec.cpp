@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <Skirnir/Skirnir.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace options_test
+{
+    struct ServerOptions
+    {
+        std::string host;
+        int         port = 0;
+    };
+
+    skr::Arc<skr::ConfigurationOptions> Config(int port)
+    {
+        return skr::ConfigurationBuilder()
+            .AddJsonString(R"({"server": {"host": "example.org", "port": )" +
+                           std::to_string(port) + "}}")
+            .Build();
+    }
+} // namespace options_test
+
+TEST(OptionsSpec, BindsSectionOnce)
+{
+    using namespace options_test;
+    skr::Options<ServerOptions> options(*Config(8080), "server");
+
+    auto first  = options.Value();
+    auto second = options.Value();
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(first->host, "example.org");
+    EXPECT_EQ(first->port, 8080);
+    EXPECT_EQ(options.Section(), "server");
+}
+
+TEST(OptionsSpec, ReloadPublishesNewSnapshotAndKeepsOldOne)
+{
+    using namespace options_test;
+    skr::Options<ServerOptions> options(*Config(8080), "server");
+
+    auto before = options.Value();
+    options.Reload(*Config(9090));
+    auto after = options.Value();
+
+    EXPECT_NE(before.get(), after.get());
+    EXPECT_EQ(before->port, 8080);
+    EXPECT_EQ(after->port, 9090);
+}
+
+TEST(OptionsSpec, SubscribersSeeEachPublishedSnapshot)
+{
+    using namespace options_test;
+    skr::Options<ServerOptions> options(*Config(1), "server");
+
+    std::vector<int> seen;
+    const auto       token = options.Subscribe(
+        [&](const skr::Arc<const ServerOptions>& o) { seen.push_back(o->port); });
+
+    options.Reload(*Config(2));
+    options.Reload(*Config(3));
+    options.Unsubscribe(token);
+    options.Reload(*Config(4));
+
+    EXPECT_EQ(seen, (std::vector<int> {2, 3}));
+    EXPECT_EQ(options.Value()->port, 4);
+}
+
+TEST(OptionsSpec, ListenerMayReadBackTheSnapshot)
+{
+    using namespace options_test;
+    skr::Options<ServerOptions> options(*Config(1), "server");
+
+    int observed = 0;
+    options.Subscribe([&](const skr::Arc<const ServerOptions>&) {
+        observed = options.Value()->port;
+    });
+    options.Reload(*Config(5));
+
+    EXPECT_EQ(observed, 5);
+}
+
+TEST(OptionsSpec, ReadersNeverSeeATornSnapshot)
+{
+    using namespace options_test;
+    skr::Options<ServerOptions> options(*Config(0), "server");
+
+    std::atomic<bool>        done {false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_relaxed))
+            {
+                auto snapshot = options.Value();
+                ASSERT_TRUE(snapshot);
+                EXPECT_EQ(snapshot->host, "example.org");
+            }
+        });
+    }
+    for (int port = 1; port <= 200; ++port)
+        options.Reload(*Config(port));
+    done.store(true);
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(options.Value()->port, 200);
+    EXPECT_EQ(options.Value().use_count(), 2u);
+}
+
+TEST(OptionsSpec, ResolvedAsSingletonThroughServiceCollection)
+{
+    using namespace options_test;
+    skr::ServiceCollection services;
+    services.AddSingleton(Config(7000));
+    services.AddOptions<ServerOptions>("server");
+    auto provider = services.CreateServiceProvider();
+
+    auto a = provider->GetService<skr::Options<ServerOptions>>();
+    auto b = provider->GetService<skr::Options<ServerOptions>>();
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_EQ(a->Value()->port, 7000);
+}
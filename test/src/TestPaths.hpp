@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace skirnir_test
+{
+    /**
+     * @brief Returns a path under the working directory that no other test
+     * in this run uses: @p prefix, a per-process counter, a timestamp and
+     * @p suffix.
+     */
+    inline std::filesystem::path UniqueTestPath(std::string_view prefix,
+                                                std::string_view suffix = {})
+    {
+        static std::atomic<int> counter {0};
+        return std::filesystem::current_path() /
+               (std::string(prefix) + std::to_string(counter.fetch_add(1)) +
+                "_" +
+                std::to_string(static_cast<long long>(
+                    std::chrono::system_clock::now()
+                        .time_since_epoch()
+                        .count())) +
+                std::string(suffix));
+    }
+
+    /**
+     * @brief A scratch directory from UniqueTestPath(), removed with
+     * everything in it on destruction.
+     */
+    class TempDir
+    {
+      public:
+        TempDir() : mDir(UniqueTestPath("skirnir_test_"))
+        {
+            std::filesystem::create_directories(mDir);
+        }
+
+        TempDir(const TempDir&)            = delete;
+        TempDir& operator=(const TempDir&) = delete;
+
+        ~TempDir()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(mDir, ec);
+        }
+
+        std::filesystem::path Path(std::string_view name) const
+        {
+            return mDir / name;
+        }
+
+        /** @brief Overwrites @p name in place and returns its path. */
+        std::filesystem::path Write(std::string_view   name,
+                                    const std::string& content) const
+        {
+            const auto    path = Path(name);
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << content;
+            return path;
+        }
+
+        /**
+         * @brief Writes a sibling file and renames it over @p name, the way
+         * editors and deployment tools replace configuration.
+         */
+        std::filesystem::path Replace(std::string_view   name,
+                                      const std::string& content) const
+        {
+            const auto path = Path(name);
+            auto       tmp  = path;
+            tmp += ".tmp";
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                out << content;
+            }
+            std::filesystem::rename(tmp, path);
+            return path;
+        }
+
+        std::string Read(std::string_view name) const
+        {
+            std::ifstream in(Path(name), std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), {});
+        }
+
+      private:
+        std::filesystem::path mDir;
+    };
+
+    /** @brief A single file named @p name inside its own TempDir. */
+    class TempFile
+    {
+      public:
+        explicit TempFile(const std::string& content,
+                          std::string_view   name = "appsettings.json")
+            : mName(name)
+        {
+            mDir.Write(mName, content);
+        }
+
+        std::filesystem::path Path() const { return mDir.Path(mName); }
+
+        void Write(const std::string& content) const
+        {
+            mDir.Write(mName, content);
+        }
+
+        void Replace(const std::string& content) const
+        {
+            mDir.Replace(mName, content);
+        }
+
+      private:
+        TempDir     mDir;
+        std::string mName;
+    };
+} // namespace skirnir_test
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <Skirnir/Logging.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace
+{
+    using Clock = std::chrono::system_clock;
+
+    Clock::time_point FromNanoseconds(std::int64_t ns)
+    {
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds(ns)));
+    }
+} // namespace
+
+TEST(TimestampFormatSpec, Default_MatchesChronoFormat)
+{
+    skr::TimestampFormatter formatter;
+    std::mt19937_64         rng(42);
+
+    // Random instants between 1900 and 2100, plus runs of consecutive
+    // timestamps to exercise the cached-second path.
+    constexpr std::int64_t kMin = -2'208'988'800LL * 1'000'000'000LL;
+    constexpr std::int64_t kMax = 4'102'444'800LL * 1'000'000'000LL;
+    std::uniform_int_distribution<std::int64_t> dist(kMin, kMax);
+
+    for (int i = 0; i < 2'000; ++i)
+    {
+        const auto base = FromNanoseconds(dist(rng));
+        for (int step = 0; step < 5; ++step)
+        {
+            const auto tp = base + std::chrono::milliseconds(step * 400);
+            EXPECT_EQ(formatter.Format(tp),
+                      skr::detail::Format("{:%F %T}", tp));
+        }
+    }
+}
+
+TEST(TimestampFormatSpec, CrossesDayBoundary)
+{
+    skr::TimestampFormatter formatter({skr::TimestampStyle::Default, 0});
+
+    // 2024-02-28 23:59:59 UTC, a leap year.
+    const auto tp = Clock::time_point(std::chrono::seconds(1'709'164'799));
+    EXPECT_EQ(formatter.Format(tp), "2024-02-28 23:59:59");
+    EXPECT_EQ(formatter.Format(tp + std::chrono::seconds(1)),
+              "2024-02-29 00:00:00");
+    EXPECT_EQ(formatter.Format(tp + std::chrono::days(1) +
+                               std::chrono::seconds(1)),
+              "2024-03-01 00:00:00");
+}
+
+TEST(TimestampFormatSpec, Iso8601AndEpochStyles)
+{
+    const auto tp = FromNanoseconds(1'741'816'519'650'921'540LL);
+
+    skr::TimestampFormatter iso({skr::TimestampStyle::Iso8601, 3});
+    EXPECT_EQ(iso.Format(tp), "2025-03-12T21:55:19.650Z");
+
+    skr::TimestampFormatter isoSeconds({skr::TimestampStyle::Iso8601, 0});
+    EXPECT_EQ(isoSeconds.Format(tp), "2025-03-12T21:55:19Z");
+
+    skr::TimestampFormatter epoch({skr::TimestampStyle::Epoch, 6});
+    EXPECT_EQ(epoch.Format(tp), "1741816519.650921");
+
+    skr::TimestampFormatter epochSeconds({skr::TimestampStyle::Epoch, 0});
+    EXPECT_EQ(epochSeconds.Format(tp), "1741816519");
+}